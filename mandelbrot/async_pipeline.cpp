@@ -0,0 +1,836 @@
+// async_pipeline.cpp - Pipeline render Mandelbrot asinkron berbasis coroutine C++20
+//
+// Gambar besar dipecah menjadi ribuan tile; setiap tile adalah satu coroutine
+// yang melewati tahap render -> pewarnaan/encode BMP -> tulis file. Tahap
+// komputasi berjalan di pool thread, tahap I/O di-submit ke io_uring (Linux)
+// atau ke satu thread penulis (fallback), sehingga banyak tile berada dalam
+// proses sekaligus dan disk tidak pernah menahan core.
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <chrono>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include <string>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#endif
+#include "render.h"
+
+static double now_seconds() {
+    using namespace std::chrono;
+    return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+// FNV-1a untuk memverifikasi semua mode menulis byte yang sama
+static uint64_t fnv1a(const uint8_t* data, size_t len) {
+    uint64_t h = 1469598103934665603ULL;
+    for (size_t i = 0; i < len; i++) {
+        h ^= data[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+// === Konfigurasi pipeline ===
+struct PipelineConfig {
+    int tiles_x, tiles_y;     // grid tile
+    int tile_size;            // sisi tile dalam pixel
+    int max_iterations;
+    int slots;                // jumlah tile yang boleh berada dalam proses sekaligus
+    bool dsync;               // O_DSYNC: tulisan baru selesai setelah sampai ke disk
+    std::string dir;          // direktori output tile
+    double min_real, max_real, min_imag, max_imag;
+};
+
+// Buffer milik satu tile yang sedang diproses
+struct TileBuffer {
+    std::vector<int> iterations;
+    std::vector<RGB> image;
+    std::vector<uint8_t> encoded;
+    char path[256];
+};
+
+static void render_tile(const PipelineConfig& cfg, int tx, int ty, int* iterations) {
+    int width = cfg.tiles_x * cfg.tile_size;
+    int height = cfg.tiles_y * cfg.tile_size;
+    for (int y = 0; y < cfg.tile_size; y++) {
+        int py = ty * cfg.tile_size + y;
+        double imag = cfg.min_imag + (double)py / height * (cfg.max_imag - cfg.min_imag);
+        for (int x = 0; x < cfg.tile_size; x++) {
+            int px = tx * cfg.tile_size + x;
+            double real = cfg.min_real + (double)px / width * (cfg.max_real - cfg.min_real);
+            iterations[y * cfg.tile_size + x] = mandelbrot_iterations(real, imag, cfg.max_iterations);
+        }
+    }
+}
+
+static size_t colorize_tile(const PipelineConfig& cfg, TileBuffer& buf) {
+    size_t count = (size_t)cfg.tile_size * cfg.tile_size;
+    for (size_t i = 0; i < count; i++) {
+        buf.image[i] = get_color(buf.iterations[i], cfg.max_iterations);
+    }
+    return encode_bmp(buf.encoded.data(), buf.image.data(), cfg.tile_size, cfg.tile_size);
+}
+
+static void tile_path(const PipelineConfig& cfg, int tx, int ty, char* out, size_t size) {
+    snprintf(out, size, "%s/tile_%03d_%03d.bmp", cfg.dir.c_str(), ty, tx);
+}
+
+static int open_flags(const PipelineConfig& cfg) {
+    return O_WRONLY | O_CREAT | O_TRUNC | (cfg.dsync ? O_DSYNC : 0);
+}
+
+// === Coroutine: task detached dan pool thread ===
+
+// Coroutine tile dijalankan sampai selesai tanpa ada yang menunggu handle-nya;
+// penyelesaian dilaporkan lewat penghitung di Pipeline.
+struct DetachedTask {
+    struct promise_type {
+        DetachedTask get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+class ThreadPool {
+public:
+    explicit ThreadPool(int threads) {
+        for (int i = 0; i < threads; i++) {
+            workers_.emplace_back([this] { worker_loop(); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        for (auto& t : workers_) t.join();
+    }
+
+    void post(std::coroutine_handle<> handle) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue_.push_back(handle);
+        }
+        cv_.notify_one();
+    }
+
+    int size() const { return (int)workers_.size(); }
+
+    // Waktu sibuk (detik) yang dicatat tahap komputasi di semua worker
+    double busy_seconds() const { return busy_ns_.load() * 1e-9; }
+    void add_busy(double seconds) { busy_ns_ += (long long)(seconds * 1e9); }
+
+private:
+    void worker_loop() {
+        for (;;) {
+            std::coroutine_handle<> handle;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+                if (queue_.empty()) return;
+                handle = queue_.front();
+                queue_.pop_front();
+            }
+            handle.resume();
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::coroutine_handle<>> queue_;
+    std::vector<std::thread> workers_;
+    std::atomic<long long> busy_ns_{0};
+    bool stopping_ = false;
+};
+
+// Tahap komputasi: coroutine pindah ke worker pool, lalu fn dijalankan di sana.
+// Setiap tahap kembali ke antrian, sehingga tile yang I/O-nya baru selesai
+// mendapat giliran di antara tahap render tile lain.
+template <typename Fn>
+struct ComputeStage {
+    ThreadPool& pool;
+    Fn fn;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle) { pool.post(handle); }
+    auto await_resume() {
+        double start = now_seconds();
+        if constexpr (std::is_void_v<decltype(fn())>) {
+            fn();
+            pool.add_busy(now_seconds() - start);
+        } else {
+            auto result = fn();
+            pool.add_busy(now_seconds() - start);
+            return result;
+        }
+    }
+};
+
+template <typename Fn>
+ComputeStage<Fn> run_on(ThreadPool& pool, Fn fn) {
+    return ComputeStage<Fn>{pool, std::move(fn)};
+}
+
+// Pool buffer tile: membatasi jumlah tile dalam proses. Coroutine yang tidak
+// kebagian buffer ditangguhkan dan dibangunkan saat buffer dikembalikan.
+class BufferPool {
+public:
+    BufferPool(ThreadPool& pool, int slots, int tile_size) : pool_(pool), buffers_(slots) {
+        size_t count = (size_t)tile_size * tile_size;
+        for (auto& buf : buffers_) {
+            buf.iterations.resize(count);
+            buf.image.resize(count);
+            buf.encoded.resize(bmp_file_size(tile_size, tile_size));
+            free_.push_back(&buf);
+        }
+    }
+
+    struct Acquire {
+        BufferPool& owner;
+        std::coroutine_handle<> handle;
+        TileBuffer* buffer = nullptr;
+
+        bool await_ready() {
+            std::lock_guard<std::mutex> lock(owner.mutex_);
+            if (owner.free_.empty()) return false;
+            buffer = owner.free_.back();
+            owner.free_.pop_back();
+            return true;
+        }
+        bool await_suspend(std::coroutine_handle<> h) {
+            std::lock_guard<std::mutex> lock(owner.mutex_);
+            // Buffer mungkin dikembalikan di antara await_ready dan kunci ini
+            if (!owner.free_.empty()) {
+                buffer = owner.free_.back();
+                owner.free_.pop_back();
+                return false;
+            }
+            handle = h;
+            owner.waiters_.push_back(this);
+            return true;
+        }
+        TileBuffer* await_resume() { return buffer; }
+    };
+
+    Acquire acquire() { return Acquire{*this, {}}; }
+
+    void release(TileBuffer* buffer) {
+        Acquire* waiter = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (waiters_.empty()) {
+                free_.push_back(buffer);
+                return;
+            }
+            waiter = waiters_.front();
+            waiters_.pop_front();
+        }
+        // Serahkan buffer langsung ke coroutine yang menunggu
+        waiter->buffer = buffer;
+        pool_.post(waiter->handle);
+    }
+
+private:
+    ThreadPool& pool_;
+    std::vector<TileBuffer> buffers_;
+    std::vector<TileBuffer*> free_;
+    std::deque<Acquire*> waiters_;
+    std::mutex mutex_;
+};
+
+// === Backend I/O ===
+enum IoType { IO_OPEN, IO_WRITE, IO_CLOSE };
+
+struct IoOp {
+    IoType type;
+    const char* path;
+    int flags;
+    int fd;
+    const void* buf;
+    size_t len;
+    uint64_t offset;
+    long result;                  // hasil syscall, atau -errno
+    std::coroutine_handle<> handle;
+};
+
+class IoBackend {
+public:
+    virtual ~IoBackend() {}
+    virtual const char* name() const = 0;
+    // Submit op; penyelesaian melanjutkan op->handle di pool thread
+    virtual void submit(IoOp* op) = 0;
+};
+
+// Awaitable tahap I/O
+struct IoAwait {
+    IoBackend& backend;
+    IoOp op;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle) {
+        op.handle = handle;
+        backend.submit(&op);
+    }
+    long await_resume() const { return op.result; }
+};
+
+static IoAwait async_open(IoBackend& io, const char* path, int flags) {
+    return IoAwait{io, IoOp{IO_OPEN, path, flags, -1, nullptr, 0, 0, 0, {}}};
+}
+
+static IoAwait async_write(IoBackend& io, int fd, const void* buf, size_t len, uint64_t offset) {
+    return IoAwait{io, IoOp{IO_WRITE, nullptr, 0, fd, buf, len, offset, 0, {}}};
+}
+
+static IoAwait async_close(IoBackend& io, int fd) {
+    return IoAwait{io, IoOp{IO_CLOSE, nullptr, 0, fd, nullptr, 0, 0, 0, {}}};
+}
+
+// Fallback: satu thread penulis menjalankan syscall blocking secara berurutan
+class ThreadIoBackend : public IoBackend {
+public:
+    explicit ThreadIoBackend(ThreadPool& pool) : pool_(pool) {
+        thread_ = std::thread([this] { run(); });
+    }
+
+    ~ThreadIoBackend() override {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_one();
+        thread_.join();
+    }
+
+    const char* name() const override { return "thread penulis"; }
+
+    void submit(IoOp* op) override {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue_.push_back(op);
+        }
+        cv_.notify_one();
+    }
+
+private:
+    void run() {
+        for (;;) {
+            IoOp* op;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+                if (queue_.empty()) return;
+                op = queue_.front();
+                queue_.pop_front();
+            }
+            long r = 0;
+            switch (op->type) {
+                case IO_OPEN:  r = open(op->path, op->flags, 0644); break;
+                case IO_WRITE: r = pwrite(op->fd, op->buf, op->len, (off_t)op->offset); break;
+                case IO_CLOSE: r = close(op->fd); break;
+            }
+            op->result = r < 0 ? -errno : r;
+            pool_.post(op->handle);
+        }
+    }
+
+    ThreadPool& pool_;
+    std::thread thread_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<IoOp*> queue_;
+    bool stopping_ = false;
+};
+
+#ifdef __linux__
+// io_uring lewat syscall langsung (tanpa liburing). Submit dari worker manapun
+// dilindungi mutex; satu thread reaper menunggu completion dan mengembalikan
+// coroutine ke pool. Bila ring rusak, op yang masih berjalan dan submit
+// berikutnya diselesaikan dengan -errno, jadi tidak ada tile yang menggantung.
+class UringIoBackend : public IoBackend {
+public:
+    explicit UringIoBackend(ThreadPool& pool) : pool_(pool) {}
+
+    ~UringIoBackend() override {
+        if (reaper_.joinable()) {
+            // NOP dengan user_data 0 adalah sinyal berhenti untuk reaper
+            IoOp* stop = nullptr;
+            push_sqe(IORING_OP_NOP, stop);
+            reaper_.join();
+        }
+        if (sqes_) munmap(sqes_, sqes_size_);
+        if (cq_ptr_ && cq_ptr_ != sq_ptr_) munmap(cq_ptr_, cq_size_);
+        if (sq_ptr_) munmap(sq_ptr_, sq_size_);
+        if (ring_fd_ >= 0) close(ring_fd_);
+    }
+
+    const char* name() const override { return "io_uring"; }
+
+    // Gagal bila kernel/seccomp menolak io_uring atau opcode yang dibutuhkan
+    bool start(unsigned entries) {
+        io_uring_params params;
+        memset(&params, 0, sizeof(params));
+        ring_fd_ = (int)syscall(__NR_io_uring_setup, entries, &params);
+        if (ring_fd_ < 0) return false;
+
+        sq_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cq_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (single_mmap) {
+            if (cq_size_ > sq_size_) sq_size_ = cq_size_;
+            cq_size_ = sq_size_;
+        }
+
+        sq_ptr_ = mmap(nullptr, sq_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                       ring_fd_, IORING_OFF_SQ_RING);
+        if (sq_ptr_ == MAP_FAILED) { sq_ptr_ = nullptr; return false; }
+        if (single_mmap) {
+            cq_ptr_ = sq_ptr_;
+        } else {
+            cq_ptr_ = mmap(nullptr, cq_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                           ring_fd_, IORING_OFF_CQ_RING);
+            if (cq_ptr_ == MAP_FAILED) { cq_ptr_ = nullptr; return false; }
+        }
+        sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqes = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                          ring_fd_, IORING_OFF_SQES);
+        if (sqes == MAP_FAILED) return false;
+        sqes_ = (io_uring_sqe*)sqes;
+
+        char* sq = (char*)sq_ptr_;
+        char* cq = (char*)cq_ptr_;
+        sq_head_ = (unsigned*)(sq + params.sq_off.head);
+        sq_tail_ = (unsigned*)(sq + params.sq_off.tail);
+        sq_mask_ = *(unsigned*)(sq + params.sq_off.ring_mask);
+        sq_array_ = (unsigned*)(sq + params.sq_off.array);
+        sq_entries_ = params.sq_entries;
+        cq_head_ = (unsigned*)(cq + params.cq_off.head);
+        cq_tail_ = (unsigned*)(cq + params.cq_off.tail);
+        cq_mask_ = *(unsigned*)(cq + params.cq_off.ring_mask);
+        cqes_ = (io_uring_cqe*)(cq + params.cq_off.cqes);
+
+        if (!probe_opcodes()) return false;
+
+        reaper_ = std::thread([this] { reap(); });
+        return true;
+    }
+
+    void submit(IoOp* op) override {
+        switch (op->type) {
+            case IO_OPEN:  push_sqe(IORING_OP_OPENAT, op); break;
+            case IO_WRITE: push_sqe(IORING_OP_WRITE, op); break;
+            case IO_CLOSE: push_sqe(IORING_OP_CLOSE, op); break;
+        }
+    }
+
+private:
+    bool probe_opcodes() {
+        const int ops = 256;
+        std::vector<uint8_t> storage(sizeof(io_uring_probe) + ops * sizeof(io_uring_probe_op), 0);
+        io_uring_probe* probe = (io_uring_probe*)storage.data();
+        if (syscall(__NR_io_uring_register, ring_fd_, IORING_REGISTER_PROBE, probe, ops) < 0) {
+            return false;
+        }
+        const int needed[] = {IORING_OP_NOP, IORING_OP_OPENAT, IORING_OP_WRITE, IORING_OP_CLOSE};
+        for (int op : needed) {
+            if (op > probe->last_op || !(probe->ops[op].flags & IO_URING_OP_SUPPORTED)) return false;
+        }
+        return true;
+    }
+
+    void push_sqe(int opcode, IoOp* op) {
+        std::unique_lock<std::mutex> lock(submit_mutex_);
+        if (error_) {
+            // Reaper sudah berhenti; NOP stop tidak diperlukan lagi
+            lock.unlock();
+            if (op) {
+                op->result = -error_;
+                pool_.post(op->handle);
+            }
+            return;
+        }
+        if (op) inflight_.insert(op);
+        unsigned tail = *sq_tail_;
+        // Tanpa SQPOLL kernel mengonsumsi SQE di dalam io_uring_enter, dan jumlah
+        // op dalam proses dibatasi jumlah slot, jadi ring tidak pernah penuh
+        while (tail - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) >= sq_entries_) {
+            std::this_thread::yield();
+        }
+        unsigned index = tail & sq_mask_;
+        io_uring_sqe* sqe = &sqes_[index];
+        memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = (uint8_t)opcode;
+        sqe->user_data = (uint64_t)(uintptr_t)op;
+        if (op) {
+            switch (op->type) {
+                case IO_OPEN:
+                    sqe->fd = AT_FDCWD;
+                    sqe->addr = (uint64_t)(uintptr_t)op->path;
+                    sqe->len = 0644;
+                    sqe->open_flags = (uint32_t)op->flags;
+                    break;
+                case IO_WRITE:
+                    sqe->fd = op->fd;
+                    sqe->addr = (uint64_t)(uintptr_t)op->buf;
+                    sqe->len = (uint32_t)op->len;
+                    sqe->off = op->offset;
+                    break;
+                case IO_CLOSE:
+                    sqe->fd = op->fd;
+                    break;
+            }
+        }
+        sq_array_[index] = index;
+        __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+
+        while (syscall(__NR_io_uring_enter, ring_fd_, 1, 0, 0, nullptr, 0) < 0 &&
+               (errno == EINTR || errno == EAGAIN || errno == EBUSY)) {
+        }
+    }
+
+    void reap() {
+        bool stop = false;
+        while (!stop) {
+            long r = syscall(__NR_io_uring_enter, ring_fd_, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+            if (r < 0 && errno != EINTR) {
+                int err = errno;
+                fprintf(stderr, "Error: io_uring_enter gagal (%s)\n", strerror(err));
+                fail_inflight(err);
+                return;
+            }
+            unsigned head = *cq_head_;
+            unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+            while (head != tail) {
+                io_uring_cqe* cqe = &cqes_[head & cq_mask_];
+                IoOp* op = (IoOp*)(uintptr_t)cqe->user_data;
+                if (op) {
+                    {
+                        std::lock_guard<std::mutex> lock(submit_mutex_);
+                        inflight_.erase(op);
+                    }
+                    op->result = cqe->res;
+                    pool_.post(op->handle);
+                } else {
+                    stop = true;
+                }
+                head++;
+            }
+            __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+        }
+    }
+
+    // Dipanggil reaper sebelum berhenti karena error: completion op yang sudah
+    // di-submit tidak akan pernah dibaca lagi, jadi coroutine-nya dilanjutkan
+    // dengan error tersebut
+    void fail_inflight(int err) {
+        std::vector<IoOp*> failed;
+        {
+            std::lock_guard<std::mutex> lock(submit_mutex_);
+            error_ = err;
+            failed.assign(inflight_.begin(), inflight_.end());
+            inflight_.clear();
+        }
+        for (IoOp* op : failed) {
+            op->result = -err;
+            pool_.post(op->handle);
+        }
+    }
+
+    ThreadPool& pool_;
+    int ring_fd_ = -1;
+    void* sq_ptr_ = nullptr;
+    void* cq_ptr_ = nullptr;
+    size_t sq_size_ = 0, cq_size_ = 0, sqes_size_ = 0;
+    io_uring_sqe* sqes_ = nullptr;
+    io_uring_cqe* cqes_ = nullptr;
+    unsigned *sq_head_ = nullptr, *sq_tail_ = nullptr, *sq_array_ = nullptr;
+    unsigned *cq_head_ = nullptr, *cq_tail_ = nullptr;
+    unsigned sq_mask_ = 0, cq_mask_ = 0, sq_entries_ = 0;
+    std::mutex submit_mutex_;
+    std::unordered_set<IoOp*> inflight_;  // sudah di-submit, completion belum dibaca
+    int error_ = 0;                       // errno yang menghentikan reaper
+    std::thread reaper_;
+};
+#endif
+
+// === Pipeline ===
+struct PipelineStats {
+    double total_time;
+    double busy_time;         // jumlah waktu komputasi semua worker
+    double render_time;       // hanya baseline: fase render
+    double write_time;        // hanya baseline: fase tulis
+    uint64_t checksum;        // gabungan hash semua file tile
+    size_t bytes;
+    int errors;
+};
+
+struct Pipeline {
+    const PipelineConfig& cfg;
+    ThreadPool& pool;
+    BufferPool buffers;
+    IoBackend& io;
+    std::atomic<uint64_t> checksum{0};
+    std::atomic<size_t> bytes{0};
+    std::atomic<int> errors{0};
+    int remaining;                // dilindungi done_mutex
+    std::mutex done_mutex;
+    std::condition_variable done_cv;
+
+    Pipeline(const PipelineConfig& c, ThreadPool& p, IoBackend& backend)
+        : cfg(c), pool(p), buffers(p, c.slots, c.tile_size), io(backend),
+          remaining(c.tiles_x * c.tiles_y) {}
+
+    // Decrement di bawah lock: run_pipeline menghancurkan Pipeline begitu melihat
+    // remaining == 0, dan itu baru bisa terjadi setelah worker melepas done_mutex
+    void finish_tile() {
+        std::lock_guard<std::mutex> lock(done_mutex);
+        if (--remaining == 0) done_cv.notify_all();
+    }
+};
+
+// Satu tile: render -> pewarnaan/encode -> open/write/close asinkron
+static DetachedTask tile_task(Pipeline& pl, int tx, int ty) {
+    TileBuffer* buf = co_await pl.buffers.acquire();
+
+    co_await run_on(pl.pool, [&] { render_tile(pl.cfg, tx, ty, buf->iterations.data()); });
+    size_t size = co_await run_on(pl.pool, [&] { return colorize_tile(pl.cfg, *buf); });
+    pl.checksum += fnv1a(buf->encoded.data(), size);
+
+    tile_path(pl.cfg, tx, ty, buf->path, sizeof(buf->path));
+    long fd = co_await async_open(pl.io, buf->path, open_flags(pl.cfg));
+    if (fd < 0) {
+        pl.errors++;
+    } else {
+        size_t written = 0;
+        while (written < size) {
+            long r = co_await async_write(pl.io, (int)fd, buf->encoded.data() + written,
+                                          size - written, written);
+            if (r <= 0) {
+                pl.errors++;
+                break;
+            }
+            written += (size_t)r;
+        }
+        pl.bytes += written;
+        co_await async_close(pl.io, (int)fd);
+    }
+
+    pl.buffers.release(buf);
+    pl.finish_tile();
+}
+
+static PipelineStats run_pipeline(const PipelineConfig& cfg, ThreadPool& pool, IoBackend& io) {
+    PipelineStats stats = {};
+    double busy_before = pool.busy_seconds();
+    double start = now_seconds();
+    {
+        Pipeline pl(cfg, pool, io);
+        // Semua tile diluncurkan sekaligus; yang tidak kebagian buffer langsung
+        // ditangguhkan di BufferPool
+        for (int ty = 0; ty < cfg.tiles_y; ty++) {
+            for (int tx = 0; tx < cfg.tiles_x; tx++) {
+                tile_task(pl, tx, ty);
+            }
+        }
+        std::unique_lock<std::mutex> lock(pl.done_mutex);
+        pl.done_cv.wait(lock, [&] { return pl.remaining == 0; });
+        stats.checksum = pl.checksum.load();
+        stats.bytes = pl.bytes.load();
+        stats.errors = pl.errors.load();
+    }
+    stats.total_time = now_seconds() - start;
+    stats.busy_time = pool.busy_seconds() - busy_before;
+    return stats;
+}
+
+// Baseline seperti program CLI: render semua tile dengan semua core, lalu
+// pewarnaan dan tulis blocking satu per satu sementara core menganggur
+static PipelineStats run_sequential(const PipelineConfig& cfg, int num_threads) {
+    PipelineStats stats = {};
+    int tiles = cfg.tiles_x * cfg.tiles_y;
+    size_t tile_pixels = (size_t)cfg.tile_size * cfg.tile_size;
+    std::vector<int> iterations(tile_pixels * tiles);
+    double start = now_seconds();
+
+    std::atomic<int> next{0};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < num_threads; t++) {
+        workers.emplace_back([&] {
+            for (int i = next++; i < tiles; i = next++) {
+                render_tile(cfg, i % cfg.tiles_x, i / cfg.tiles_x, &iterations[tile_pixels * i]);
+            }
+        });
+    }
+    for (auto& t : workers) t.join();
+    double render_end = now_seconds();
+
+    double colorize_time = 0.0;
+    TileBuffer buf;
+    buf.image.resize(tile_pixels);
+    buf.encoded.resize(bmp_file_size(cfg.tile_size, cfg.tile_size));
+    for (int i = 0; i < tiles; i++) {
+        buf.iterations.assign(iterations.begin() + tile_pixels * i,
+                              iterations.begin() + tile_pixels * (i + 1));
+        double colorize_start = now_seconds();
+        size_t size = colorize_tile(cfg, buf);
+        colorize_time += now_seconds() - colorize_start;
+        stats.checksum += fnv1a(buf.encoded.data(), size);
+
+        tile_path(cfg, i % cfg.tiles_x, i / cfg.tiles_x, buf.path, sizeof(buf.path));
+        int fd = open(buf.path, open_flags(cfg), 0644);
+        if (fd < 0) {
+            stats.errors++;
+            continue;
+        }
+        size_t written = 0;
+        while (written < size) {
+            ssize_t r = pwrite(fd, buf.encoded.data() + written, size - written, (off_t)written);
+            if (r <= 0) {
+                stats.errors++;
+                break;
+            }
+            written += (size_t)r;
+        }
+        stats.bytes += written;
+        close(fd);
+    }
+
+    double end = now_seconds();
+    stats.total_time = end - start;
+    stats.render_time = render_end - start;
+    stats.write_time = end - render_end;
+    // Fase render memakai semua core, pewarnaan hanya satu core
+    stats.busy_time = stats.render_time * num_threads + colorize_time;
+    return stats;
+}
+
+static void print_stats(const char* label, const PipelineStats& s, int tiles, int num_threads,
+                        double baseline_time) {
+    printf("%-22s %8.3f s  %9.0f tile/s  %7.1f MB/s  utilisasi core %5.1f%%",
+           label, s.total_time, tiles / s.total_time, s.bytes / s.total_time / 1e6,
+           100.0 * s.busy_time / (s.total_time * num_threads));
+    if (baseline_time > 0) printf("  speedup %.2fx", baseline_time / s.total_time);
+    printf("\n");
+    if (s.errors) printf("⚠ Peringatan: %d operasi I/O gagal\n", s.errors);
+}
+
+static void print_usage(const char* prog) {
+    printf("Penggunaan: %s [kolom baris ukuran_tile max_iterasi] [--slots N] [--dsync]\n"
+           "       [--no-uring] [--dir direktori]\n", prog);
+}
+
+int main(int argc, char** argv) {
+    PipelineConfig cfg;
+    cfg.tiles_x = 64;
+    cfg.tiles_y = 64;
+    cfg.tile_size = 64;
+    cfg.max_iterations = 256;
+    cfg.slots = 0;
+    cfg.dsync = false;
+    cfg.dir = "tiles_async";
+    cfg.min_real = -2.5;
+    cfg.max_real = 1.0;
+    cfg.min_imag = -1.0;
+    cfg.max_imag = 1.0;
+    bool use_uring = true;
+
+    int positional = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--slots") == 0 && i + 1 < argc) {
+            cfg.slots = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--dsync") == 0) {
+            cfg.dsync = true;
+        } else if (strcmp(argv[i], "--no-uring") == 0) {
+            use_uring = false;
+        } else if (strcmp(argv[i], "--dir") == 0 && i + 1 < argc) {
+            cfg.dir = argv[++i];
+        } else if (argv[i][0] != '-' && positional < 4) {
+            int value = atoi(argv[i]);
+            if (positional == 0) cfg.tiles_x = value;
+            else if (positional == 1) cfg.tiles_y = value;
+            else if (positional == 2) cfg.tile_size = value;
+            else cfg.max_iterations = value;
+            positional++;
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (cfg.tiles_x < 1 || cfg.tiles_y < 1 || cfg.tile_size < 1 || cfg.max_iterations < 1) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    int num_threads = (int)std::thread::hardware_concurrency();
+    if (num_threads < 1) num_threads = 1;
+    if (cfg.slots < 1) cfg.slots = num_threads * 4;
+    int tiles = cfg.tiles_x * cfg.tiles_y;
+
+    if (mkdir(cfg.dir.c_str(), 0755) != 0 && errno != EEXIST) {
+        fprintf(stderr, "Error: Gagal membuat direktori %s (%s)\n", cfg.dir.c_str(), strerror(errno));
+        return 1;
+    }
+
+    printf("=== Pipeline Render Asinkron (coroutine C++20) ===\n");
+    printf("Tile: %d (%dx%d), ukuran %dx%d, gambar %dx%d, iterasi maks %d\n",
+           tiles, cfg.tiles_x, cfg.tiles_y, cfg.tile_size, cfg.tile_size,
+           cfg.tiles_x * cfg.tile_size, cfg.tiles_y * cfg.tile_size, cfg.max_iterations);
+    printf("Thread: %d, slot dalam proses: %d%s, output: %s/\n\n",
+           num_threads, cfg.slots, cfg.dsync ? ", O_DSYNC" : "", cfg.dir.c_str());
+
+    PipelineStats baseline = run_sequential(cfg, num_threads);
+    print_stats("Sekuensial (CLI)", baseline, tiles, num_threads, 0.0);
+    printf("  render %.3f s, pewarnaan+tulis %.3f s (core lain menganggur)\n",
+           baseline.render_time, baseline.write_time);
+
+    bool ok = true;
+    ThreadPool pool(num_threads);
+    {
+        ThreadIoBackend io(pool);
+        PipelineStats s = run_pipeline(cfg, pool, io);
+        print_stats("Pipeline + thread", s, tiles, num_threads, baseline.total_time);
+        ok = ok && s.checksum == baseline.checksum && s.errors == 0;
+    }
+
+#ifdef __linux__
+    if (use_uring) {
+        UringIoBackend io(pool);
+        if (io.start((unsigned)cfg.slots * 2)) {
+            PipelineStats s = run_pipeline(cfg, pool, io);
+            print_stats("Pipeline + io_uring", s, tiles, num_threads, baseline.total_time);
+            ok = ok && s.checksum == baseline.checksum && s.errors == 0;
+        } else {
+            printf("io_uring tidak tersedia, memakai fallback thread penulis\n");
+        }
+    }
+#else
+    (void)use_uring;
+#endif
+
+    if (ok) {
+        printf("\n✓ Verifikasi: semua mode menulis tile yang identik\n");
+    } else {
+        printf("\n⚠ Peringatan: isi tile berbeda antar mode atau ada I/O yang gagal\n");
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,627 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <omp.h>
+#include "render.h"
+
+// Cara akumulasi histogram densitas orbit
+typedef enum {
+    ACC_SHARED_ATOMIC,   // satu histogram bersama, increment atomik (baseline naif)
+    ACC_SHARDED_ATOMIC,  // beberapa shard histogram, thread dibagi ke shard
+    ACC_PER_THREAD       // histogram privat per thread, digabung di akhir
+} AccumMode;
+
+static const char* accum_mode_name(AccumMode mode) {
+    switch (mode) {
+        case ACC_SHARED_ATOMIC:  return "shared-atomic";
+        case ACC_SHARDED_ATOMIC: return "sharded-atomic";
+        case ACC_PER_THREAD:     return "per-thread";
+    }
+    return "?";
+}
+
+// Parameter render Buddhabrot
+typedef struct {
+    int width;
+    int height;
+    int max_iter;   // orbit yang tidak lolos sampai sini dianggap interior (dibuang)
+    int min_iter;   // orbit yang lolos terlalu cepat tidak dihitung
+    double min_real, max_real, min_imag, max_imag;  // area gambar
+} BuddhaParams;
+
+// Area pengambilan sampel c (seluruh himpunan berada di dalamnya)
+#define SAMPLE_MIN_REAL -2.0
+#define SAMPLE_MAX_REAL  1.0
+#define SAMPLE_MIN_IMAG -1.5
+#define SAMPLE_MAX_IMAG  1.5
+
+// Resolusi grid importance sampling dan jumlah probe per sel
+#define GRID_CELLS 128
+#define GRID_PROBES 16
+
+// Bobot fixed-point per orbit (16 bit pecahan); sel yang jarang disampel mendapat
+// bobot lebih besar sehingga estimasi densitas tetap tidak bias. Galat pembulatan
+// paling banyak 2^-17 per deposit, histogram 64-bit menampung jumlahnya.
+#define WEIGHT_SHIFT 16
+#define WEIGHT_ONE (1u << WEIGHT_SHIFT)
+
+// Sampel dibagi menjadi blok; RNG di-seed per blok sehingga hasil
+// identik untuk berapapun jumlah thread dan mode akumulasi
+#define SAMPLE_BLOCK 4096
+
+// Cek bias: ukuran blok perbandingan (pixel) dan toleransi relatif
+#define CHECK_BLOCK 120
+#define CHECK_TOTAL_TOL 0.02
+#define CHECK_BLOCK_TOL 0.10
+
+// Peta importance: CDF atas sel grid dan bobot deposit per sel
+typedef struct {
+    int enabled;
+    double* cdf;        // GRID_CELLS*GRID_CELLS, kumulatif ternormalisasi
+    uint32_t* weight;   // bobot fixed-point per sel
+    double useful_fraction;  // fraksi probe yang menghasilkan orbit berguna
+} ImportanceMap;
+
+// Statistik render
+typedef struct {
+    long long samples;
+    long long useful_samples;
+    long long orbit_points;
+} BuddhaStats;
+
+// Generator acak splitmix64 (cepat, cukup untuk sampling)
+static inline uint64_t splitmix64(uint64_t* state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static inline double random_unit(uint64_t* state) {
+    return (splitmix64(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Titik di kardioid utama atau bulb periode-2 tidak pernah lolos
+static inline int in_main_bulbs(double real, double imag) {
+    double x = real - 0.25;
+    double q = x * x + imag * imag;
+    if (q * (q + x) <= 0.25 * imag * imag) return 1;
+    double xb = real + 1.0;
+    return xb * xb + imag * imag <= 0.0625;
+}
+
+// Iterasi orbit z -> z^2 + c (sama dengan mandelbrot_iterations di render.h),
+// menyimpan setiap titik orbit. Mengembalikan panjang orbit jika lolos, 0 jika tidak.
+static inline int trace_orbit(double real, double imag, int max_iter,
+                              double* orbit_real, double* orbit_imag) {
+    double z_real = 0.0;
+    double z_imag = 0.0;
+    int iter = 0;
+
+    while (iter < max_iter && (z_real * z_real + z_imag * z_imag) < 4.0) {
+        double temp = z_real * z_real - z_imag * z_imag + real;
+        z_imag = 2.0 * z_real * z_imag + imag;
+        z_real = temp;
+        orbit_real[iter] = z_real;
+        orbit_imag[iter] = z_imag;
+        iter++;
+    }
+
+    return iter < max_iter ? iter : 0;
+}
+
+// Hitung berapa titik orbit yang jatuh di dalam gambar
+static int count_visible(const BuddhaParams* p, const double* orbit_real,
+                         const double* orbit_imag, int length) {
+    double real_scale = p->width / (p->max_real - p->min_real);
+    double imag_scale = p->height / (p->max_imag - p->min_imag);
+    int visible = 0;
+    for (int i = 0; i < length; i++) {
+        int x = (int)((orbit_real[i] - p->min_real) * real_scale);
+        int y = (int)((orbit_imag[i] - p->min_imag) * imag_scale);
+        if (x >= 0 && x < p->width && y >= 0 && y < p->height) visible++;
+    }
+    return visible;
+}
+
+// Bangun peta importance dari pass probe kasar: sel yang menghasilkan orbit
+// berguna (lolos, cukup panjang, terlihat) disampel lebih sering
+static int build_importance_map(ImportanceMap* map, const BuddhaParams* p, int enabled) {
+    int cells = GRID_CELLS * GRID_CELLS;
+    map->enabled = enabled;
+    map->cdf = (double*)malloc(cells * sizeof(double));
+    map->weight = (uint32_t*)malloc(cells * sizeof(uint32_t));
+    map->useful_fraction = 0.0;
+    if (!map->cdf || !map->weight) return 0;
+
+    if (!enabled) {
+        for (int i = 0; i < cells; i++) {
+            map->cdf[i] = (double)(i + 1) / cells;
+            map->weight[i] = WEIGHT_ONE;
+        }
+        return 1;
+    }
+
+    double* score = (double*)malloc(cells * sizeof(double));
+    if (!score) return 0;
+
+    double cell_w = (SAMPLE_MAX_REAL - SAMPLE_MIN_REAL) / GRID_CELLS;
+    double cell_h = (SAMPLE_MAX_IMAG - SAMPLE_MIN_IMAG) / GRID_CELLS;
+    long long useful_total = 0;
+
+    #pragma omp parallel reduction(+:useful_total)
+    {
+        double* orbit_real = (double*)malloc(p->max_iter * sizeof(double));
+        double* orbit_imag = (double*)malloc(p->max_iter * sizeof(double));
+
+        #pragma omp for schedule(dynamic, 16)
+        for (int cell = 0; cell < cells; cell++) {
+            uint64_t rng = 0xB0DDB0DDULL ^ ((uint64_t)cell << 20);
+            double base_real = SAMPLE_MIN_REAL + (cell % GRID_CELLS) * cell_w;
+            double base_imag = SAMPLE_MIN_IMAG + (cell / GRID_CELLS) * cell_h;
+            int useful = 0;
+            for (int k = 0; k < GRID_PROBES; k++) {
+                double real = base_real + random_unit(&rng) * cell_w;
+                double imag = base_imag + random_unit(&rng) * cell_h;
+                if (in_main_bulbs(real, imag)) continue;
+                int length = trace_orbit(real, imag, p->max_iter, orbit_real, orbit_imag);
+                if (length >= p->min_iter &&
+                    count_visible(p, orbit_real, orbit_imag, length) > 0) {
+                    useful++;
+                }
+            }
+            score[cell] = useful;
+            useful_total += useful;
+        }
+
+        free(orbit_real);
+        free(orbit_imag);
+    }
+
+    // Sel tanpa probe berguna tetap diberi peluang kecil agar estimasi tidak bias
+    double mean = (double)useful_total / cells;
+    double floor_score = mean > 0.0 ? mean / 16.0 : 1.0;
+    double total = 0.0;
+    for (int i = 0; i < cells; i++) {
+        if (score[i] < floor_score) score[i] = floor_score;
+        total += score[i];
+    }
+    double avg = total / cells;
+    double running = 0.0;
+    for (int i = 0; i < cells; i++) {
+        running += score[i];
+        map->cdf[i] = running / total;
+        // Bobot = (peluang seragam / peluang importance), dalam fixed-point
+        map->weight[i] = (uint32_t)(WEIGHT_ONE * avg / score[i] + 0.5);
+        if (map->weight[i] == 0) map->weight[i] = 1;
+    }
+    map->cdf[cells - 1] = 1.0;
+    map->useful_fraction = (double)useful_total / ((double)cells * GRID_PROBES);
+
+    free(score);
+    return 1;
+}
+
+static void free_importance_map(ImportanceMap* map) {
+    free(map->cdf);
+    free(map->weight);
+}
+
+// Pilih sel berdasarkan CDF (pencarian biner)
+static inline int pick_cell(const ImportanceMap* map, double u) {
+    int lo = 0;
+    int hi = GRID_CELLS * GRID_CELLS - 1;
+    while (lo < hi) {
+        int mid = (lo + hi) >> 1;
+        if (map->cdf[mid] < u) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+// Tambahkan orbit ke histogram target
+static inline int deposit_orbit(uint64_t* target, int atomic, uint32_t weight,
+                                const BuddhaParams* p, double real_scale, double imag_scale,
+                                const double* orbit_real, const double* orbit_imag, int length) {
+    int visible = 0;
+    for (int i = 0; i < length; i++) {
+        int x = (int)((orbit_real[i] - p->min_real) * real_scale);
+        int y = (int)((orbit_imag[i] - p->min_imag) * imag_scale);
+        if (x < 0 || x >= p->width || y < 0 || y >= p->height) continue;
+        uint64_t* cell = &target[y * p->width + x];
+        if (atomic) {
+            __atomic_fetch_add(cell, weight, __ATOMIC_RELAXED);
+        } else {
+            *cell += weight;
+        }
+        visible++;
+    }
+    return visible;
+}
+
+// Render Buddhabrot paralel. density harus berukuran width*height dan akan ditimpa.
+// num_shards hanya dipakai oleh ACC_SHARDED_ATOMIC (0 = otomatis).
+int render_buddhabrot(uint64_t* density, const BuddhaParams* p, const ImportanceMap* map,
+                      long long samples, AccumMode mode, int num_threads, int num_shards,
+                      BuddhaStats* stats) {
+    size_t pixels = (size_t)p->width * p->height;
+    double real_scale = p->width / (p->max_real - p->min_real);
+    double imag_scale = p->height / (p->max_imag - p->min_imag);
+    double cell_w = (SAMPLE_MAX_REAL - SAMPLE_MIN_REAL) / GRID_CELLS;
+    double cell_h = (SAMPLE_MAX_IMAG - SAMPLE_MIN_IMAG) / GRID_CELLS;
+    long long blocks = (samples + SAMPLE_BLOCK - 1) / SAMPLE_BLOCK;
+
+    // Histogram bantu: satu per shard atau satu per thread
+    int num_buffers = 0;
+    if (mode == ACC_SHARDED_ATOMIC) {
+        num_buffers = num_shards > 0 ? num_shards : (num_threads + 3) / 4;
+        if (num_buffers < 1) num_buffers = 1;
+    } else if (mode == ACC_PER_THREAD) {
+        num_buffers = num_threads;
+    }
+    uint64_t** buffers = NULL;
+    if (num_buffers > 0) {
+        buffers = (uint64_t**)calloc(num_buffers, sizeof(uint64_t*));
+        if (!buffers) return 0;
+    }
+
+    memset(density, 0, pixels * sizeof(uint64_t));
+    long long useful = 0, points = 0;
+    int failed = 0;
+
+    #pragma omp parallel num_threads(num_threads) reduction(+:useful, points)
+    {
+        int tid = omp_get_thread_num();
+        double* orbit_real = (double*)malloc(p->max_iter * sizeof(double));
+        double* orbit_imag = (double*)malloc(p->max_iter * sizeof(double));
+
+        // Buffer dialokasikan dan di-first-touch oleh thread pemiliknya
+        // (shard oleh thread pertama di shard tersebut)
+        if (mode == ACC_PER_THREAD ||
+            (mode == ACC_SHARDED_ATOMIC && tid < num_buffers)) {
+            buffers[tid] = (uint64_t*)calloc(pixels, sizeof(uint64_t));
+        }
+        #pragma omp barrier
+
+        uint64_t* target = density;
+        int atomic = 1;
+        if (mode == ACC_PER_THREAD) {
+            target = buffers[tid];
+            atomic = 0;
+        } else if (mode == ACC_SHARDED_ATOMIC) {
+            target = buffers[tid % num_buffers];
+        }
+
+        if (!orbit_real || !orbit_imag || !target) {
+            #pragma omp atomic write
+            failed = 1;
+        }
+        // Semua thread harus sepakat sebelum masuk worksharing loop
+        #pragma omp barrier
+
+        if (!failed) {
+            #pragma omp for schedule(dynamic, 1)
+            for (long long block = 0; block < blocks; block++) {
+                uint64_t rng = 0x5EEDULL ^ ((uint64_t)block * 0x9E3779B97F4A7C15ULL);
+                long long end = (block + 1) * SAMPLE_BLOCK;
+                if (end > samples) end = samples;
+
+                for (long long s = block * SAMPLE_BLOCK; s < end; s++) {
+                    int cell = pick_cell(map, random_unit(&rng));
+                    double real = SAMPLE_MIN_REAL + ((cell % GRID_CELLS) + random_unit(&rng)) * cell_w;
+                    double imag = SAMPLE_MIN_IMAG + ((cell / GRID_CELLS) + random_unit(&rng)) * cell_h;
+                    if (in_main_bulbs(real, imag)) continue;
+
+                    int length = trace_orbit(real, imag, p->max_iter, orbit_real, orbit_imag);
+                    if (length < p->min_iter) continue;
+
+                    int visible = deposit_orbit(target, atomic, map->weight[cell], p,
+                                                real_scale, imag_scale,
+                                                orbit_real, orbit_imag, length);
+                    if (visible > 0) useful++;
+                    points += visible;
+                }
+            }
+        }
+
+        free(orbit_real);
+        free(orbit_imag);
+
+        // Gabungkan buffer ke density, paralel per pixel
+        if (num_buffers > 0 && !failed) {
+            #pragma omp for schedule(static)
+            for (size_t i = 0; i < pixels; i++) {
+                uint64_t sum = 0;
+                for (int b = 0; b < num_buffers; b++) sum += buffers[b][i];
+                density[i] = sum;
+            }
+        }
+    }
+
+    if (buffers) {
+        for (int b = 0; b < num_buffers; b++) free(buffers[b]);
+        free(buffers);
+    }
+
+    if (stats) {
+        stats->samples = samples;
+        stats->useful_samples = useful;
+        stats->orbit_points = points;
+    }
+    return !failed;
+}
+
+// Konversi densitas ke warna (tone mapping akar kuadrat)
+void colorize_density(RGB* image, const uint64_t* density, int width, int height) {
+    size_t pixels = (size_t)width * height;
+    uint64_t peak = 1;
+    for (size_t i = 0; i < pixels; i++) {
+        if (density[i] > peak) peak = density[i];
+    }
+    double inv_peak = 1.0 / sqrt((double)peak);
+
+    #pragma omp parallel for schedule(static)
+    for (long long i = 0; i < (long long)pixels; i++) {
+        double t = sqrt((double)density[i]) * inv_peak;
+        if (t > 1.0) t = 1.0;
+        image[i].r = (uint8_t)(255 * t);
+        image[i].g = (uint8_t)(255 * t * t);
+        image[i].b = (uint8_t)(255 * sqrt(t));
+    }
+}
+
+// Checksum sederhana untuk memastikan semua mode menghasilkan histogram yang sama
+static uint64_t density_checksum(const uint64_t* density, size_t pixels) {
+    uint64_t h = 1469598103934665603ULL;
+    for (size_t i = 0; i < pixels; i++) {
+        h = (h ^ density[i]) * 1099511628211ULL;
+    }
+    return h;
+}
+
+// Benchmark skalabilitas: semua mode akumulasi untuk 1..N thread
+static int run_scaling_benchmark(const BuddhaParams* p, const ImportanceMap* map, long long samples) {
+    size_t pixels = (size_t)p->width * p->height;
+    uint64_t* density = (uint64_t*)malloc(pixels * sizeof(uint64_t));
+    if (!density) {
+        printf("Error: Gagal mengalokasi memori\n");
+        return 1;
+    }
+
+    int max_threads = omp_get_max_threads();
+    AccumMode modes[] = {ACC_SHARED_ATOMIC, ACC_SHARDED_ATOMIC, ACC_PER_THREAD};
+    uint64_t reference = 0;
+    int consistent = 1;
+
+    printf("=== BENCHMARK SKALABILITAS BUDDHABROT ===\n");
+    printf("Sampel per run: %lld\n", samples);
+    printf("%-16s %8s %10s %14s %10s\n", "Mode", "Thread", "Waktu(s)", "Msampel/s", "Speedup");
+
+    for (int m = 0; m < 3; m++) {
+        double base_time = 0.0;
+        for (int threads = 1; ; threads *= 2) {
+            if (threads > max_threads) threads = max_threads;
+            BuddhaStats stats;
+            double start = omp_get_wtime();
+            if (!render_buddhabrot(density, p, map, samples, modes[m], threads, 0, &stats)) {
+                printf("Error: Gagal mengalokasi histogram\n");
+                free(density);
+                return 1;
+            }
+            double elapsed = omp_get_wtime() - start;
+            if (threads == 1) base_time = elapsed;
+
+            uint64_t sum = density_checksum(density, pixels);
+            if (m == 0 && threads == 1) reference = sum;
+            else if (sum != reference) consistent = 0;
+
+            printf("%-16s %8d %10.3f %14.2f %9.2fx\n", accum_mode_name(modes[m]), threads,
+                   elapsed, samples / elapsed / 1e6, base_time / elapsed);
+            if (threads >= max_threads) break;
+        }
+    }
+
+    if (consistent) {
+        printf("✓ Verifikasi: Semua mode dan jumlah thread menghasilkan histogram identik\n");
+    } else {
+        printf("⚠ Peringatan: Histogram berbeda antar mode/jumlah thread\n");
+    }
+
+    free(density);
+    return consistent ? 0 : 1;
+}
+
+// Massa histogram per blok kasar (dalam satuan sampel seragam)
+static void block_mass(const uint64_t* density, const BuddhaParams* p,
+                       double* mass, int blocks_x, int blocks_y) {
+    memset(mass, 0, (size_t)blocks_x * blocks_y * sizeof(double));
+    for (int y = 0; y < p->height; y++) {
+        for (int x = 0; x < p->width; x++) {
+            mass[(y / CHECK_BLOCK) * blocks_x + x / CHECK_BLOCK] +=
+                (double)density[(size_t)y * p->width + x] / WEIGHT_ONE;
+        }
+    }
+}
+
+// Cek bias importance sampling: histogram seragam dan importance dengan jumlah
+// sampel yang sama harus sama dalam toleransi statistik. Dibandingkan per blok
+// kasar, karena per pixel noise Monte Carlo jauh lebih besar dari bias yang dicari.
+static int run_bias_check(const BuddhaParams* p, long long samples) {
+    size_t pixels = (size_t)p->width * p->height;
+    int blocks_x = (p->width + CHECK_BLOCK - 1) / CHECK_BLOCK;
+    int blocks_y = (p->height + CHECK_BLOCK - 1) / CHECK_BLOCK;
+    int blocks = blocks_x * blocks_y;
+    uint64_t* density = (uint64_t*)malloc(pixels * sizeof(uint64_t));
+    double* mass[2];
+    mass[0] = (double*)malloc(blocks * sizeof(double));
+    mass[1] = (double*)malloc(blocks * sizeof(double));
+    if (!density || !mass[0] || !mass[1]) {
+        printf("Error: Gagal mengalokasi memori\n");
+        free(density);
+        free(mass[0]);
+        free(mass[1]);
+        return 1;
+    }
+
+    printf("=== CEK BIAS IMPORTANCE SAMPLING ===\n");
+    printf("Sampel per run: %lld, blok %dx%d pixel\n", samples, CHECK_BLOCK, CHECK_BLOCK);
+
+    int ok = 1;
+    for (int m = 0; m < 2 && ok; m++) {
+        ImportanceMap map;
+        BuddhaStats stats;
+        ok = build_importance_map(&map, p, m) &&
+             render_buddhabrot(density, p, &map, samples, ACC_PER_THREAD,
+                               omp_get_max_threads(), 0, &stats);
+        free_importance_map(&map);
+        if (ok) block_mass(density, p, mass[m], blocks_x, blocks_y);
+    }
+    if (!ok) {
+        printf("Error: Gagal mengalokasi histogram\n");
+        free(density);
+        free(mass[0]);
+        free(mass[1]);
+        return 1;
+    }
+
+    // Blok sepi diukur relatif terhadap massa blok rata-rata, bukan massanya sendiri
+    double total[2] = {0.0, 0.0};
+    for (int i = 0; i < blocks; i++) {
+        total[0] += mass[0][i];
+        total[1] += mass[1][i];
+    }
+    double mean_block = total[0] / blocks;
+    double worst = 0.0;
+    for (int i = 0; i < blocks; i++) {
+        double scale = mass[0][i] > mean_block ? mass[0][i] : mean_block;
+        double err = fabs(mass[1][i] - mass[0][i]) / scale;
+        if (err > worst) worst = err;
+    }
+    double total_err = fabs(total[1] - total[0]) / total[0];
+
+    printf("Massa total: seragam %.0f, importance %.0f (selisih %.2f%%, batas %.0f%%)\n",
+           total[0], total[1], total_err * 100.0, CHECK_TOTAL_TOL * 100.0);
+    printf("Selisih blok terbesar: %.2f%% (batas %.0f%%)\n",
+           worst * 100.0, CHECK_BLOCK_TOL * 100.0);
+
+    int pass = total_err <= CHECK_TOTAL_TOL && worst <= CHECK_BLOCK_TOL;
+    if (pass) {
+        printf("✓ Verifikasi: Histogram importance sesuai histogram seragam\n");
+    } else {
+        printf("⚠ Peringatan: Histogram importance menyimpang dari histogram seragam\n");
+    }
+
+    free(density);
+    free(mass[0]);
+    free(mass[1]);
+    return pass ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+    // Parameter yang bisa diubah
+    BuddhaParams params;
+    params.width = 1920;
+    params.height = 1080;
+    params.max_iter = 1000;
+    params.min_iter = 20;
+
+    // Batas area kompleks yang akan digambar (sama dengan parallel.c)
+    params.min_real = -2.5;
+    params.max_real = 1.0;
+    params.min_imag = -1.0;
+    params.max_imag = 1.0;
+
+    long long samples = 20000000LL;
+    int bench = 0;
+    int check = 0;
+    int use_importance = 1;
+    AccumMode mode = ACC_PER_THREAD;
+
+    // Penggunaan: mandelbrot_buddhabrot [bench|check] [uniform] [shared|sharded|per-thread] [sampel]
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "bench") == 0) bench = 1;
+        else if (strcmp(argv[i], "check") == 0) check = 1;
+        else if (strcmp(argv[i], "uniform") == 0) use_importance = 0;
+        else if (strcmp(argv[i], "shared") == 0) mode = ACC_SHARED_ATOMIC;
+        else if (strcmp(argv[i], "sharded") == 0) mode = ACC_SHARDED_ATOMIC;
+        else if (strcmp(argv[i], "per-thread") == 0) mode = ACC_PER_THREAD;
+        else if (atoll(argv[i]) > 0) samples = atoll(argv[i]);
+        else {
+            printf("Argumen tidak dikenal: %s\n", argv[i]);
+            printf("Penggunaan: %s [bench|check] [uniform] [shared|sharded|per-thread] [sampel]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (bench && samples == 20000000LL) samples = 2000000LL;
+    if (check && samples == 20000000LL) samples = 8000000LL;
+    if (check) return run_bias_check(&params, samples);
+
+    printf("=== BUDDHABROT (DENSITAS ORBIT) ===\n");
+    printf("Resolusi: %dx%d pixels\n", params.width, params.height);
+    printf("Iterasi: %d..%d\n", params.min_iter, params.max_iter);
+    printf("Sampling: %s\n", use_importance ? "importance" : "seragam");
+    printf("Jumlah thread tersedia: %d\n", omp_get_max_threads());
+    printf("\n");
+
+    ImportanceMap map;
+    double start_map = omp_get_wtime();
+    if (!build_importance_map(&map, &params, use_importance)) {
+        printf("Error: Gagal mengalokasi memori\n");
+        free_importance_map(&map);
+        return 1;
+    }
+    if (use_importance) {
+        printf("Peta importance: %.3f detik, %.1f%% probe berguna\n",
+               omp_get_wtime() - start_map, map.useful_fraction * 100.0);
+    }
+
+    if (bench) {
+        int status = run_scaling_benchmark(&params, &map, samples);
+        free_importance_map(&map);
+        return status;
+    }
+
+    // Alokasi memori untuk histogram dan gambar
+    size_t pixels = (size_t)params.width * params.height;
+    uint64_t* density = (uint64_t*)malloc(pixels * sizeof(uint64_t));
+    RGB* image = (RGB*)malloc(pixels * sizeof(RGB));
+    if (!density || !image) {
+        printf("Error: Gagal mengalokasi memori\n");
+        free(density);
+        free(image);
+        free_importance_map(&map);
+        return 1;
+    }
+
+    printf("Menjalankan %lld sampel (%s)...\n", samples, accum_mode_name(mode));
+    BuddhaStats stats;
+    double start = omp_get_wtime();
+    int ok = render_buddhabrot(density, &params, &map, samples, mode,
+                               omp_get_max_threads(), 0, &stats);
+    double elapsed = omp_get_wtime() - start;
+
+    if (!ok) {
+        printf("Error: Gagal mengalokasi histogram\n");
+    } else {
+        printf("Waktu render: %.3f detik\n", elapsed);
+        printf("Sampel berguna: %.1f%%\n", 100.0 * stats.useful_samples / stats.samples);
+        printf("Titik orbit: %lld (%.2f M/detik)\n", stats.orbit_points,
+               stats.orbit_points / elapsed / 1e6);
+
+        colorize_density(image, density, params.width, params.height);
+        if (!save_bmp("buddhabrot.bmp", image, params.width, params.height)) {
+            printf("Error: Gagal menyimpan gambar\n");
+        } else {
+            printf("Gambar disimpan: buddhabrot.bmp\n");
+        }
+    }
+
+    // Bersihkan memori
+    free(density);
+    free(image);
+    free_importance_map(&map);
+
+    return ok ? 0 : 1;
+}
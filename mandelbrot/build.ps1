@@ -15,7 +15,7 @@ function Test-Command($command) {
 
 function Build-Serial {
     Write-Host "🔨 Compiling Serial version..." -ForegroundColor Yellow
-    gcc -O2 -o mandelbrot_serial.exe serial.c
+    gcc -fopenmp -O2 -o mandelbrot_serial.exe serial.c render.c perturb.c -lm
     if ($LASTEXITCODE -eq 0) {
         Write-Host "✅ Serial version compiled successfully!" -ForegroundColor Green
     } else {
@@ -25,7 +25,7 @@ function Build-Serial {
 
 function Build-Parallel {
     Write-Host "🔨 Compiling Parallel version..." -ForegroundColor Yellow
-    gcc -fopenmp -O2 -o mandelbrot_parallel.exe parallel.c
+    gcc -fopenmp -O2 -o mandelbrot_parallel.exe parallel.c render.c perturb.c -lm
     if ($LASTEXITCODE -eq 0) {
         Write-Host "✅ Parallel version compiled successfully!" -ForegroundColor Green
     } else {
@@ -33,6 +33,56 @@ function Build-Parallel {
     }
 }
 
+function Build-DeepZoom {
+    Write-Host "🔨 Compiling deep zoom renderer..." -ForegroundColor Yellow
+    gcc -fopenmp -O2 -o mandelbrot_deepzoom.exe deepzoom.c render.c perturb.c -lm
+    if ($LASTEXITCODE -eq 0) {
+        Write-Host "✅ Deep zoom renderer compiled successfully!" -ForegroundColor Green
+    } else {
+        Write-Host "❌ Failed to compile deep zoom renderer!" -ForegroundColor Red
+    }
+}
+
+function Build-Buddhabrot {
+    Write-Host "🔨 Compiling Buddhabrot version..." -ForegroundColor Yellow
+    gcc -fopenmp -O2 -o mandelbrot_buddhabrot.exe buddhabrot.c render.c perturb.c -lm
+    if ($LASTEXITCODE -eq 0) {
+        Write-Host "✅ Buddhabrot version compiled successfully!" -ForegroundColor Green
+    } else {
+        Write-Host "❌ Failed to compile Buddhabrot version!" -ForegroundColor Red
+    }
+}
+
+function Build-JuliaAtlas {
+    Write-Host "🔨 Compiling Julia atlas version..." -ForegroundColor Yellow
+    gcc -fopenmp -O2 -o mandelbrot_julia_atlas.exe julia_atlas.c render.c perturb.c -lm
+    if ($LASTEXITCODE -eq 0) {
+        Write-Host "✅ Julia atlas version compiled successfully!" -ForegroundColor Green
+    } else {
+        Write-Host "❌ Failed to compile Julia atlas version!" -ForegroundColor Red
+    }
+}
+
+function Build-Golden {
+    Write-Host "🔨 Compiling golden regression harness..." -ForegroundColor Yellow
+    gcc -fopenmp -O2 -o mandelbrot_golden.exe golden.c render.c perturb.c -lm
+    if ($LASTEXITCODE -eq 0) {
+        Write-Host "✅ Golden regression harness compiled successfully!" -ForegroundColor Green
+    } else {
+        Write-Host "❌ Failed to compile golden regression harness!" -ForegroundColor Red
+    }
+}
+
+function Build-ViewerReplay {
+    Write-Host "🔨 Compiling headless viewer replay..." -ForegroundColor Yellow
+    g++ -O2 -std=c++11 -o mandelbrot_viewer_replay.exe viewer_replay.cpp
+    if ($LASTEXITCODE -eq 0) {
+        Write-Host "✅ Viewer replay compiled successfully!" -ForegroundColor Green
+    } else {
+        Write-Host "❌ Failed to compile viewer replay!" -ForegroundColor Red
+    }
+}
+
 function Build-GUI {
     Write-Host "🔨 Compiling Windows GUI version..." -ForegroundColor Yellow
     g++ -O2 -std=c++11 -o fractal_gui.exe fractal_gui.cpp -lgdi32 -luser32
@@ -47,7 +97,7 @@ function Build-GPU {
     Write-Host "🔨 Compiling GPU version..." -ForegroundColor Yellow
     
     if (Test-Command "nvcc") {
-        nvcc -O2 -Xcompiler -fopenmp -o mandelbrot_gpu.exe gpu.c
+        nvcc -O2 -Xcompiler -fopenmp -o mandelbrot_gpu.exe -x cu gpu.c -x c render.c perturb.c
         if ($LASTEXITCODE -eq 0) {
             Write-Host "✅ GPU version compiled successfully!" -ForegroundColor Green
         } else {
@@ -76,6 +126,11 @@ function Test-All {
         Write-Host "`n=== Testing GPU Version ===" -ForegroundColor Blue
         .\mandelbrot_gpu.exe
     }
+    
+    if (Test-Path "mandelbrot_golden.exe") {
+        Write-Host "`n=== Golden Image Regression ===" -ForegroundColor Blue
+        .\mandelbrot_golden.exe
+    }
 }
 
 function Clean-Files {
@@ -95,6 +150,11 @@ if (-not (Test-Command "gcc")) {
 switch ($Target.ToLower()) {
     "serial" { Build-Serial }
     "parallel" { Build-Parallel }
+    "deepzoom" { Build-DeepZoom }
+    "buddhabrot" { Build-Buddhabrot }
+    "julia-atlas" { Build-JuliaAtlas }
+    "golden" { Build-Golden }
+    "viewer-replay" { Build-ViewerReplay }
     "gpu" { Build-GPU }
     "all" { 
         Build-Serial
@@ -112,6 +172,11 @@ switch ($Target.ToLower()) {
         Write-Host "Available targets:" -ForegroundColor Cyan
         Write-Host "  serial    - Compile serial version" -ForegroundColor White
         Write-Host "  parallel  - Compile parallel version" -ForegroundColor White
+        Write-Host "  deepzoom  - Compile deep zoom renderer (perturbation + BLA)" -ForegroundColor White
+        Write-Host "  buddhabrot - Compile Buddhabrot version" -ForegroundColor White
+        Write-Host "  julia-atlas - Compile Julia atlas version" -ForegroundColor White
+        Write-Host "  golden    - Compile golden regression harness" -ForegroundColor White
+        Write-Host "  viewer-replay - Compile headless viewer replay" -ForegroundColor White
         Write-Host "  gpu       - Compile GPU version (requires CUDA)" -ForegroundColor White
         Write-Host "  all       - Compile serial and parallel" -ForegroundColor White
         Write-Host "  gpu-all   - Compile all versions including GPU" -ForegroundColor White
@@ -0,0 +1,237 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <omp.h>
+#include "render.h"
+#include "perturb.h"
+
+// === Render deep zoom tanpa jendela ===
+// Front end untuk perturb.c: merender satu viewport dengan perturbasi + BLA
+// menjadi peta iterasi (format .iter sama dengan golden/) dan BMP. Dengan
+// --bench, render yang sama diulang dengan perturbasi biasa (setiap iterasi
+// dihitung) untuk speedup dan selisih peta, dan sejumlah pixel sampel
+// diiterasi langsung dalam presisi tinggi sebagai kebenaran dasar.
+
+// Lokasi benchmark zoom 1e100: nukleus minibrot periode 134 di dekat titik
+// Misiurewicz c = i (dicari dengan Newton). Ukurannya ~1e-100, jadi minibrot
+// mengisi viewport: pixel di dalamnya mencapai max iterasi, pixel di
+// sekitarnya lolos setelah ribuan sampai puluhan ribu iterasi.
+static const char* BENCH_CENTER_REAL =
+    "-0.0000000000000000000000000000000000000000000000000112263605692030713325095863041740445844550428679026974111245526";
+static const char* BENCH_CENTER_IMAG =
+    "1.0000000000000000000000000000000000000000000000000136136553681034744167115441300857011185344569487002406164388499";
+#define BENCH_ZOOM 1e100
+#define DEFAULT_SAMPLES 16
+
+// Format sama dengan golden/*.iter: header lalu uint32 per pixel. Viewport
+// di header hanya pendekatan double; pusat presisi penuh ada di command line.
+#define ITER_MAGIC "MBITER01"
+
+typedef struct {
+    char magic[8];
+    int32_t width, height;
+    int32_t max_iterations;
+    int32_t reserved;
+    double min_real, max_real, min_imag, max_imag;
+} IterHeader;
+
+static int save_iteration_map(const char* path, const DeepView* v, const uint32_t* map) {
+    FILE* file = fopen(path, "wb");
+    if (!file) return 0;
+    IterHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, ITER_MAGIC, sizeof(h.magic));
+    h.width = v->width;
+    h.height = v->height;
+    h.max_iterations = v->max_iterations;
+    double center_real = atof(v->center_real);
+    double center_imag = atof(v->center_imag);
+    h.min_real = center_real - v->span_real / 2.0;
+    h.max_real = center_real + v->span_real / 2.0;
+    h.min_imag = center_imag - v->span_imag / 2.0;
+    h.max_imag = center_imag + v->span_imag / 2.0;
+    size_t count = (size_t)v->width * v->height;
+    int ok = fwrite(&h, sizeof(h), 1, file) == 1 && fwrite(map, sizeof(uint32_t), count, file) == count;
+    return fclose(file) == 0 && ok;
+}
+
+static void print_stats(const char* label, const DeepStats* st, long pixels) {
+    printf("%s\n", label);
+    printf("  Waktu render:      %.3f detik (referensi %.3f, tabel %.3f)\n",
+           st->render_time, st->reference_time, st->table_time);
+    printf("  Iterasi/pixel:     %.0f rata-rata\n", (double)st->iterations / pixels);
+    printf("  Langkah/pixel:     %.1f (%.2f%% iterasi dilompati BLA)\n",
+           (double)st->steps / pixels, 100.0 * st->bla_skipped / (double)st->iterations);
+    printf("  Rebase:            %lld\n", st->rebases);
+}
+
+static void print_usage(const char* program) {
+    printf("Penggunaan: %s [--center real imag] [--zoom z] [--size lebar tinggi] [--iter n]\n"
+           "       [--no-bla] [--out peta.iter] [--bmp gambar.bmp] [--bench] [--samples n]\n"
+           "Koordinat pusat ditulis sebagai desimal penuh (tanpa eksponen);\n"
+           "tanpa --center dipakai lokasi benchmark zoom 1e100.\n", program);
+}
+
+int main(int argc, char** argv) {
+    const char* center_real = BENCH_CENTER_REAL;
+    const char* center_imag = BENCH_CENTER_IMAG;
+    double zoom = BENCH_ZOOM;
+    int width = 640;
+    int height = 360;
+    int max_iterations = 50000;
+    int use_bla = 1;
+    int bench = 0;
+    int samples = DEFAULT_SAMPLES;
+    const char* iter_path = NULL;
+    const char* bmp_path = "mandelbrot_deepzoom.bmp";
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--center") == 0 && i + 2 < argc) {
+            center_real = argv[++i];
+            center_imag = argv[++i];
+        } else if (strcmp(argv[i], "--zoom") == 0 && i + 1 < argc) {
+            zoom = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--size") == 0 && i + 2 < argc) {
+            width = atoi(argv[++i]);
+            height = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--iter") == 0 && i + 1 < argc) {
+            max_iterations = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--no-bla") == 0) {
+            use_bla = 0;
+        } else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            iter_path = argv[++i];
+        } else if (strcmp(argv[i], "--bmp") == 0 && i + 1 < argc) {
+            bmp_path = argv[++i];
+        } else if (strcmp(argv[i], "--bench") == 0) {
+            bench = 1;
+        } else if (strcmp(argv[i], "--samples") == 0 && i + 1 < argc) {
+            samples = atoi(argv[++i]);
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (width <= 0 || height <= 0 || max_iterations <= 0 || samples < 0 ||
+        !(zoom >= 1.0) || zoom > DEEP_MAX_ZOOM) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    if (!deep_valid_coordinate(center_real) || !deep_valid_coordinate(center_imag)) {
+        printf("Error: Koordinat pusat harus desimal biasa, mis. -0.743643887037158704752\n");
+        return 1;
+    }
+
+    // Rasio aspek mengikuti gambar, sama seperti scene di golden.c
+    DeepView view = {center_real, center_imag, 3.5 / zoom, 3.5 / zoom * height / width,
+                     width, height, max_iterations};
+    long pixels = (long)width * height;
+
+    printf("=== DEEP ZOOM (PERTURBASI + BLA) ===\n");
+    printf("Resolusi: %dx%d pixels\n", width, height);
+    printf("Zoom: %.3g, max iterasi: %d\n", zoom, max_iterations);
+    printf("Jumlah thread tersedia: %d\n", omp_get_max_threads());
+    printf("\n");
+
+    uint32_t* map = (uint32_t*)malloc(pixels * sizeof(uint32_t));
+    uint32_t* plain = bench ? (uint32_t*)malloc(pixels * sizeof(uint32_t)) : NULL;
+    RGB* image = (RGB*)malloc(pixels * sizeof(RGB));
+    if (!map || !image || (bench && !plain)) {
+        printf("Error: Gagal mengalokasi memori\n");
+        free(map);
+        free(plain);
+        free(image);
+        return 1;
+    }
+
+    int status = 1;
+    DeepStats st;
+    if (!render_deep(&view, use_bla, 0, map, &st)) {
+        printf("Error: Gagal merender (alokasi atau presisi di luar batas)\n");
+        goto cleanup;
+    }
+    printf("Orbit referensi: %d iterasi, presisi %d bit\n", st.reference_length, st.precision_bits);
+    if (use_bla) {
+        printf("Tabel BLA: %d level, %ld entri\n", st.bla_levels, st.bla_entries);
+    }
+    print_stats(use_bla ? "Perturbasi + BLA:" : "Perturbasi biasa:", &st, pixels);
+
+    colorize(image, map, (size_t)pixels, max_iterations);
+    if (!save_bmp(bmp_path, image, width, height)) {
+        printf("Error: Gagal menyimpan %s\n", bmp_path);
+        goto cleanup;
+    }
+    printf("Gambar disimpan: %s\n", bmp_path);
+    if (iter_path) {
+        if (!save_iteration_map(iter_path, &view, map)) {
+            printf("Error: Gagal menyimpan %s\n", iter_path);
+            goto cleanup;
+        }
+        printf("Peta iterasi disimpan: %s\n", iter_path);
+    }
+    status = 0;
+
+    if (bench) {
+        printf("\n");
+        DeepStats plain_st;
+        if (!render_deep(&view, !use_bla, 0, plain, &plain_st)) {
+            printf("Error: Gagal merender pembanding\n");
+            status = 1;
+            goto cleanup;
+        }
+        print_stats(use_bla ? "Perturbasi biasa:" : "Perturbasi + BLA:", &plain_st, pixels);
+        const DeepStats* with_bla = use_bla ? &st : &plain_st;
+        const DeepStats* without = use_bla ? &plain_st : &st;
+
+        long differ = 0, beyond = 0;
+        uint32_t max_diff = 0;
+        for (long i = 0; i < pixels; i++) {
+            uint32_t diff = map[i] > plain[i] ? map[i] - plain[i] : plain[i] - map[i];
+            if (diff) differ++;
+            if (diff > 2) beyond++;
+            if (diff > max_diff) max_diff = diff;
+        }
+
+        // Sampel tersebar merata; iterasi presisi tinggi jauh lebih lambat
+        int exact_bla = 0, exact_plain = 0;
+        double exact_time = omp_get_wtime();
+        for (int k = 0; k < samples; k++) {
+            int x = (int)((k + 0.5) * width / samples);
+            int y = (int)(((k * 7) % samples + 0.5) * height / samples);
+            int expected = deep_pixel_exact(&view, x, y);
+            long i = (long)y * width + x;
+            const uint32_t* bla_map = use_bla ? map : plain;
+            const uint32_t* plain_map = use_bla ? plain : map;
+            if (bla_map[i] == (uint32_t)expected) exact_bla++;
+            if (plain_map[i] == (uint32_t)expected) exact_plain++;
+        }
+        exact_time = omp_get_wtime() - exact_time;
+
+        printf("\n=== HASIL BENCHMARK BLA ===\n");
+        printf("Waktu perturbasi:  %.3f detik\n", without->render_time);
+        printf("Waktu BLA:         %.3f detik\n", with_bla->render_time);
+        printf("Speedup render:    %.2fx\n", without->render_time / with_bla->render_time);
+        printf("Langkah dihemat:   %.1fx lebih sedikit\n", (double)without->steps / with_bla->steps);
+        printf("Beda peta:         %ld pixel (%.4f%%), %ld lebih dari 2 iterasi, maks %u\n",
+               differ, 100.0 * differ / pixels, beyond, max_diff);
+        if (samples > 0) {
+            printf("Sampel presisi penuh: BLA %d/%d, perturbasi %d/%d cocok (%.2f detik)\n",
+                   exact_bla, samples, exact_plain, samples, exact_time);
+        }
+
+        // Toleransi sama dengan backend float-first di golden.c
+        if (beyond <= pixels / 200 && exact_bla >= exact_plain) {
+            printf("✓ Verifikasi: Peta BLA dalam toleransi terhadap perturbasi biasa\n");
+        } else {
+            printf("⚠ Peringatan: Peta BLA melewati toleransi terhadap perturbasi biasa\n");
+            status = 1;
+        }
+    }
+
+cleanup:
+    free(map);
+    free(plain);
+    free(image);
+    return status;
+}
@@ -0,0 +1,244 @@
+#ifndef FLOAT_FIRST_H
+#define FLOAT_FIRST_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <omp.h>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define FF_HAVE_AVX2 1
+#endif
+
+// === Render dua pass: float dulu, double hanya di pixel yang meragukan ===
+// Pada zoom sedang hampir semua pixel menghasilkan jumlah iterasi yang sama
+// dalam float dan double. Pass pertama menghitung seluruh frame dalam presisi
+// tunggal (AVX2, 8 pixel sekaligus bila tersedia) dan menandai pixel yang
+// hasil float-nya tidak bisa dipercaya:
+//   - |z|^2 saat lolos hanya sedikit di atas 4, sehingga galat pembulatan
+//     bisa menggeser iterasi lolos satu langkah;
+//   - jumlah iterasi berbeda jauh dari tetangga (dekat batas himpunan, di mana
+//     orbit sensitif terhadap galat), atau status dalam/luar himpunan berbeda.
+// Pass kedua menghitung ulang pixel bertanda dengan kernel double milik
+// pemanggil. Bila jarak antar pixel terlalu dekat dengan resolusi float,
+// seluruh frame langsung dihitung dalam double.
+
+#define FF_ESCAPE_MARGIN 0.01f       // |z|^2 < 4 * (1 + margin) saat lolos -> hitung ulang
+#define FF_NEIGHBOR_DIFF 1           // selisih iterasi tetangga di atas ini -> hitung ulang
+#define FF_MIN_ULPS_PER_PIXEL 256.0  // jarak pixel minimal, dalam ulp float koordinat
+
+#define FF_FLAG_ESCAPE 1
+#define FF_FLAG_REFINE 2
+
+typedef int (*FFDoubleKernel)(double real, double imag, int max_iter);
+
+typedef struct {
+    long pixels;
+    long refined;            // pixel yang dihitung ulang dalam double
+    int all_double;          // viewport terlalu dalam untuk float
+    const char* kernel;      // kernel pass float yang dipakai
+    double float_time;
+    double refine_time;
+} FloatFirstStats;
+
+// Kernel float skalar; juga menangani sisa baris yang tidak genap 8 pixel
+static int ff_iterations_float(float real, float imag, int max_iter, uint8_t* flag) {
+    float z_real = 0.0f;
+    float z_imag = 0.0f;
+    float mag = 0.0f;
+    int iter = 0;
+
+    while (iter < max_iter && (mag = z_real * z_real + z_imag * z_imag) < 4.0f) {
+        float temp = z_real * z_real - z_imag * z_imag + real;
+        z_imag = 2.0f * z_real * z_imag + imag;
+        z_real = temp;
+        iter++;
+    }
+    if (iter < max_iter) {
+        mag = z_real * z_real + z_imag * z_imag;
+        if (mag < 4.0f * (1.0f + FF_ESCAPE_MARGIN)) *flag = FF_FLAG_ESCAPE;
+    }
+    return iter;
+}
+
+static void ff_row_scalar(const float* re, float imag, int width, int max_iter,
+                          uint32_t* out, uint8_t* flags) {
+    for (int x = 0; x < width; x++) {
+        out[x] = (uint32_t)ff_iterations_float(re[x], imag, max_iter, &flags[x]);
+    }
+}
+
+#ifdef FF_HAVE_AVX2
+// 8 pixel per iterasi; lane yang sudah lolos dimatikan lewat mask, loop
+// berhenti begitu semua lane lolos
+__attribute__((target("avx2")))
+static void ff_row_avx2(const float* re, float imag, int width, int max_iter,
+                        uint32_t* out, uint8_t* flags) {
+    const __m256 four = _mm256_set1_ps(4.0f);
+    const __m256 near = _mm256_set1_ps(4.0f * (1.0f + FF_ESCAPE_MARGIN));
+    const __m256 ci = _mm256_set1_ps(imag);
+    int x = 0;
+
+    for (; x + 8 <= width; x += 8) {
+        __m256 cr = _mm256_loadu_ps(re + x);
+        __m256 zr = _mm256_setzero_ps();
+        __m256 zi = _mm256_setzero_ps();
+        __m256 active = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        __m256 escape_mag = _mm256_setzero_ps();
+        __m256i count = _mm256_setzero_si256();
+
+        for (int i = 0; i < max_iter; i++) {
+            __m256 zr2 = _mm256_mul_ps(zr, zr);
+            __m256 zi2 = _mm256_mul_ps(zi, zi);
+            __m256 mag = _mm256_add_ps(zr2, zi2);
+            __m256 inside = _mm256_cmp_ps(mag, four, _CMP_LT_OQ);
+            __m256 escaped_now = _mm256_andnot_ps(inside, active);
+            escape_mag = _mm256_blendv_ps(escape_mag, mag, escaped_now);
+            active = _mm256_and_ps(active, inside);
+            if (_mm256_testz_ps(active, active)) break;
+            count = _mm256_sub_epi32(count, _mm256_castps_si256(active));
+
+            __m256 zrzi = _mm256_mul_ps(zr, zi);
+            zi = _mm256_add_ps(_mm256_add_ps(zrzi, zrzi), ci);
+            zr = _mm256_add_ps(_mm256_sub_ps(zr2, zi2), cr);
+        }
+
+        _mm256_storeu_si256((__m256i*)(out + x), count);
+        // Lane yang masih aktif tidak lolos; escape_mag-nya 0 dan tidak ditandai
+        int near_mask = _mm256_movemask_ps(_mm256_and_ps(
+            _mm256_cmp_ps(escape_mag, near, _CMP_LT_OQ),
+            _mm256_cmp_ps(escape_mag, four, _CMP_GE_OQ)));
+        for (int k = 0; k < 8; k++) {
+            flags[x + k] = (near_mask >> k) & 1 ? FF_FLAG_ESCAPE : 0;
+        }
+    }
+    ff_row_scalar(re + x, imag, width - x, max_iter, out + x, flags + x);
+}
+
+static int ff_avx2_available(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+#endif
+
+// Float sah bila jarak antar pixel jauh di atas ulp koordinat terbesar
+static int ff_float_sufficient(int width, int height, double min_real, double max_real,
+                               double min_imag, double max_imag) {
+    double step = fmin((max_real - min_real) / width, (max_imag - min_imag) / height);
+    double extent = fmax(fmax(fabs(min_real), fabs(max_real)), fmax(fabs(min_imag), fabs(max_imag)));
+    return step >= FF_MIN_ULPS_PER_PIXEL * FLT_EPSILON * fmax(extent, 1.0);
+}
+
+static int ff_needs_refine(const uint32_t* out, int width, int height, int max_iter, int x, int y) {
+    uint32_t self = out[y * width + x];
+    int self_inside = self == (uint32_t)max_iter;
+    static const int dx[4] = {-1, 1, 0, 0};
+    static const int dy[4] = {0, 0, -1, 1};
+
+    for (int k = 0; k < 4; k++) {
+        int nx = x + dx[k];
+        int ny = y + dy[k];
+        if (nx < 0 || nx >= width || ny < 0 || ny >= height) continue;
+        uint32_t other = out[ny * width + nx];
+        if ((other == (uint32_t)max_iter) != self_inside) return 1;
+        uint32_t diff = other > self ? other - self : self - other;
+        if (diff > FF_NEIGHBOR_DIFF) return 1;
+    }
+    return 0;
+}
+
+// Peta iterasi (uint32 per pixel) dengan koordinat yang sama seperti
+// render_mandelbrot_parallel(); refine adalah kernel double referensi.
+// Mengembalikan 0 bila alokasi gagal.
+static int render_float_first(uint32_t* out, int width, int height, int max_iterations,
+                              double min_real, double max_real, double min_imag, double max_imag,
+                              FFDoubleKernel refine, FloatFirstStats* stats) {
+    double real_scale = (max_real - min_real) / width;
+    double imag_scale = (max_imag - min_imag) / height;
+    long pixels = (long)width * height;
+
+    memset(stats, 0, sizeof(*stats));
+    stats->pixels = pixels;
+    stats->kernel = "double";
+
+    if (!ff_float_sufficient(width, height, min_real, max_real, min_imag, max_imag)) {
+        double start = omp_get_wtime();
+        #pragma omp parallel for schedule(dynamic, 1)
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                out[(long)y * width + x] = (uint32_t)refine(min_real + x * real_scale,
+                                                            min_imag + y * imag_scale, max_iterations);
+            }
+        }
+        stats->all_double = 1;
+        stats->refined = pixels;
+        stats->refine_time = omp_get_wtime() - start;
+        return 1;
+    }
+
+    float* re = (float*)malloc(width * sizeof(float));
+    uint8_t* flags = (uint8_t*)calloc(pixels, 1);
+    if (!re || !flags) {
+        free(re);
+        free(flags);
+        return 0;
+    }
+    for (int x = 0; x < width; x++) {
+        re[x] = (float)(min_real + x * real_scale);
+    }
+
+    void (*row)(const float*, float, int, int, uint32_t*, uint8_t*) = ff_row_scalar;
+    stats->kernel = "float";
+#ifdef FF_HAVE_AVX2
+    if (ff_avx2_available()) {
+        row = ff_row_avx2;
+        stats->kernel = "float AVX2";
+    }
+#endif
+
+    // Pass 1: seluruh frame dalam float
+    double start = omp_get_wtime();
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int y = 0; y < height; y++) {
+        row(re, (float)(min_imag + y * imag_scale), width, max_iterations,
+            out + (long)y * width, flags + (long)y * width);
+    }
+    stats->float_time = omp_get_wtime() - start;
+
+    // Tandai dulu berdasarkan peta float yang utuh, baru hitung ulang,
+    // supaya pemeriksaan tetangga tidak melihat nilai yang sudah diperbaiki
+    start = omp_get_wtime();
+    long refined = 0;
+    #pragma omp parallel for schedule(dynamic, 1) reduction(+:refined)
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            uint8_t* flag = &flags[(long)y * width + x];
+            if (*flag || ff_needs_refine(out, width, height, max_iterations, x, y)) {
+                *flag |= FF_FLAG_REFINE;
+                refined++;
+            }
+        }
+    }
+
+    // Pass 2: pixel bertanda dalam double
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            long i = (long)y * width + x;
+            if (flags[i] & FF_FLAG_REFINE) {
+                out[i] = (uint32_t)refine(min_real + x * real_scale, min_imag + y * imag_scale,
+                                          max_iterations);
+            }
+        }
+    }
+    stats->refine_time = omp_get_wtime() - start;
+    stats->refined = refined;
+
+    free(re);
+    free(flags);
+    return 1;
+}
+
+#endif
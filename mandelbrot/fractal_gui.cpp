@@ -1,9 +1,6 @@
 #include <iostream>
-#include <vector>
-#include <complex>
-#include <thread>
-#include <chrono>
-#include <atomic>
+#include <string>
+#include "viewer_core.h"
 
 // Simple CPU-only version without external dependencies
 // Uses Windows API for basic window and graphics
@@ -12,202 +9,53 @@
 #include <windows.h>
 #include <wingdi.h>
 
-class SimpleFractalViewer {
+class SimpleFractalViewer : public FractalViewerCore {
 private:
     HWND hwnd;
     HDC hdc;
     HBITMAP hBitmap;
     void* bitmapData;
     
-    int width, height;
-    int max_iterations;
-    double zoom;
-    double center_real, center_imag;
-    bool is_julia;
-    std::complex<double> julia_c;
-    
-    std::atomic<bool> is_rendering;
     bool is_dragging, is_selecting;
     POINT drag_start, selection_start, selection_end;
-    
-    std::vector<COLORREF> pixels;
+    uint64_t shown_frame_id;
     
 public:
     SimpleFractalViewer(int w, int h) 
-        : width(w), height(h), max_iterations(100), zoom(1.0),
-          center_real(-0.5), center_imag(0.0), is_julia(false),
-          julia_c(0.3, 0.5), is_rendering(false), is_dragging(false), is_selecting(false) {
-        
-        pixels.resize(width * height);
-    }
-    
-    // Mandelbrot calculation
-    int mandelbrot_iterations(std::complex<double> c) {
-        std::complex<double> z(0, 0);
-        int iter = 0;
-        
-        while (iter < max_iterations && std::abs(z) < 2.0) {
-            z = z * z + c;
-            iter++;
-        }
-        
-        return iter;
-    }
-    
-    // Julia calculation
-    int julia_iterations(std::complex<double> z) {
-        int iter = 0;
-        
-        while (iter < max_iterations && std::abs(z) < 2.0) {
-            z = z * z + julia_c;
-            iter++;
-        }
-        
-        return iter;
+        : FractalViewerCore(w, h), hwnd(NULL), is_dragging(false), is_selecting(false), shown_frame_id(0) {
     }
     
-    // Convert iterations to color
-    COLORREF get_color(int iterations) {
-        if (iterations == max_iterations) {
-            return RGB(0, 0, 0); // Black
-        }
-        
-        double ratio = static_cast<double>(iterations) / max_iterations;
-        
-        int r, g, b;
-        
-        if (ratio < 0.16) {
-            r = static_cast<int>(255 * ratio * 6);
-            g = 0;
-            b = static_cast<int>(255 * (1 - ratio * 6));
-        } else if (ratio < 0.33) {
-            double r_ratio = (ratio - 0.16) * 6;
-            r = 255;
-            g = static_cast<int>(255 * r_ratio);
-            b = 0;
-        } else if (ratio < 0.5) {
-            double r_ratio = (ratio - 0.33) * 6;
-            r = 255;
-            g = 255;
-            b = static_cast<int>(255 * r_ratio);
-        } else if (ratio < 0.66) {
-            double r_ratio = (ratio - 0.5) * 6;
-            r = static_cast<int>(255 * (1 - r_ratio));
-            g = 255;
-            b = 255;
-        } else if (ratio < 0.83) {
-            double r_ratio = (ratio - 0.66) * 6;
-            r = 0;
-            g = static_cast<int>(255 * (1 - r_ratio));
-            b = 255;
-        } else {
-            double r_ratio = (ratio - 0.83) * 6;
-            r = static_cast<int>(255 * r_ratio);
-            g = 0;
-            b = 255;
-        }
-        
-        return RGB(r, g, b);
+    ~SimpleFractalViewer() {
+        stop_renderer();
     }
     
-    // Convert screen coordinates to complex plane
-    std::complex<double> screen_to_complex(int x, int y) {
-        double scale = 4.0 / zoom;
-        double real = center_real + (x - width / 2.0) * scale / width;
-        double imag = center_imag + (y - height / 2.0) * scale / height;
-        return std::complex<double>(real, imag);
+protected:
+    // Called on the render thread: just ask the UI thread to repaint, it
+    // picks the frame up from the triple buffer in WM_PAINT
+    void frame_rendered(const Frame&) override {
+        InvalidateRect(hwnd, NULL, FALSE);
     }
     
-    // Render fractal
-    void render_fractal() {
-        if (is_rendering.load()) return;
-        is_rendering = true;
-        
-        auto start_time = std::chrono::high_resolution_clock::now();
-        
-        // Multi-threaded rendering
-        int num_threads = std::thread::hardware_concurrency();
-        std::vector<std::thread> threads;
-        int rows_per_thread = height / num_threads;
-        
-        for (int t = 0; t < num_threads; t++) {
-            int start_row = t * rows_per_thread;
-            int end_row = (t == num_threads - 1) ? height : start_row + rows_per_thread;
-            
-            threads.emplace_back([this, start_row, end_row]() {
-                for (int y = start_row; y < end_row; y++) {
-                    for (int x = 0; x < width; x++) {
-                        std::complex<double> point = screen_to_complex(x, y);
-                        
-                        int iterations;
-                        if (is_julia) {
-                            iterations = julia_iterations(point);
-                        } else {
-                            iterations = mandelbrot_iterations(point);
-                        }
-                        
-                        pixels[y * width + x] = get_color(iterations);
-                    }
-                }
-            });
-        }
-        
-        for (auto& thread : threads) {
-            thread.join();
-        }
-        
-        auto end_time = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+    // Frame stats in the title, once per new frame
+    void update_title(const Frame& frame) {
+        if (frame.id == shown_frame_id) return;
+        shown_frame_id = frame.id;
+        frame_presented(frame);
         
+        const ViewState& v = frame.view;
         std::string title = "Interactive Fractal Explorer - ";
-        title += is_julia ? "Julia Set" : "Mandelbrot Set";
-        title += " - " + std::to_string(duration.count()) + "ms";
-        title += " - Zoom: " + std::to_string((int)zoom) + "x";
-        title += " - Iterations: " + std::to_string(max_iterations);
+        title += v.is_julia ? "Julia Set" : "Mandelbrot Set";
+        title += " - " + std::to_string(static_cast<int>(frame.frame_ms)) + "ms";
+        title += " - Zoom: " + std::to_string((int)v.zoom) + "x";
+        title += " - Iterations: " + std::to_string(v.max_iterations);
+        if (v.auto_iterations) title += " (auto)";
+        title += " - Tail: " + std::to_string(static_cast<int>(frame.tail_ms)) + "ms";
+        title += v.lpt_scheduling ? " (LPT)" : " (rows)";
         
         SetWindowTextA(hwnd, title.c_str());
-        InvalidateRect(hwnd, NULL, FALSE);
-        
-        is_rendering = false;
-    }
-    
-    // Zoom to selected area
-    void zoom_to_area(POINT start, POINT end) {
-        POINT center_pixel = {(start.x + end.x) / 2, (start.y + end.y) / 2};
-        std::complex<double> new_center = screen_to_complex(center_pixel.x, center_pixel.y);
-        
-        int selection_width = abs(end.x - start.x);
-        int selection_height = abs(end.y - start.y);
-        
-        if (selection_width > 10 && selection_height > 10) {
-            double zoom_factor = static_cast<double>(width) / selection_width;
-            zoom *= zoom_factor;
-            center_real = new_center.real();
-            center_imag = new_center.imag();
-            
-            render_fractal();
-        }
-    }
-    
-    // Pan view
-    void pan(POINT delta) {
-        double scale = 4.0 / zoom;
-        center_real -= delta.x * scale / width;
-        center_imag -= delta.y * scale / height;
-        render_fractal();
-    }
-    
-    // Update Julia constant
-    void update_julia_constant(POINT mouse_pos) {
-        if (is_julia) {
-            std::complex<double> new_c = screen_to_complex(mouse_pos.x, mouse_pos.y);
-            double real_part = std::max(-2.0, std::min(2.0, new_c.real()));
-            double imag_part = std::max(-2.0, std::min(2.0, new_c.imag()));
-            julia_c = std::complex<double>(real_part, imag_part);
-            render_fractal();
-        }
     }
     
+public:
     // Window procedure
     static LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam) {
         SimpleFractalViewer* viewer = reinterpret_cast<SimpleFractalViewer*>(GetWindowLongPtr(hwnd, GWLP_USERDATA));
@@ -222,6 +70,10 @@ public:
                 PAINTSTRUCT ps;
                 HDC hdc = BeginPaint(hwnd, &ps);
                 
+                // Newest complete frame; the renderer keeps working on another buffer
+                const Frame& frame = viewer->latest_frame();
+                viewer->update_title(frame);
+                
                 // Create bitmap and draw pixels
                 BITMAPINFO bmi = {};
                 bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
@@ -232,7 +84,7 @@ public:
                 bmi.bmiHeader.biCompression = BI_RGB;
                 
                 SetDIBitsToDevice(hdc, 0, 0, viewer->width, viewer->height,
-                                0, 0, 0, viewer->height, viewer->pixels.data(),
+                                0, 0, 0, viewer->height, frame.pixels.data(),
                                 &bmi, DIB_RGB_COLORS);
                 
                 // Draw selection rectangle if selecting
@@ -265,13 +117,15 @@ public:
                 instructions += "M: Toggle Mandelbrot/Julia\n";
                 instructions += "R: Reset view\n";
                 instructions += "+/-: Iterations\n";
+                instructions += "A: Auto iterations\n";
+                instructions += "T: LPT tile scheduling\n";
                 instructions += "Mouse: Julia constant";
                 
-                RECT textRect = {10, 10, 300, 150};
+                RECT textRect = {10, 10, 300, 190};
                 DrawTextA(hdc, instructions.c_str(), -1, &textRect, DT_LEFT | DT_TOP);
                 
                 // Show current mode
-                std::string mode = viewer->is_julia ? "Julia Set Mode" : "Mandelbrot Set Mode";
+                std::string mode = frame.view.is_julia ? "Julia Set Mode" : "Mandelbrot Set Mode";
                 RECT modeRect = {10, viewer->height - 30, 300, viewer->height};
                 DrawTextA(hdc, mode.c_str(), -1, &modeRect, DT_LEFT | DT_TOP);
                 
@@ -295,7 +149,8 @@ public:
                 if (viewer && viewer->is_selecting) {
                     viewer->is_selecting = false;
                     viewer->selection_end = {LOWORD(lParam), HIWORD(lParam)};
-                    viewer->zoom_to_area(viewer->selection_start, viewer->selection_end);
+                    viewer->zoom_to_area(viewer->selection_start.x, viewer->selection_start.y,
+                                         viewer->selection_end.x, viewer->selection_end.y);
                     ReleaseCapture();
                 }
                 return 0;
@@ -325,10 +180,10 @@ public:
                     InvalidateRect(hwnd, NULL, FALSE);
                 } else if (viewer->is_dragging) {
                     POINT delta = {viewer->drag_start.x - mouse_pos.x, viewer->drag_start.y - mouse_pos.y};
-                    viewer->pan(delta);
+                    viewer->pan(delta.x, delta.y);
                     viewer->drag_start = mouse_pos;
-                } else if (viewer->is_julia && !viewer->is_rendering.load()) {
-                    viewer->update_julia_constant(mouse_pos);
+                } else if (viewer->view.is_julia) {
+                    viewer->update_julia_constant(mouse_pos.x, mouse_pos.y);
                 }
                 return 0;
             }
@@ -342,28 +197,29 @@ public:
                         break;
                         
                     case 'M':
-                        viewer->is_julia = !viewer->is_julia;
-                        viewer->render_fractal();
+                        viewer->toggle_julia();
                         break;
                         
                     case 'R':
-                        viewer->zoom = 1.0;
-                        viewer->center_real = viewer->is_julia ? 0.0 : -0.5;
-                        viewer->center_imag = 0.0;
-                        viewer->max_iterations = 100;
-                        viewer->render_fractal();
+                        viewer->reset_view();
+                        break;
+                        
+                    case 'T':
+                        viewer->toggle_lpt_scheduling();
+                        break;
+                        
+                    case 'A':
+                        viewer->toggle_auto_iterations();
                         break;
                         
                     case VK_OEM_PLUS:
                     case VK_ADD:
-                        viewer->max_iterations = std::min(1000, viewer->max_iterations + 50);
-                        viewer->render_fractal();
+                        viewer->increase_iterations();
                         break;
                         
                     case VK_OEM_MINUS:
                     case VK_SUBTRACT:
-                        viewer->max_iterations = std::max(50, viewer->max_iterations - 50);
-                        viewer->render_fractal();
+                        viewer->decrease_iterations();
                         break;
                 }
                 return 0;
@@ -408,8 +264,16 @@ public:
         ShowWindow(hwnd, SW_SHOWDEFAULT);
         UpdateWindow(hwnd);
         
-        // Initial render
-        render_fractal();
+        // Metrics dump (Prometheus text) every second while the window is open
+        const char* metrics_path = std::getenv("MANDELBROT_METRICS_FILE");
+        MetricsFileExporter metrics_file(metrics_registry(), metrics_path ? metrics_path : "", 1.0);
+        if (metrics_path && !metrics_file.start()) {
+            std::cerr << "Cannot write metrics to " << metrics_path << std::endl;
+        }
+        
+        // Initial frame
+        start_renderer();
+        request_render();
         
         // Message loop
         MSG msg = {};
@@ -433,5 +297,5 @@ int main() {
 }
 
 #else
-#error "This version is for Windows only. Use fractal_gui.cpp for cross-platform SFML version or fractal_sdl.cpp for SDL version."
+#error "This version is for Windows only. Use viewer_replay.cpp for the headless Linux build of the viewer core."
 #endif
@@ -0,0 +1,434 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <omp.h>
+#include "render.h"
+
+// === Harness regresi golden image ===
+// Setiap backend merender sekumpulan scene tetap menjadi peta iterasi, lalu
+// dibandingkan dengan peta referensi yang disimpan di golden/. Kernel cepat
+// (FMA, float, SIMD) sah berbeda di beberapa pixel batas, jadi perbandingan
+// memakai toleransi per pixel (selisih iterasi) dan toleransi agregat (fraksi
+// pixel yang melewati toleransi per pixel). Selisih ditulis sebagai heatmap BMP.
+
+// === Scene ===
+typedef struct {
+    const char* name;
+    int width, height;
+    int max_iterations;
+    double center_real, center_imag;
+    double zoom;              // relatif terhadap area default (lebar 3.5)
+} Scene;
+
+static const Scene scenes[] = {
+    {"overview",  160,  90, 1000, -0.75,      0.0,       1.0},
+    {"seahorse",  160,  90, 1500, -0.745,     0.113,     40.0},
+    {"elephant",  160,  90, 1500,  0.2925,    0.0165,    150.0},
+    {"spiral",    160,  90, 3000, -0.7436439, 0.1318259, 2e4},
+};
+#define SCENE_COUNT ((int)(sizeof(scenes) / sizeof(scenes[0])))
+
+static void scene_bounds(const Scene* s, double* min_real, double* max_real,
+                         double* min_imag, double* max_imag) {
+    // Rasio aspek mengikuti gambar, sama seperti --view di parallel.c
+    double half_real = 3.5 / (2.0 * s->zoom);
+    double half_imag = half_real * s->height / s->width;
+    *min_real = s->center_real - half_real;
+    *max_real = s->center_real + half_real;
+    *min_imag = s->center_imag - half_imag;
+    *max_imag = s->center_imag + half_imag;
+}
+
+// === Backend ===
+// Backend library (render.c) dirender lewat render_iterations(), persis kode
+// yang dipakai serial.c / parallel.c. Varian yang hanya ada untuk pengujian
+// toleransi (FMA, float murni) tetap kernel lokal di bawah.
+// Backend baru cukup ditambahkan ke tabel backends[] di bawah.
+#if defined(__x86_64__) || defined(__i386__)
+// Kernel FMA: GCC menggabungkan a*b+c menjadi satu instruksi berpembulatan
+// tunggal, sehingga orbit menyimpang sedikit dari referensi di pixel batas
+__attribute__((target("fma")))
+static int mandelbrot_iterations_fma(double real, double imag, int max_iter) {
+    double z_real = 0.0;
+    double z_imag = 0.0;
+    int iter = 0;
+
+    while (iter < max_iter && (z_real * z_real + z_imag * z_imag) < 4.0) {
+        double temp = z_real * z_real - z_imag * z_imag + real;
+        z_imag = 2.0 * z_real * z_imag + imag;
+        z_real = temp;
+        iter++;
+    }
+
+    return iter;
+}
+
+__attribute__((target("fma")))
+static void render_fma(uint32_t* out, int width, int height, int max_iterations,
+                       double min_real, double max_real, double min_imag, double max_imag) {
+    double real_scale = (max_real - min_real) / width;
+    double imag_scale = (max_imag - min_imag) / height;
+
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            double real = min_real + x * real_scale;
+            double imag = min_imag + y * imag_scale;
+            out[y * width + x] = (uint32_t)mandelbrot_iterations_fma(real, imag, max_iterations);
+        }
+    }
+}
+
+static int fma_available(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("fma");
+}
+#else
+static void render_fma(uint32_t* out, int width, int height, int max_iterations,
+                       double min_real, double max_real, double min_imag, double max_imag) {
+    (void)out; (void)width; (void)height; (void)max_iterations;
+    (void)min_real; (void)max_real; (void)min_imag; (void)max_imag;
+}
+
+static int fma_available(void) {
+    return 0;
+}
+#endif
+
+// Kernel presisi tunggal: cepat, tetapi hanya sah sampai zoom dangkal
+static int mandelbrot_iterations_float(float real, float imag, int max_iter) {
+    float z_real = 0.0f;
+    float z_imag = 0.0f;
+    int iter = 0;
+
+    while (iter < max_iter && (z_real * z_real + z_imag * z_imag) < 4.0f) {
+        float temp = z_real * z_real - z_imag * z_imag + real;
+        z_imag = 2.0f * z_real * z_imag + imag;
+        z_real = temp;
+        iter++;
+    }
+
+    return iter;
+}
+
+static void render_float(uint32_t* out, int width, int height, int max_iterations,
+                         double min_real, double max_real, double min_imag, double max_imag) {
+    double real_scale = (max_real - min_real) / width;
+    double imag_scale = (max_imag - min_imag) / height;
+
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            float real = (float)(min_real + x * real_scale);
+            float imag = (float)(min_imag + y * imag_scale);
+            out[y * width + x] = (uint32_t)mandelbrot_iterations_float(real, imag, max_iterations);
+        }
+    }
+}
+
+static int always_available(void) {
+    return 1;
+}
+
+typedef void (*RenderFn)(uint32_t* out, int width, int height, int max_iterations,
+                         double min_real, double max_real, double min_imag, double max_imag);
+
+typedef struct {
+    const char* name;
+    const char* library;      // nama backend di render.c, NULL = kernel lokal
+    RenderFn render;          // kernel lokal
+    int (*available)(void);
+    int pixel_tolerance;      // selisih iterasi yang diizinkan per pixel
+    double max_bad_fraction;  // fraksi pixel yang boleh melewati pixel_tolerance
+    double max_zoom;          // scene lebih dalam dari ini dilewati (0 = tanpa batas)
+} Backend;
+
+static const Backend backends[] = {
+    {"serial",      "scalar",      NULL,         always_available, 0, 0.0,   0.0},
+    {"parallel",    "openmp",      NULL,         always_available, 0, 0.0,   0.0},
+    {"simd-avx2",   "simd-avx2",   NULL,         always_available, 0, 0.0,   0.0},
+    {"simd-avx512", "simd-avx512", NULL,         always_available, 0, 0.0,   0.0},
+    {"float-first", "float-first", NULL,         always_available, 2, 0.005, 0.0},
+    {"bla",         "bla",         NULL,         always_available, 2, 0.005, 0.0},
+    {"fma",         NULL,          render_fma,   fma_available,    2, 0.005, 0.0},
+    {"float",       NULL,          render_float, always_available, 2, 0.02,  10.0},
+};
+#define BACKEND_COUNT ((int)(sizeof(backends) / sizeof(backends[0])))
+
+static int backend_available(const Backend* be) {
+    if (be->library) {
+        const RenderBackend* lib = find_render_backend(be->library);
+        return lib && lib->available();
+    }
+    return be->available();
+}
+
+// Tile 64 untuk backend library paralel agar jalur tile ikut teruji
+static int backend_render(const Backend* be, uint32_t* out, const Scene* sc,
+                          double min_real, double max_real, double min_imag, double max_imag) {
+    if (be->library) {
+        RenderParams params = {sc->width, sc->height, sc->max_iterations, min_real, max_real, min_imag, max_imag};
+        RenderConfig cfg = {find_render_backend(be->library), 64, 0};
+        return render_iterations(&cfg, &params, out);
+    }
+    be->render(out, sc->width, sc->height, sc->max_iterations, min_real, max_real, min_imag, max_imag);
+    return 1;
+}
+
+// === File golden ===
+// Format: header (magic, ukuran, iterasi, viewport) lalu uint32 per pixel
+#define GOLDEN_MAGIC "MBITER01"
+
+typedef struct {
+    char magic[8];
+    int32_t width, height;
+    int32_t max_iterations;
+    int32_t reserved;
+    double min_real, max_real, min_imag, max_imag;
+} GoldenHeader;
+
+static void golden_header(const Scene* s, GoldenHeader* h) {
+    memset(h, 0, sizeof(*h));
+    memcpy(h->magic, GOLDEN_MAGIC, sizeof(h->magic));
+    h->width = s->width;
+    h->height = s->height;
+    h->max_iterations = s->max_iterations;
+    scene_bounds(s, &h->min_real, &h->max_real, &h->min_imag, &h->max_imag);
+}
+
+static int save_golden(const char* path, const Scene* s, const uint32_t* map) {
+    FILE* file = fopen(path, "wb");
+    if (!file) return 0;
+    GoldenHeader h;
+    golden_header(s, &h);
+    size_t count = (size_t)s->width * s->height;
+    int ok = fwrite(&h, sizeof(h), 1, file) == 1 && fwrite(map, sizeof(uint32_t), count, file) == count;
+    return fclose(file) == 0 && ok;
+}
+
+// 1 = berhasil, 0 = file tidak ada, -1 = rusak atau parameter scene berubah
+static int load_golden(const char* path, const Scene* s, uint32_t* map) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return 0;
+    GoldenHeader expected, h;
+    golden_header(s, &expected);
+    size_t count = (size_t)s->width * s->height;
+    int ok = fread(&h, sizeof(h), 1, file) == 1 && memcmp(&h, &expected, sizeof(h)) == 0 &&
+             fread(map, sizeof(uint32_t), count, file) == count;
+    fclose(file);
+    return ok ? 1 : -1;
+}
+
+// === Perbandingan ===
+typedef struct {
+    long bad_pixels;          // pixel dengan selisih > toleransi per pixel
+    long diff_pixels;         // pixel dengan selisih apa pun
+    long class_flips;         // interior <-> lolos
+    uint32_t max_diff;
+    double mean_diff;
+} DiffStats;
+
+static void compare_maps(const uint32_t* ref, const uint32_t* got, size_t count, int max_iterations,
+                         int pixel_tolerance, DiffStats* st) {
+    memset(st, 0, sizeof(*st));
+    double total = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        uint32_t d = ref[i] > got[i] ? ref[i] - got[i] : got[i] - ref[i];
+        if (d == 0) continue;
+        st->diff_pixels++;
+        total += d;
+        if (d > st->max_diff) st->max_diff = d;
+        if (d > (uint32_t)pixel_tolerance) st->bad_pixels++;
+        if ((ref[i] == (uint32_t)max_iterations) != (got[i] == (uint32_t)max_iterations)) st->class_flips++;
+    }
+    st->mean_diff = count ? total / count : 0.0;
+}
+
+// Heatmap: referensi sebagai latar abu-abu gelap, pixel berbeda diberi warna
+// kuning (dalam toleransi) sampai merah terang (selisih besar, skala log)
+static int save_heatmap(const char* path, const uint32_t* ref, const uint32_t* got, int width, int height,
+                        int max_iterations, int pixel_tolerance) {
+    RGB* image = (RGB*)malloc((size_t)width * height * sizeof(RGB));
+    if (!image) return 0;
+    double log_max = log1p((double)max_iterations);
+    for (int i = 0; i < width * height; i++) {
+        uint32_t d = ref[i] > got[i] ? ref[i] - got[i] : got[i] - ref[i];
+        RGB c;
+        if (d == 0) {
+            uint8_t v = (uint8_t)(60.0 * log1p((double)ref[i]) / log_max);
+            c.r = c.g = c.b = v;
+        } else if (d <= (uint32_t)pixel_tolerance) {
+            c.r = 255; c.g = 220; c.b = 0;
+        } else {
+            double t = log1p((double)d) / log_max;
+            if (t > 1.0) t = 1.0;
+            c.r = (uint8_t)(160 + 95 * t);
+            c.g = 0;
+            c.b = (uint8_t)(80 * (1.0 - t));
+        }
+        image[i] = c;
+    }
+    int ok = save_bmp(path, image, width, height);
+    free(image);
+    return ok;
+}
+
+static void print_usage(const char* program) {
+    printf("Penggunaan: %s [--update] [--backend nama] [--pixel-tol n] [--max-bad frac]\n"
+           "       [--golden-dir dir] [--heatmap-all]\n", program);
+    printf("Backend:");
+    for (int b = 0; b < BACKEND_COUNT; b++) printf(" %s", backends[b].name);
+    printf("\n");
+}
+
+int main(int argc, char** argv) {
+    const char* golden_dir = "golden";
+    const char* only_backend = NULL;
+    int update = 0;
+    int heatmap_all = 0;
+    int pixel_tol_override = -1;
+    double max_bad_override = -1.0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--update") == 0) {
+            update = 1;
+        } else if (strcmp(argv[i], "--heatmap-all") == 0) {
+            heatmap_all = 1;
+        } else if (strcmp(argv[i], "--backend") == 0 && i + 1 < argc) {
+            only_backend = argv[++i];
+        } else if (strcmp(argv[i], "--golden-dir") == 0 && i + 1 < argc) {
+            golden_dir = argv[++i];
+        } else if (strcmp(argv[i], "--pixel-tol") == 0 && i + 1 < argc) {
+            pixel_tol_override = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--max-bad") == 0 && i + 1 < argc) {
+            max_bad_override = atof(argv[++i]);
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    size_t max_pixels = 0;
+    for (int s = 0; s < SCENE_COUNT; s++) {
+        size_t n = (size_t)scenes[s].width * scenes[s].height;
+        if (n > max_pixels) max_pixels = n;
+    }
+    uint32_t* ref = (uint32_t*)malloc(max_pixels * sizeof(uint32_t));
+    uint32_t* got = (uint32_t*)malloc(max_pixels * sizeof(uint32_t));
+    if (!ref || !got) {
+        printf("Error: Gagal mengalokasi memori\n");
+        free(ref);
+        free(got);
+        return 1;
+    }
+
+    char path[512];
+
+    // Referensi selalu dibuat dengan kernel serial (urutan operasi kanonik)
+    if (update) {
+        for (int s = 0; s < SCENE_COUNT; s++) {
+            const Scene* sc = &scenes[s];
+            double min_real, max_real, min_imag, max_imag;
+            scene_bounds(sc, &min_real, &max_real, &min_imag, &max_imag);
+            if (!backend_render(&backends[0], ref, sc, min_real, max_real, min_imag, max_imag)) {
+                printf("Error: Gagal mengalokasi memori\n");
+                free(ref);
+                free(got);
+                return 1;
+            }
+            snprintf(path, sizeof(path), "%s/%s.iter", golden_dir, sc->name);
+            if (!save_golden(path, sc, ref)) {
+                printf("Error: Gagal menulis %s\n", path);
+                free(ref);
+                free(got);
+                return 1;
+            }
+            printf("Referensi diperbarui: %s\n", path);
+        }
+        free(ref);
+        free(got);
+        return 0;
+    }
+
+    printf("=== REGRESI GOLDEN IMAGE ===\n");
+    printf("Scene: %d, thread: %d, referensi: %s/\n\n", SCENE_COUNT, omp_get_max_threads(), golden_dir);
+    printf("%-12s %-10s %9s %9s %9s %8s %8s  %s\n",
+           "Backend", "Scene", "Waktu(ms)", "Beda", "Buruk", "MaksSel", "Flip", "Status");
+
+    int failures = 0;
+    int ran = 0;
+    for (int b = 0; b < BACKEND_COUNT; b++) {
+        const Backend* be = &backends[b];
+        if (only_backend && strcmp(only_backend, be->name) != 0) continue;
+        if (!backend_available(be)) {
+            printf("%-12s %-10s dilewati: tidak didukung CPU ini\n", be->name, "-");
+            continue;
+        }
+        int pixel_tol = pixel_tol_override >= 0 ? pixel_tol_override : be->pixel_tolerance;
+        double max_bad = max_bad_override >= 0.0 ? max_bad_override : be->max_bad_fraction;
+
+        for (int s = 0; s < SCENE_COUNT; s++) {
+            const Scene* sc = &scenes[s];
+            size_t count = (size_t)sc->width * sc->height;
+            if (be->max_zoom > 0.0 && sc->zoom > be->max_zoom) {
+                printf("%-12s %-10s dilewati: zoom %.0e di luar presisi backend\n",
+                       be->name, sc->name, sc->zoom);
+                continue;
+            }
+
+            snprintf(path, sizeof(path), "%s/%s.iter", golden_dir, sc->name);
+            int loaded = load_golden(path, sc, ref);
+            if (loaded <= 0) {
+                printf("Error: Referensi %s %s; jalankan dengan --update\n",
+                       path, loaded == 0 ? "tidak ditemukan" : "tidak cocok dengan scene");
+                failures++;
+                continue;
+            }
+
+            double min_real, max_real, min_imag, max_imag;
+            scene_bounds(sc, &min_real, &max_real, &min_imag, &max_imag);
+            double start = omp_get_wtime();
+            if (!backend_render(be, got, sc, min_real, max_real, min_imag, max_imag)) {
+                printf("Error: Gagal mengalokasi memori\n");
+                failures++;
+                continue;
+            }
+            double elapsed = omp_get_wtime() - start;
+            ran++;
+
+            DiffStats st;
+            compare_maps(ref, got, count, sc->max_iterations, pixel_tol, &st);
+            double bad_fraction = (double)st.bad_pixels / count;
+            int pass = bad_fraction <= max_bad;
+            if (!pass) failures++;
+
+            printf("%-12s %-10s %9.2f %8.3f%% %8.3f%% %8u %8ld  %s\n",
+                   be->name, sc->name, elapsed * 1000.0,
+                   100.0 * st.diff_pixels / count, 100.0 * bad_fraction,
+                   st.max_diff, st.class_flips, pass ? "LULUS" : "GAGAL");
+
+            if (st.diff_pixels > 0 && (!pass || heatmap_all)) {
+                snprintf(path, sizeof(path), "golden_diff_%s_%s.bmp", be->name, sc->name);
+                if (save_heatmap(path, ref, got, sc->width, sc->height, sc->max_iterations, pixel_tol)) {
+                    printf("           heatmap selisih: %s\n", path);
+                }
+            }
+        }
+    }
+
+    printf("\n");
+    if (ran == 0 && failures == 0) {
+        printf("⚠ Peringatan: tidak ada backend yang dijalankan\n");
+        failures = 1;
+    } else if (failures == 0) {
+        printf("✓ Verifikasi: semua backend dalam toleransi (%d run)\n", ran);
+    } else {
+        printf("⚠ Peringatan: %d run melewati toleransi atau gagal\n", failures);
+    }
+
+    free(ref);
+    free(got);
+    return failures ? 1 : 0;
+}
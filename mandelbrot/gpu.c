@@ -4,80 +4,7 @@
 #include <time.h>
 #include <cuda_runtime.h>
 #include <omp.h>
-
-// Struktur untuk header BMP
-#pragma pack(push, 1)
-typedef struct {
-    uint16_t type;
-    uint32_t size;
-    uint16_t reserved1;
-    uint16_t reserved2;
-    uint32_t offset;
-} BMPHeader;
-
-typedef struct {
-    uint32_t size;
-    int32_t width;
-    int32_t height;
-    uint16_t planes;
-    uint16_t bits_per_pixel;
-    uint32_t compression;
-    uint32_t image_size;
-    int32_t x_pixels_per_meter;
-    int32_t y_pixels_per_meter;
-    uint32_t colors_used;
-    uint32_t colors_important;
-} BMPInfoHeader;
-#pragma pack(pop)
-
-// Struktur untuk warna RGB
-typedef struct {
-    uint8_t b, g, r;
-} RGB;
-
-// CUDA kernel untuk menghitung iterasi Mandelbrot
-__device__ int mandelbrot_iterations_gpu(double real, double imag, int max_iter) {
-    double z_real = 0.0;
-    double z_imag = 0.0;
-    int iter = 0;
-    
-    while (iter < max_iter && (z_real * z_real + z_imag * z_imag) < 4.0) {
-        double temp = z_real * z_real - z_imag * z_imag + real;
-        z_imag = 2.0 * z_real * z_imag + imag;
-        z_real = temp;
-        iter++;
-    }
-    
-    return iter;
-}
-
-// CUDA kernel untuk mengkonversi iterasi ke warna
-__device__ RGB get_color_gpu(int iterations, int max_iter) {
-    RGB color;
-    
-    if (iterations == max_iter) {
-        // Titik dalam himpunan Mandelbrot (hitam)
-        color.r = 0;
-        color.g = 0;
-        color.b = 0;
-    } else {
-        // Gradasi warna berdasarkan iterasi
-        double ratio = (double)iterations / max_iter;
-        
-        // Skema warna biru ke merah
-        if (ratio < 0.5) {
-            color.r = (uint8_t)(255 * ratio * 2);
-            color.g = 0;
-            color.b = (uint8_t)(255 * (1 - ratio * 2));
-        } else {
-            color.r = 255;
-            color.g = (uint8_t)(255 * (ratio - 0.5) * 2);
-            color.b = 0;
-        }
-    }
-    
-    return color;
-}
+#include "render.h"
 
 // CUDA kernel untuk rendering Mandelbrot
 __global__ void mandelbrot_kernel(RGB* image, int width, int height, int max_iterations,
@@ -95,85 +22,10 @@ __global__ void mandelbrot_kernel(RGB* image, int width, int height, int max_ite
         double imag = min_imag + y * imag_scale;
         
         // Hitung iterasi Mandelbrot
-        int iterations = mandelbrot_iterations_gpu(real, imag, max_iterations);
+        int iterations = mandelbrot_iterations(real, imag, max_iterations);
         
         // Konversi ke warna dan simpan
-        image[y * width + x] = get_color_gpu(iterations, max_iterations);
-    }
-}
-
-// Versi CPU untuk perbandingan
-int mandelbrot_iterations_cpu(double real, double imag, int max_iter) {
-    double z_real = 0.0;
-    double z_imag = 0.0;
-    int iter = 0;
-    
-    while (iter < max_iter && (z_real * z_real + z_imag * z_imag) < 4.0) {
-        double temp = z_real * z_real - z_imag * z_imag + real;
-        z_imag = 2.0 * z_real * z_imag + imag;
-        z_real = temp;
-        iter++;
-    }
-    
-    return iter;
-}
-
-RGB get_color_cpu(int iterations, int max_iter) {
-    RGB color;
-    
-    if (iterations == max_iter) {
-        color.r = 0;
-        color.g = 0;
-        color.b = 0;
-    } else {
-        double ratio = (double)iterations / max_iter;
-        
-        if (ratio < 0.5) {
-            color.r = (uint8_t)(255 * ratio * 2);
-            color.g = 0;
-            color.b = (uint8_t)(255 * (1 - ratio * 2));
-        } else {
-            color.r = 255;
-            color.g = (uint8_t)(255 * (ratio - 0.5) * 2);
-            color.b = 0;
-        }
-    }
-    
-    return color;
-}
-
-// Versi serial CPU
-void render_mandelbrot_serial(RGB* image, int width, int height, int max_iterations,
-                             double min_real, double max_real, double min_imag, double max_imag) {
-    double real_scale = (max_real - min_real) / width;
-    double imag_scale = (max_imag - min_imag) / height;
-    
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            double real = min_real + x * real_scale;
-            double imag = min_imag + y * imag_scale;
-            
-            int iterations = mandelbrot_iterations_cpu(real, imag, max_iterations);
-            image[y * width + x] = get_color_cpu(iterations, max_iterations);
-        }
-    }
-}
-
-// Versi paralel CPU dengan OpenMP
-void render_mandelbrot_parallel(RGB* image, int width, int height, int max_iterations,
-                               double min_real, double max_real, double min_imag, double max_imag) {
-    double real_scale = (max_real - min_real) / width;
-    double imag_scale = (max_imag - min_imag) / height;
-    
-    #pragma omp parallel for schedule(dynamic, 1)
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            double real = min_real + x * real_scale;
-            double imag = min_imag + y * imag_scale;
-            
-            int iterations = mandelbrot_iterations_cpu(real, imag, max_iterations);
-            image[y * width + x] = get_color_cpu(iterations, max_iterations);
-        }
+        image[y * width + x] = get_color(iterations, max_iterations);
     }
 }
 
@@ -205,53 +57,6 @@ void render_mandelbrot_gpu(RGB* image, int width, int height, int max_iterations
     cudaFree(d_image);
 }
 
-// Fungsi untuk menyimpan gambar BMP
-int save_bmp(const char* filename, RGB* image, int width, int height) {
-    FILE* file = fopen(filename, "wb");
-    if (!file) return 0;
-    
-    int padding = (4 - (width * 3) % 4) % 4;
-    int row_size = width * 3 + padding;
-    
-    BMPHeader header;
-    header.type = 0x4D42;
-    header.size = sizeof(BMPHeader) + sizeof(BMPInfoHeader) + row_size * height;
-    header.reserved1 = 0;
-    header.reserved2 = 0;
-    header.offset = sizeof(BMPHeader) + sizeof(BMPInfoHeader);
-    
-    BMPInfoHeader info;
-    info.size = sizeof(BMPInfoHeader);
-    info.width = width;
-    info.height = height;
-    info.planes = 1;
-    info.bits_per_pixel = 24;
-    info.compression = 0;
-    info.image_size = row_size * height;
-    info.x_pixels_per_meter = 2835;
-    info.y_pixels_per_meter = 2835;
-    info.colors_used = 0;
-    info.colors_important = 0;
-    
-    fwrite(&header, sizeof(BMPHeader), 1, file);
-    fwrite(&info, sizeof(BMPInfoHeader), 1, file);
-    
-    uint8_t padding_bytes[3] = {0, 0, 0};
-    for (int y = height - 1; y >= 0; y--) {
-        for (int x = 0; x < width; x++) {
-            RGB pixel = image[y * width + x];
-            fwrite(&pixel, sizeof(RGB), 1, file);
-        }
-        if (padding > 0) {
-            fwrite(padding_bytes, padding, 1, file);
-        }
-    }
-    
-    fclose(file);
-    return 1;
-}
-
-// Fungsi untuk cek CUDA device info
 void print_cuda_device_info() {
     int device_count = 0;
     cudaGetDeviceCount(&device_count);
@@ -298,6 +103,11 @@ int main() {
     // Print CUDA device info
     print_cuda_device_info();
     
+    // Versi CPU dari library render: kernel skalar satu thread dan OpenMP per baris
+    RenderParams params = {width, height, max_iterations, min_real, max_real, min_imag, max_imag};
+    RenderConfig serial_cfg = {find_render_backend("scalar"), 0, 1};
+    RenderConfig parallel_cfg = {find_render_backend("openmp"), 0, 0};
+    
     // Alokasi memori untuk gambar
     RGB* image_serial = (RGB*)malloc(width * height * sizeof(RGB));
     RGB* image_parallel = (RGB*)malloc(width * height * sizeof(RGB));
@@ -315,8 +125,7 @@ int main() {
     printf("🔄 Menjalankan versi SERIAL (CPU single-thread)...\n");
     double start_serial = get_time();
     
-    render_mandelbrot_serial(image_serial, width, height, max_iterations,
-                           min_real, max_real, min_imag, max_imag);
+    render_image(&serial_cfg, &params, image_serial);
     
     double end_serial = get_time();
     double time_serial = end_serial - start_serial;
@@ -329,8 +138,7 @@ int main() {
     printf("🔄 Menjalankan versi PARALEL (CPU multi-thread)...\n");
     double start_parallel = get_time();
     
-    render_mandelbrot_parallel(image_parallel, width, height, max_iterations,
-                              min_real, max_real, min_imag, max_imag);
+    render_image(&parallel_cfg, &params, image_parallel);
     
     double end_parallel = get_time();
     double time_parallel = end_parallel - start_parallel;
@@ -0,0 +1,397 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <omp.h>
+#include "render.h"
+
+// Jumlah iterasi antar pemeriksaan lane yang selesai (dan pengisian ulang)
+#define LANE_STEPS 4
+
+// Jumlah pixel (lintas thumbnail) per tile thread
+#define TILE_PIXELS 4096
+
+// Deskripsi atlas: grid konstanta c, satu thumbnail Julia per c
+typedef struct {
+    int cols, rows;          // jumlah thumbnail
+    int thumb;               // ukuran thumbnail (persegi)
+    int max_iter;
+    double c_min_real, c_max_real, c_min_imag, c_max_imag;  // rentang c
+    double z_extent;         // setiap thumbnail mencakup [-z_extent, z_extent]^2
+} AtlasParams;
+
+// Konstanta c untuk thumbnail ke-index (baris mayor)
+static void atlas_constant(const AtlasParams* p, int index, double* c_real, double* c_imag) {
+    int col = index % p->cols;
+    int row = index / p->cols;
+    *c_real = p->c_min_real + (col + 0.5) * (p->c_max_real - p->c_min_real) / p->cols;
+    *c_imag = p->c_min_imag + (row + 0.5) * (p->c_max_imag - p->c_min_imag) / p->rows;
+}
+
+// Fungsi untuk menghitung iterasi Julia (sama dengan julia_iterations di fractal_gui.cpp)
+int julia_iterations(double z_real, double z_imag, double c_real, double c_imag, int max_iter) {
+    int iter = 0;
+
+    while (iter < max_iter && (z_real * z_real + z_imag * z_imag) < 4.0) {
+        double temp = z_real * z_real - z_imag * z_imag + c_real;
+        z_imag = 2.0 * z_real * z_imag + c_imag;
+        z_real = temp;
+        iter++;
+    }
+
+    return iter;
+}
+
+// Letakkan satu thumbnail (peta iterasi) ke dalam mosaic
+static void blit_thumbnail(RGB* mosaic, const AtlasParams* p, int index,
+                           const int* iterations) {
+    int mosaic_width = p->cols * p->thumb;
+    int x0 = (index % p->cols) * p->thumb;
+    int y0 = (index / p->cols) * p->thumb;
+    for (int y = 0; y < p->thumb; y++) {
+        RGB* row = mosaic + (size_t)(y0 + y) * mosaic_width + x0;
+        for (int x = 0; x < p->thumb; x++) {
+            row[x] = get_color(iterations[y * p->thumb + x], p->max_iter);
+        }
+    }
+}
+
+// === Mode satu-per-satu (baseline) ===
+// Setiap thumbnail dirender terpisah dengan setup sendiri (alokasi, paralelisasi
+// per baris, kernel skalar), seperti memanggil julia_iterations() per gambar.
+void render_atlas_one_by_one(RGB* mosaic, int* iterations, const AtlasParams* p) {
+    int count = p->cols * p->rows;
+    int thumb_pixels = p->thumb * p->thumb;
+    double scale = 2.0 * p->z_extent / p->thumb;
+
+    for (int index = 0; index < count; index++) {
+        double c_real, c_imag;
+        atlas_constant(p, index, &c_real, &c_imag);
+
+        int* thumb_iter = (int*)malloc(thumb_pixels * sizeof(int));
+        if (!thumb_iter) return;
+
+        #pragma omp parallel for schedule(dynamic, 1)
+        for (int y = 0; y < p->thumb; y++) {
+            for (int x = 0; x < p->thumb; x++) {
+                double real = -p->z_extent + x * scale;
+                double imag = -p->z_extent + y * scale;
+                thumb_iter[y * p->thumb + x] = julia_iterations(real, imag, c_real, c_imag, p->max_iter);
+            }
+        }
+
+        memcpy(iterations + (size_t)index * thumb_pixels, thumb_iter, thumb_pixels * sizeof(int));
+        blit_thumbnail(mosaic, p, index, thumb_iter);
+        free(thumb_iter);
+    }
+}
+
+// === Mode batch ===
+// Seluruh atlas diperlakukan sebagai satu ruang kerja datar (thumbnail, pixel).
+// Setiap tile thread berisi TILE_PIXELS item berurutan yang boleh melintasi batas
+// thumbnail, dan lane SIMD juga diisi item berurutan sehingga satu vektor bisa
+// membawa c yang berbeda. Thumbnail kecil tidak menyisakan lane atau thread kosong.
+
+// Kursor antrian item kerja di dalam tile: (thumbnail, x, y) dimajukan secara
+// inkremental agar pengisian ulang lane tidak memerlukan pembagian
+typedef struct {
+    long long next, end;
+    int index, x, y;
+} AtlasCursor;
+
+static inline void cursor_init(AtlasCursor* cur, const AtlasParams* p, long long begin, long long end) {
+    int thumb_pixels = p->thumb * p->thumb;
+    int pixel = (int)(begin % thumb_pixels);
+    cur->next = begin;
+    cur->end = end;
+    cur->index = (int)(begin / thumb_pixels);
+    cur->x = pixel % p->thumb;
+    cur->y = pixel / p->thumb;
+}
+
+static inline void cursor_advance(AtlasCursor* cur, int thumb) {
+    cur->next++;
+    if (++cur->x == thumb) {
+        cur->x = 0;
+        if (++cur->y == thumb) {
+            cur->y = 0;
+            cur->index++;
+        }
+    }
+}
+
+// Kernel tile untuk satu lebar vektor. Badannya sama untuk semua ISA, hanya
+// jumlah lane dan atribut target yang berbeda, jadi dibangkitkan lewat makro.
+// fp-contract=off: tanpa itu target dengan FMA menggabungkan 2*zr*zi + ci dan
+// hasilnya tidak lagi identik dengan julia_iterations().
+// coord: koordinat z per kolom/baris thumbnail, c_tab: konstanta c per thumbnail
+#define DEFINE_TILE_KERNEL(NAME, LANES, ATTR)                                           \
+ATTR static void NAME(int* iterations, const AtlasParams* p, const double* coord,       \
+                      const double* c_real_tab, const double* c_imag_tab,               \
+                      long long begin, long long end) {                                 \
+    typedef double vdouble __attribute__((vector_size(LANES * sizeof(double))));        \
+    typedef long long vlong __attribute__((vector_size(LANES * sizeof(long long))));    \
+    AtlasCursor cur;                                                                    \
+    cursor_init(&cur, p, begin, end);                                                   \
+    vlong limit;                                                                        \
+    vdouble zr, zi, cr, ci;                                                             \
+    vlong iter, alive;                                                                  \
+    long long item[LANES];   /* item yang sedang dihitung lane, -1 = kosong */          \
+    for (int l = 0; l < LANES; l++) {                                                   \
+        limit[l] = p->max_iter;                                                         \
+        zr[l] = zi[l] = cr[l] = ci[l] = 0.0;                                            \
+        iter[l] = 0;                                                                    \
+        alive[l] = 0;                                                                   \
+        item[l] = -1;                                                                   \
+    }                                                                                   \
+                                                                                        \
+    for (;;) {                                                                          \
+        /* Lane yang selesai menyimpan hasilnya dan langsung diisi item */              \
+        /* berikutnya (boleh dari thumbnail berbeda), jadi satu pixel lambat */         \
+        /* tidak membuat lane lain menganggur */                                        \
+        int busy = 0;                                                                   \
+        for (int l = 0; l < LANES; l++) {                                               \
+            if (alive[l]) {                                                             \
+                busy = 1;                                                               \
+                continue;                                                               \
+            }                                                                           \
+            if (item[l] >= 0) iterations[item[l]] = (int)iter[l];                       \
+            if (cur.next < cur.end) {                                                   \
+                item[l] = cur.next;                                                     \
+                zr[l] = coord[cur.x];                                                   \
+                zi[l] = coord[cur.y];                                                   \
+                cr[l] = c_real_tab[cur.index];                                          \
+                ci[l] = c_imag_tab[cur.index];                                          \
+                iter[l] = 0;                                                            \
+                alive[l] = -1;                                                          \
+                busy = 1;                                                               \
+                cursor_advance(&cur, p->thumb);                                         \
+            } else {                                                                    \
+                item[l] = -1;                                                           \
+            }                                                                           \
+        }                                                                               \
+        if (!busy) break;                                                               \
+                                                                                        \
+        /* Setiap lane punya hitungan sendiri, jadi batas max_iter dicek per */         \
+        /* lane; lane yang mati membekukan hitungannya sampai diisi ulang */            \
+        for (int s = 0; s < LANE_STEPS; s++) {                                          \
+            vdouble zr2 = zr * zr;                                                      \
+            vdouble zi2 = zi * zi;                                                      \
+            alive &= (zr2 + zi2 < 4.0) & (iter < limit);                                \
+            vdouble temp = zr2 - zi2 + cr;                                              \
+            zi = 2.0 * zr * zi + ci;                                                    \
+            zr = temp;                                                                  \
+            iter -= alive;  /* alive bernilai -1 untuk lane aktif */                    \
+        }                                                                               \
+    }                                                                                   \
+}
+
+typedef void (*TileKernel)(int*, const AtlasParams*, const double*,
+                           const double*, const double*, long long, long long);
+
+// Baseline 2 lane (SSE2 di x86-64, generik di arsitektur lain)
+DEFINE_TILE_KERNEL(render_tile_2, 2, __attribute__((optimize("fp-contract=off"))))
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+DEFINE_TILE_KERNEL(render_tile_avx2, 4,
+                   __attribute__((target("avx2"), optimize("fp-contract=off"))))
+DEFINE_TILE_KERNEL(render_tile_avx512, 8,
+                   __attribute__((target("avx512f"), optimize("fp-contract=off"))))
+#endif
+
+// Pilih kernel terlebar yang didukung CPU saat runtime (tanpa perlu -march)
+static TileKernel select_tile_kernel(int* lanes, const char** isa) {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        *lanes = 8;
+        *isa = "avx512f";
+        return render_tile_avx512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        *lanes = 4;
+        *isa = "avx2";
+        return render_tile_avx2;
+    }
+#endif
+    *lanes = 2;
+    *isa = "baseline";
+    return render_tile_2;
+}
+
+void render_atlas_batched(RGB* mosaic, int* iterations, const AtlasParams* p) {
+    int lanes;
+    const char* isa;
+    TileKernel render_tile = select_tile_kernel(&lanes, &isa);
+    int count = p->cols * p->rows;
+    long long total = (long long)count * p->thumb * p->thumb;
+    long long tiles = (total + TILE_PIXELS - 1) / TILE_PIXELS;
+    double scale = 2.0 * p->z_extent / p->thumb;
+
+    // Setup sekali untuk seluruh atlas
+    double* coord = (double*)malloc(p->thumb * sizeof(double));
+    double* c_real_tab = (double*)malloc(count * sizeof(double));
+    double* c_imag_tab = (double*)malloc(count * sizeof(double));
+    if (!coord || !c_real_tab || !c_imag_tab) {
+        free(coord);
+        free(c_real_tab);
+        free(c_imag_tab);
+        return;
+    }
+    for (int i = 0; i < p->thumb; i++) coord[i] = -p->z_extent + i * scale;
+    for (int i = 0; i < count; i++) atlas_constant(p, i, &c_real_tab[i], &c_imag_tab[i]);
+
+    #pragma omp parallel
+    {
+        #pragma omp for schedule(dynamic, 1)
+        for (long long t = 0; t < tiles; t++) {
+            long long begin = t * TILE_PIXELS;
+            long long end = begin + TILE_PIXELS < total ? begin + TILE_PIXELS : total;
+            render_tile(iterations, p, coord, c_real_tab, c_imag_tab, begin, end);
+        }
+
+        // Pewarnaan mosaic juga paralel per thumbnail
+        #pragma omp for schedule(static)
+        for (int index = 0; index < count; index++) {
+            blit_thumbnail(mosaic, p, index,
+                           iterations + (size_t)index * p->thumb * p->thumb);
+        }
+    }
+
+    free(coord);
+    free(c_real_tab);
+    free(c_imag_tab);
+}
+
+// Tulis indeks atlas (CSV): posisi setiap thumbnail di mosaic beserta c-nya
+int save_atlas_index(const char* filename, const AtlasParams* p, const int* iterations) {
+    FILE* file = fopen(filename, "w");
+    if (!file) return 0;
+
+    int thumb_pixels = p->thumb * p->thumb;
+    fprintf(file, "index,col,row,c_real,c_imag,x,y,size,mean_iterations,interior_fraction\n");
+    for (int index = 0; index < p->cols * p->rows; index++) {
+        double c_real, c_imag;
+        atlas_constant(p, index, &c_real, &c_imag);
+        const int* it = iterations + (size_t)index * thumb_pixels;
+        long long sum = 0;
+        int interior = 0;
+        for (int i = 0; i < thumb_pixels; i++) {
+            sum += it[i];
+            if (it[i] == p->max_iter) interior++;
+        }
+        int col = index % p->cols;
+        int row = index / p->cols;
+        fprintf(file, "%d,%d,%d,%.10f,%.10f,%d,%d,%d,%.2f,%.4f\n",
+                index, col, row, c_real, c_imag, col * p->thumb, row * p->thumb, p->thumb,
+                (double)sum / thumb_pixels, (double)interior / thumb_pixels);
+    }
+
+    fclose(file);
+    return 1;
+}
+
+int main(int argc, char** argv) {
+    // Parameter yang bisa diubah
+    AtlasParams params;
+    params.cols = 32;
+    params.rows = 32;
+    params.thumb = 64;
+    params.max_iter = 200;
+
+    // Rentang konstanta c (bidang parameter Mandelbrot) dan area setiap thumbnail
+    params.c_min_real = -2.0;
+    params.c_max_real = 0.6;
+    params.c_min_imag = -1.3;
+    params.c_max_imag = 1.3;
+    params.z_extent = 1.8;
+
+    // Penggunaan: mandelbrot_julia_atlas [kolom baris ukuran_thumbnail max_iterasi]
+    if (argc > 1) params.cols = atoi(argv[1]);
+    if (argc > 2) params.rows = atoi(argv[2]);
+    if (argc > 3) params.thumb = atoi(argv[3]);
+    if (argc > 4) params.max_iter = atoi(argv[4]);
+    if (params.cols <= 0 || params.rows <= 0 || params.thumb <= 0 || params.max_iter <= 0) {
+        printf("Penggunaan: %s [kolom baris ukuran_thumbnail max_iterasi]\n", argv[0]);
+        return 1;
+    }
+
+    int count = params.cols * params.rows;
+    int mosaic_width = params.cols * params.thumb;
+    int mosaic_height = params.rows * params.thumb;
+    size_t pixels = (size_t)mosaic_width * mosaic_height;
+
+    printf("=== ATLAS JULIA SET ===\n");
+    printf("Thumbnail: %d (%dx%d grid), %dx%d pixels\n", count, params.cols, params.rows,
+           params.thumb, params.thumb);
+    printf("Mosaic: %dx%d pixels\n", mosaic_width, mosaic_height);
+    printf("Max iterasi: %d\n", params.max_iter);
+    int lanes;
+    const char* isa;
+    select_tile_kernel(&lanes, &isa);
+    printf("Lane SIMD: %d (%s), tile: %d pixel\n", lanes, isa, TILE_PIXELS);
+    printf("Jumlah thread tersedia: %d\n", omp_get_max_threads());
+    printf("\n");
+
+    // Alokasi memori untuk peta iterasi dan mosaic
+    int* iter_single = (int*)malloc(pixels * sizeof(int));
+    int* iter_batch = (int*)malloc(pixels * sizeof(int));
+    RGB* mosaic_single = (RGB*)malloc(pixels * sizeof(RGB));
+    RGB* mosaic_batch = (RGB*)malloc(pixels * sizeof(RGB));
+    if (!iter_single || !iter_batch || !mosaic_single || !mosaic_batch) {
+        printf("Error: Gagal mengalokasi memori\n");
+        free(iter_single);
+        free(iter_batch);
+        free(mosaic_single);
+        free(mosaic_batch);
+        return 1;
+    }
+
+    // === BENCHMARK SATU-PER-SATU ===
+    printf("Menjalankan mode SATU-PER-SATU...\n");
+    double start_single = omp_get_wtime();
+    render_atlas_one_by_one(mosaic_single, iter_single, &params);
+    double time_single = omp_get_wtime() - start_single;
+    printf("Waktu: %.3f detik (%.1f thumbnail/detik)\n", time_single, count / time_single);
+    printf("\n");
+
+    // === BENCHMARK BATCH ===
+    printf("Menjalankan mode BATCH...\n");
+    double start_batch = omp_get_wtime();
+    render_atlas_batched(mosaic_batch, iter_batch, &params);
+    double time_batch = omp_get_wtime() - start_batch;
+    printf("Waktu: %.3f detik (%.1f thumbnail/detik)\n", time_batch, count / time_batch);
+    printf("\n");
+
+    if (!save_bmp("julia_atlas.bmp", mosaic_batch, mosaic_width, mosaic_height)) {
+        printf("Error: Gagal menyimpan mosaic\n");
+    } else {
+        printf("Mosaic disimpan: julia_atlas.bmp\n");
+    }
+    if (!save_atlas_index("julia_atlas_index.csv", &params, iter_batch)) {
+        printf("Error: Gagal menyimpan indeks\n");
+    } else {
+        printf("Indeks disimpan: julia_atlas_index.csv\n");
+    }
+    printf("\n");
+
+    printf("=== HASIL BENCHMARK ===\n");
+    printf("Satu-per-satu:   %.1f thumbnail/detik\n", count / time_single);
+    printf("Batch:           %.1f thumbnail/detik\n", count / time_batch);
+    printf("Speedup:         %.2fx\n", time_single / time_batch);
+
+    // Verifikasi bahwa kedua mode menghasilkan peta iterasi identik
+    if (memcmp(iter_single, iter_batch, pixels * sizeof(int)) == 0) {
+        printf("✓ Verifikasi: Hasil satu-per-satu dan batch identik\n");
+    } else {
+        printf("⚠ Peringatan: Hasil satu-per-satu dan batch berbeda\n");
+    }
+
+    // Bersihkan memori
+    free(iter_single);
+    free(iter_batch);
+    free(mosaic_single);
+    free(mosaic_batch);
+
+    return 0;
+}
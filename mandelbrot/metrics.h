@@ -0,0 +1,493 @@
+// metrics.h - In-process metrics registry with Prometheus text exposition
+//
+// Counters, gauges and fixed-bucket histograms for long-running render
+// processes (the viewer, the replay benchmark). Hot paths only ever touch
+// their own thread's shard: every thread gets a private slot on first use,
+// and an update is a relaxed load + store on that slot, with no locked
+// instruction and no cache line shared with another writer. Reading sums the
+// shards, so a scrape sees each shard's latest value without stopping writers.
+// A thread returns its slot when it exits, so code that starts fresh worker
+// threads every frame keeps cycling through the same slots; only more than
+// METRICS_SHARDS threads alive at once share the overflow slot (fetch_add).
+//
+// The registry renders the Prometheus text format (version 0.0.4). Two
+// exporters publish it: MetricsFileExporter rewrites a file periodically
+// (write to a temporary file, then rename), and MetricsHttpExporter (POSIX)
+// serves it on 127.0.0.1:<port> for curl or a Prometheus scrape job.
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <malloc.h>
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+static const int METRICS_SHARDS = 64;
+static const int METRICS_MAX_BUCKETS = 16;
+
+// Free shard IDs. Taking and returning one locks, but only once per thread
+// lifetime; the mutex also orders a slot's last write by its old thread
+// before the first write by the next one.
+class MetricsShardPool {
+public:
+    MetricsShardPool() : next_(0) {}
+
+    int acquire() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!free_.empty()) {
+            int shard = free_.back();
+            free_.pop_back();
+            return shard;
+        }
+        return next_ < METRICS_SHARDS ? next_++ : METRICS_SHARDS;
+    }
+
+    void release(int shard) {
+        if (shard >= METRICS_SHARDS) return;
+        std::lock_guard<std::mutex> lock(mutex_);
+        free_.push_back(shard);
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<int> free_;
+    int next_;
+};
+
+inline MetricsShardPool& metrics_shard_pool() {
+    static MetricsShardPool pool;
+    return pool;
+}
+
+// Holds the calling thread's shard and gives it back on thread exit
+struct MetricsShardHolder {
+    int shard;
+    MetricsShardHolder() : shard(metrics_shard_pool().acquire()) {}
+    ~MetricsShardHolder() { metrics_shard_pool().release(shard); }
+};
+
+// Shard of the calling thread; METRICS_SHARDS = shared overflow slot
+inline int metrics_thread_shard() {
+    static thread_local MetricsShardHolder holder;
+    return holder.shard;
+}
+
+// Cache-line aligned heap blocks for the sharded metrics. C++11 new (and
+// std::allocator) ignores alignas beyond 16 bytes, so the classes allocate
+// through these instead.
+inline void* metrics_aligned_new(size_t size) {
+#ifdef _WIN32
+    void* ptr = _aligned_malloc(size, 64);
+#else
+    void* ptr = NULL;
+    if (posix_memalign(&ptr, 64, size) != 0) ptr = NULL;
+#endif
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+inline void metrics_aligned_delete(void* ptr) {
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+// Add to a cell that only the calling thread writes (or fetch_add on the
+// overflow slot)
+inline void metrics_cell_add(std::atomic<uint64_t>& cell, uint64_t n, int shard) {
+    if (shard < METRICS_SHARDS) {
+        cell.store(cell.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    } else {
+        cell.fetch_add(n, std::memory_order_relaxed);
+    }
+}
+
+inline uint64_t metrics_double_bits(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+inline double metrics_bits_double(uint64_t bits) {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+class MetricCounter {
+public:
+    MetricCounter() {
+        for (Cell& c : cells_) c.value.store(0, std::memory_order_relaxed);
+    }
+
+    static void* operator new(size_t size) { return metrics_aligned_new(size); }
+    static void operator delete(void* ptr) { metrics_aligned_delete(ptr); }
+
+    void add(uint64_t n = 1) {
+        int shard = metrics_thread_shard();
+        metrics_cell_add(cells_[shard].value, n, shard);
+    }
+
+    uint64_t value() const {
+        uint64_t total = 0;
+        for (const Cell& c : cells_) total += c.value.load(std::memory_order_relaxed);
+        return total;
+    }
+
+private:
+    // One cache line per cell, so neighbouring writers never share a line
+    struct alignas(64) Cell {
+        std::atomic<uint64_t> value;
+    };
+    Cell cells_[METRICS_SHARDS + 1];
+};
+
+// Last written value wins; set from any thread
+class MetricGauge {
+public:
+    MetricGauge() : bits_(metrics_double_bits(0.0)) {}
+
+    void set(double value) { bits_.store(metrics_double_bits(value), std::memory_order_relaxed); }
+    double value() const { return metrics_bits_double(bits_.load(std::memory_order_relaxed)); }
+
+private:
+    std::atomic<uint64_t> bits_;
+};
+
+// Cumulative buckets (le = upper bound) plus +Inf, sum and count
+class MetricHistogram {
+public:
+    explicit MetricHistogram(const std::vector<double>& bounds) : bounds_(bounds) {
+        if (bounds_.size() > static_cast<size_t>(METRICS_MAX_BUCKETS)) bounds_.resize(METRICS_MAX_BUCKETS);
+        for (Shard& s : shards_) {
+            for (std::atomic<uint64_t>& b : s.buckets) b.store(0, std::memory_order_relaxed);
+            s.sum_bits.store(metrics_double_bits(0.0), std::memory_order_relaxed);
+        }
+    }
+
+    static void* operator new(size_t size) { return metrics_aligned_new(size); }
+    static void operator delete(void* ptr) { metrics_aligned_delete(ptr); }
+
+    void observe(double value) {
+        int shard = metrics_thread_shard();
+        Shard& s = shards_[shard];
+        size_t bucket = 0;
+        while (bucket < bounds_.size() && value > bounds_[bucket]) bucket++;
+        metrics_cell_add(s.buckets[bucket], 1, shard);
+        if (shard < METRICS_SHARDS) {
+            double sum = metrics_bits_double(s.sum_bits.load(std::memory_order_relaxed));
+            s.sum_bits.store(metrics_double_bits(sum + value), std::memory_order_relaxed);
+        } else {
+            // Overflow slot has several writers: CAS loop on the sum
+            uint64_t old_bits = s.sum_bits.load(std::memory_order_relaxed);
+            while (!s.sum_bits.compare_exchange_weak(
+                old_bits, metrics_double_bits(metrics_bits_double(old_bits) + value),
+                std::memory_order_relaxed)) {
+            }
+        }
+    }
+
+    const std::vector<double>& bounds() const { return bounds_; }
+
+    // Non-cumulative bucket counts (bounds().size() + 1 entries, last = +Inf)
+    std::vector<uint64_t> counts() const {
+        std::vector<uint64_t> total(bounds_.size() + 1, 0);
+        for (const Shard& s : shards_) {
+            for (size_t b = 0; b < total.size(); b++) total[b] += s.buckets[b].load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    double sum() const {
+        double total = 0.0;
+        for (const Shard& s : shards_) total += metrics_bits_double(s.sum_bits.load(std::memory_order_relaxed));
+        return total;
+    }
+
+private:
+    std::vector<double> bounds_;
+    // Shards start on a line boundary and fill whole lines
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> buckets[METRICS_MAX_BUCKETS + 1];
+        std::atomic<uint64_t> sum_bits;
+    };
+    Shard shards_[METRICS_SHARDS + 1];
+};
+
+// Exponential bucket bounds: start, start*factor, ...
+inline std::vector<double> metrics_exponential_buckets(double start, double factor, int count) {
+    std::vector<double> bounds;
+    for (int i = 0; i < count; i++, start *= factor) bounds.push_back(start);
+    return bounds;
+}
+
+// Registration takes a lock (startup only); the returned references stay
+// valid for the registry's lifetime and are what hot paths hold on to.
+class MetricsRegistry {
+public:
+    MetricsRegistry() : started_(std::chrono::steady_clock::now()) {}
+
+    // labels: Prometheus label list without braces, e.g. stage="render"
+    MetricCounter& counter(const std::string& name, const std::string& help, const std::string& labels = "") {
+        std::lock_guard<std::mutex> lock(mutex_);
+        counters_.push_back(std::unique_ptr<MetricCounter>(new MetricCounter()));
+        add_series(name, help, "counter", labels, counters_.back().get(), NULL, NULL);
+        return *counters_.back();
+    }
+
+    MetricGauge& gauge(const std::string& name, const std::string& help, const std::string& labels = "") {
+        std::lock_guard<std::mutex> lock(mutex_);
+        gauges_.push_back(std::unique_ptr<MetricGauge>(new MetricGauge()));
+        add_series(name, help, "gauge", labels, NULL, gauges_.back().get(), NULL);
+        return *gauges_.back();
+    }
+
+    MetricHistogram& histogram(const std::string& name, const std::string& help,
+                               const std::vector<double>& bounds, const std::string& labels = "") {
+        std::lock_guard<std::mutex> lock(mutex_);
+        histograms_.push_back(std::unique_ptr<MetricHistogram>(new MetricHistogram(bounds)));
+        add_series(name, help, "histogram", labels, NULL, NULL, histograms_.back().get());
+        return *histograms_.back();
+    }
+
+    // Prometheus text exposition format 0.0.4
+    std::string expose() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::string out;
+        char line[512];
+        double uptime = std::chrono::duration<double>(std::chrono::steady_clock::now() - started_).count();
+        out += "# HELP process_uptime_seconds Seconds since the metrics registry was created\n";
+        out += "# TYPE process_uptime_seconds gauge\n";
+        std::snprintf(line, sizeof(line), "process_uptime_seconds %.3f\n", uptime);
+        out += line;
+
+        for (const Family& f : families_) {
+            out += "# HELP " + f.name + " " + f.help + "\n";
+            out += "# TYPE " + f.name + " " + f.type + "\n";
+            for (const Series& s : f.series) {
+                std::string braces = s.labels.empty() ? "" : "{" + s.labels + "}";
+                if (s.counter) {
+                    std::snprintf(line, sizeof(line), "%s%s %llu\n", f.name.c_str(), braces.c_str(),
+                                  static_cast<unsigned long long>(s.counter->value()));
+                    out += line;
+                } else if (s.gauge) {
+                    std::snprintf(line, sizeof(line), "%s%s %.9g\n", f.name.c_str(), braces.c_str(),
+                                  s.gauge->value());
+                    out += line;
+                } else {
+                    std::vector<uint64_t> counts = s.histogram->counts();
+                    const std::vector<double>& bounds = s.histogram->bounds();
+                    std::string prefix = s.labels.empty() ? "" : s.labels + ",";
+                    uint64_t cumulative = 0;
+                    for (size_t b = 0; b < counts.size(); b++) {
+                        cumulative += counts[b];
+                        char le[32];
+                        if (b < bounds.size()) std::snprintf(le, sizeof(le), "%.9g", bounds[b]);
+                        else std::snprintf(le, sizeof(le), "+Inf");
+                        std::snprintf(line, sizeof(line), "%s_bucket{%sle=\"%s\"} %llu\n", f.name.c_str(),
+                                      prefix.c_str(), le, static_cast<unsigned long long>(cumulative));
+                        out += line;
+                    }
+                    std::snprintf(line, sizeof(line), "%s_sum%s %.9g\n%s_count%s %llu\n",
+                                  f.name.c_str(), braces.c_str(), s.histogram->sum(),
+                                  f.name.c_str(), braces.c_str(), static_cast<unsigned long long>(cumulative));
+                    out += line;
+                }
+            }
+        }
+        return out;
+    }
+
+private:
+    struct Series {
+        std::string labels;
+        MetricCounter* counter;
+        MetricGauge* gauge;
+        MetricHistogram* histogram;
+    };
+    struct Family {
+        std::string name, help, type;
+        std::vector<Series> series;
+    };
+
+    // Series of one name are grouped under a single HELP/TYPE header
+    void add_series(const std::string& name, const std::string& help, const char* type,
+                    const std::string& labels, MetricCounter* c, MetricGauge* g, MetricHistogram* h) {
+        Series s = {labels, c, g, h};
+        for (Family& f : families_) {
+            if (f.name == name) {
+                f.series.push_back(s);
+                return;
+            }
+        }
+        Family f = {name, help, type, std::vector<Series>(1, s)};
+        families_.push_back(f);
+    }
+
+    std::mutex mutex_;
+    std::chrono::steady_clock::time_point started_;
+    // Owned through pointers: addresses stay stable, and the counters and
+    // histograms get their 64-byte aligned allocation
+    std::vector<std::unique_ptr<MetricCounter> > counters_;
+    std::vector<std::unique_ptr<MetricGauge> > gauges_;
+    std::vector<std::unique_ptr<MetricHistogram> > histograms_;
+    std::vector<Family> families_;
+};
+
+// Rewrites path every interval (and once more on stop). Readers never see a
+// half-written file: the text goes to path.tmp first and is renamed over it.
+class MetricsFileExporter {
+public:
+    MetricsFileExporter(MetricsRegistry& registry, const std::string& path, double interval_s)
+        : registry_(registry), path_(path), interval_s_(interval_s), stopping_(false) {}
+
+    ~MetricsFileExporter() { stop(); }
+
+    bool start() {
+        if (!dump()) return false;
+        thread_ = std::thread([this]() {
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (!cv_.wait_for(lock, std::chrono::duration<double>(interval_s_), [this]() { return stopping_; })) {
+                lock.unlock();
+                dump();
+                lock.lock();
+            }
+        });
+        return true;
+    }
+
+    void stop() {
+        if (!thread_.joinable()) return;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_one();
+        thread_.join();
+        dump();
+    }
+
+    bool dump() {
+        std::string text = registry_.expose();
+        std::string tmp = path_ + ".tmp";
+        FILE* file = std::fopen(tmp.c_str(), "wb");
+        if (!file) return false;
+        bool ok = std::fwrite(text.data(), 1, text.size(), file) == text.size();
+        ok = std::fclose(file) == 0 && ok;
+#ifdef _WIN32
+        // rename() does not replace an existing file on Windows
+        std::remove(path_.c_str());
+#endif
+        return ok && std::rename(tmp.c_str(), path_.c_str()) == 0;
+    }
+
+private:
+    MetricsRegistry& registry_;
+    std::string path_;
+    double interval_s_;
+    std::thread thread_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_;
+};
+
+// Minimal HTTP/1.0 responder on 127.0.0.1: every request gets the current
+// exposition text. One connection at a time is plenty for a scraper.
+class MetricsHttpExporter {
+public:
+    MetricsHttpExporter(MetricsRegistry& registry, int port)
+        : registry_(registry), port_(port), fd_(-1), stopping_(false) {}
+
+    ~MetricsHttpExporter() { stop(); }
+
+#ifndef _WIN32
+    bool start() {
+        fd_ = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd_ < 0) return false;
+        int one = 1;
+        setsockopt(fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        sockaddr_in addr;
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(static_cast<uint16_t>(port_));
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (bind(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(fd_, 8) != 0) {
+            close(fd_);
+            fd_ = -1;
+            return false;
+        }
+        thread_ = std::thread([this]() { serve(); });
+        return true;
+    }
+
+    void stop() {
+        if (!thread_.joinable()) return;
+        stopping_ = true;
+        thread_.join();
+        close(fd_);
+        fd_ = -1;
+    }
+
+private:
+    void serve() {
+        while (!stopping_) {
+            pollfd p = {fd_, POLLIN, 0};
+            if (poll(&p, 1, 200) <= 0) continue;
+            int client = accept(fd_, NULL, NULL);
+            if (client < 0) continue;
+            // Request line and headers are not inspected; drain what arrived
+            char request[1024];
+            pollfd c = {client, POLLIN, 0};
+            if (poll(&c, 1, 1000) > 0) {
+                ssize_t ignored = recv(client, request, sizeof(request), 0);
+                (void)ignored;
+            }
+            std::string body = registry_.expose();
+            char header[160];
+            std::snprintf(header, sizeof(header),
+                          "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\n"
+                          "Content-Length: %zu\r\nConnection: close\r\n\r\n", body.size());
+            std::string response = header + body;
+            size_t sent = 0;
+            while (sent < response.size()) {
+                ssize_t n = send(client, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+                if (n <= 0) break;
+                sent += static_cast<size_t>(n);
+            }
+            close(client);
+        }
+    }
+#else
+    bool start() { return false; }   // use MetricsFileExporter on Windows
+    void stop() {}
+#endif
+
+    MetricsRegistry& registry_;
+    int port_;
+    int fd_;
+    std::atomic<bool> stopping_;
+    std::thread thread_;
+};
+
+#endif
@@ -0,0 +1,180 @@
+// metrics_c.h - Counters, gauges and histograms for the C front ends
+//
+// metrics.h is C++ (std::atomic, std::thread) and cannot be included from
+// parallel.c. This header gives the C side the same Prometheus text format
+// (version 0.0.4, same series layout) with a much smaller surface: a
+// fixed-size registry, updates through OpenMP atomics, and a dump to a file
+// (written to path.tmp, then renamed). There is no per-thread sharding, so
+// updates belong on per-job / per-stage events, not in per-pixel loops.
+// Without -fopenmp the atomics disappear; update from one thread only then.
+#ifndef METRICS_C_H
+#define METRICS_C_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <omp.h>
+
+#define CMETRICS_MAX 32
+#define CMETRICS_MAX_BUCKETS 16
+
+typedef enum { CMETRIC_COUNTER, CMETRIC_GAUGE, CMETRIC_HISTOGRAM } CMetricType;
+
+typedef struct {
+    CMetricType type;
+    char name[64];
+    char help[128];
+    char labels[64];        // Prometheus label list without braces, e.g. stage="render"
+    uint64_t value;         // counter
+    double gauge;
+    int bucket_count;
+    double bounds[CMETRICS_MAX_BUCKETS];
+    uint64_t buckets[CMETRICS_MAX_BUCKETS + 1];  // non-cumulative, last = +Inf
+    double sum;
+} CMetric;
+
+typedef struct {
+    CMetric metrics[CMETRICS_MAX];
+    int count;
+    double started;
+} CMetricsRegistry;
+
+static inline void cmetrics_init(CMetricsRegistry* r) {
+    memset(r, 0, sizeof(*r));
+    r->started = omp_get_wtime();
+}
+
+// Registration is not thread safe (startup only). Returns NULL once the
+// registry is full; every update accepts NULL and does nothing.
+static inline CMetric* cmetrics_add(CMetricsRegistry* r, CMetricType type, const char* name,
+                                    const char* help, const char* labels) {
+    if (r->count == CMETRICS_MAX) return NULL;
+    CMetric* m = &r->metrics[r->count++];
+    m->type = type;
+    snprintf(m->name, sizeof(m->name), "%s", name);
+    snprintf(m->help, sizeof(m->help), "%s", help);
+    snprintf(m->labels, sizeof(m->labels), "%s", labels ? labels : "");
+    return m;
+}
+
+static inline CMetric* cmetrics_counter(CMetricsRegistry* r, const char* name, const char* help,
+                                        const char* labels) {
+    return cmetrics_add(r, CMETRIC_COUNTER, name, help, labels);
+}
+
+static inline CMetric* cmetrics_gauge(CMetricsRegistry* r, const char* name, const char* help,
+                                      const char* labels) {
+    return cmetrics_add(r, CMETRIC_GAUGE, name, help, labels);
+}
+
+static inline CMetric* cmetrics_histogram(CMetricsRegistry* r, const char* name, const char* help,
+                                          const char* labels, const double* bounds, int count) {
+    CMetric* m = cmetrics_add(r, CMETRIC_HISTOGRAM, name, help, labels);
+    if (!m) return NULL;
+    m->bucket_count = count < CMETRICS_MAX_BUCKETS ? count : CMETRICS_MAX_BUCKETS;
+    memcpy(m->bounds, bounds, m->bucket_count * sizeof(double));
+    return m;
+}
+
+// Exponential bucket bounds: start, start*factor, ...
+static inline void cmetrics_exponential_buckets(double* bounds, double start, double factor, int count) {
+    for (int i = 0; i < count; i++, start *= factor) bounds[i] = start;
+}
+
+static inline void cmetric_add(CMetric* m, uint64_t n) {
+    if (!m) return;
+    #pragma omp atomic
+    m->value += n;
+}
+
+static inline void cmetric_gauge_add(CMetric* m, double delta) {
+    if (!m) return;
+    #pragma omp atomic
+    m->gauge += delta;
+}
+
+static inline void cmetric_set(CMetric* m, double value) {
+    if (!m) return;
+    #pragma omp atomic write
+    m->gauge = value;
+}
+
+static inline void cmetric_observe(CMetric* m, double value) {
+    if (!m) return;
+    int bucket = 0;
+    while (bucket < m->bucket_count && value > m->bounds[bucket]) bucket++;
+    #pragma omp atomic
+    m->buckets[bucket]++;
+    #pragma omp atomic
+    m->sum += value;
+}
+
+static inline void cmetrics_write_series(FILE* file, const CMetric* m) {
+    char braces[80];
+    snprintf(braces, sizeof(braces), m->labels[0] ? "{%s}" : "%s", m->labels);
+    if (m->type == CMETRIC_COUNTER) {
+        uint64_t value;
+        #pragma omp atomic read
+        value = m->value;
+        fprintf(file, "%s%s %llu\n", m->name, braces, (unsigned long long)value);
+    } else if (m->type == CMETRIC_GAUGE) {
+        double value;
+        #pragma omp atomic read
+        value = m->gauge;
+        fprintf(file, "%s%s %.9g\n", m->name, braces, value);
+    } else {
+        uint64_t cumulative = 0;
+        for (int b = 0; b <= m->bucket_count; b++) {
+            uint64_t count;
+            #pragma omp atomic read
+            count = m->buckets[b];
+            cumulative += count;
+            char le[32];
+            if (b < m->bucket_count) snprintf(le, sizeof(le), "%.9g", m->bounds[b]);
+            else snprintf(le, sizeof(le), "+Inf");
+            fprintf(file, "%s_bucket{%s%sle=\"%s\"} %llu\n", m->name, m->labels,
+                    m->labels[0] ? "," : "", le, (unsigned long long)cumulative);
+        }
+        double sum;
+        #pragma omp atomic read
+        sum = m->sum;
+        fprintf(file, "%s_sum%s %.9g\n%s_count%s %llu\n", m->name, braces, sum,
+                m->name, braces, (unsigned long long)cumulative);
+    }
+}
+
+// Prometheus text exposition, same layout as MetricsRegistry::expose(): series
+// of one name are grouped under a single HELP/TYPE header. Safe to call while
+// other threads update; readers never see a half-written file. Dumps to the
+// same path from several threads must be serialized by the caller.
+static inline int cmetrics_dump(const CMetricsRegistry* r, const char* path) {
+    static const char* types[] = {"counter", "gauge", "histogram"};
+    char tmp[512];
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+    FILE* file = fopen(tmp, "wb");
+    if (!file) return 0;
+
+    fprintf(file, "# HELP process_uptime_seconds Seconds since the metrics registry was created\n");
+    fprintf(file, "# TYPE process_uptime_seconds gauge\n");
+    fprintf(file, "process_uptime_seconds %.3f\n", omp_get_wtime() - r->started);
+    for (int i = 0; i < r->count; i++) {
+        int seen = 0;
+        for (int j = 0; j < i && !seen; j++) seen = strcmp(r->metrics[j].name, r->metrics[i].name) == 0;
+        if (seen) continue;
+        fprintf(file, "# HELP %s %s\n", r->metrics[i].name, r->metrics[i].help);
+        fprintf(file, "# TYPE %s %s\n", r->metrics[i].name, types[r->metrics[i].type]);
+        for (int j = i; j < r->count; j++) {
+            if (strcmp(r->metrics[j].name, r->metrics[i].name) == 0) cmetrics_write_series(file, &r->metrics[j]);
+        }
+    }
+
+    int ok = !ferror(file);
+    ok = fclose(file) == 0 && ok;
+#ifdef _WIN32
+    // rename() does not replace an existing file on Windows
+    remove(path);
+#endif
+    return ok && rename(tmp, path) == 0;
+}
+
+#endif
@@ -1,177 +1,1622 @@
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <string.h>
+#include <math.h>
 #include <time.h>
 #include <omp.h>
+#include <pthread.h>
+#ifdef __linux__
+#include <sched.h>
+#include <sys/mman.h>
+#endif
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+#include "render.h"
+#include "float_first.h"
+#include "metrics_c.h"
 
-// Struktur untuk header BMP
-#pragma pack(push, 1)
+// === Iterasi otomatis ===
+// Batas awal ditebak dari kedalaman zoom, lalu pass probe resolusi rendah
+// menggandakan batas selama masih ada pixel yang baru lolos. Berhenti begitu
+// penggandaan berikutnya hampir tidak mengubah gambar.
+#define AUTO_ITER_MIN 64
+#define AUTO_ITER_MAX (1 << 20)
+#define AUTO_PROBE_WIDTH 160
+#define AUTO_CHANGE_THRESHOLD 0.001  // fraksi pixel probe yang boleh berubah
+
+typedef struct {
+    int iterations;       // batas iterasi terpilih
+    int initial_guess;    // tebakan awal dari kedalaman zoom
+    int rounds;           // jumlah putaran penggandaan
+    double unescaped;     // fraksi pixel probe yang belum lolos pada batas terpilih
+    double probe_time;
+} AutoIterResult;
+
+int auto_iterations(int width, int height, double min_real, double max_real,
+                    double min_imag, double max_imag, AutoIterResult* result) {
+    double start = omp_get_wtime();
+    int probe_w = width < AUTO_PROBE_WIDTH ? width : AUTO_PROBE_WIDTH;
+    int probe_h = (int)((long long)probe_w * height / width);
+    if (probe_h < 1) probe_h = 1;
+    int count = probe_w * probe_h;
+
+    // Tebakan awal: tampilan default (lebar 3.5) mendapat AUTO_ITER_MIN,
+    // setiap penggandaan zoom menambah kebutuhan iterasi
+    double zoom = 3.5 / (max_real - min_real);
+    double depth = zoom > 1.0 ? log2(zoom) : 0.0;
+    int guess = (int)(AUTO_ITER_MIN + 50.0 * depth);
+    if (guess > AUTO_ITER_MAX) guess = AUTO_ITER_MAX;
+
+    double* z_real = (double*)calloc(count, sizeof(double));
+    double* z_imag = (double*)calloc(count, sizeof(double));
+    int* iter = (int*)calloc(count, sizeof(int));
+    if (!z_real || !z_imag || !iter) {
+        free(z_real);
+        free(z_imag);
+        free(iter);
+        return 0;
+    }
+
+    double real_scale = (max_real - min_real) / probe_w;
+    double imag_scale = (max_imag - min_imag) / probe_h;
+    int limit = 0;
+    int next = guess;
+    int unescaped = count;
+    int rounds = 0;
+    int max_escape = 0;
+
+    // Setiap putaran melanjutkan pixel yang belum lolos dari batas sebelumnya
+    for (;;) {
+        int still = 0;
+        int deepest = 0;
+        #pragma omp parallel for schedule(dynamic, 1) reduction(+:still) reduction(max:deepest)
+        for (int y = 0; y < probe_h; y++) {
+            for (int x = 0; x < probe_w; x++) {
+                int i = y * probe_w + x;
+                if (iter[i] < limit) continue;  // sudah lolos di putaran sebelumnya
+                double real = min_real + x * real_scale;
+                double imag = min_imag + y * imag_scale;
+                iter[i] = mandelbrot_continue(real, imag, &z_real[i], &z_imag[i], iter[i], next);
+                if (iter[i] == next) still++;
+                else if (iter[i] > deepest) deepest = iter[i];
+            }
+        }
+        if (deepest > max_escape) max_escape = deepest;
+
+        int changed = unescaped - still;
+        rounds++;
+
+        if (limit > 0 && changed <= AUTO_CHANGE_THRESHOLD * count) break;
+        unescaped = still;
+        limit = next;
+        if (unescaped == 0 || limit >= AUTO_ITER_MAX) break;
+        next = limit > AUTO_ITER_MAX / 2 ? AUTO_ITER_MAX : limit * 2;
+    }
+
+    // Tidak ada pixel interior: cukup sedikit di atas orbit terpanjang
+    if (unescaped == 0) {
+        int needed = max_escape + max_escape / 4 + 1;
+        if (needed < limit) limit = needed;
+    }
+    if (limit < AUTO_ITER_MIN) limit = AUTO_ITER_MIN;
+
+    if (result) {
+        result->iterations = limit;
+        result->initial_guess = guess;
+        result->rounds = rounds;
+        result->unescaped = (double)unescaped / count;
+        result->probe_time = omp_get_wtime() - start;
+    }
+
+    free(z_real);
+    free(z_imag);
+    free(iter);
+    return limit;
+}
+
+// Fungsi untuk mengukur waktu
+double get_time() {
+    return omp_get_wtime();
+}
+
+// === Penjadwalan tile berbasis prediksi biaya (LPT) ===
+// Frame berurutan pada animasi/sesi interaktif punya distribusi biaya yang mirip.
+// Total iterasi per tile dari frame sebelumnya dipetakan ke viewport baru, tile
+// diurutkan dari yang termahal (Longest Processing Time first), dan tile murah
+// digabung menjadi chunk agar ekor frame (thread terakhir yang selesai) pendek.
+#define TILE_SIZE 64
+#define LPT_CHUNKS_PER_THREAD 4
+
+// Peta biaya per tile: rata-rata iterasi per pixel pada viewport frame tersebut
 typedef struct {
-    uint16_t type;
-    uint32_t size;
-    uint16_t reserved1;
-    uint16_t reserved2;
-    uint32_t offset;
-} BMPHeader;
+    int tiles_x, tiles_y;
+    double min_real, max_real, min_imag, max_imag;
+    double* cost;
+    int valid;
+} CostMap;
 
 typedef struct {
-    uint32_t size;
-    int32_t width;
-    int32_t height;
-    uint16_t planes;
-    uint16_t bits_per_pixel;
-    uint32_t compression;
-    uint32_t image_size;
-    int32_t x_pixels_per_meter;
-    int32_t y_pixels_per_meter;
-    uint32_t colors_used;
-    uint32_t colors_important;
-} BMPInfoHeader;
-#pragma pack(pop)
-
-// Struktur untuk warna RGB
+    double frame_time;
+    double tail_time;   // waktu dari thread pertama menganggur sampai frame selesai
+    int chunks;
+} TileRenderStats;
+
+int cost_map_init(CostMap* map, int width, int height) {
+    map->tiles_x = (width + TILE_SIZE - 1) / TILE_SIZE;
+    map->tiles_y = (height + TILE_SIZE - 1) / TILE_SIZE;
+    map->cost = (double*)calloc((size_t)map->tiles_x * map->tiles_y, sizeof(double));
+    map->valid = 0;
+    return map->cost != NULL;
+}
+
+void cost_map_free(CostMap* map) {
+    free(map->cost);
+    map->cost = NULL;
+    map->valid = 0;
+}
+
+// Ambil biaya per pixel dari peta frame sebelumnya di titik kompleks (real, imag);
+// titik di luar viewport lama memakai fallback (rata-rata)
+static double sample_cost(const CostMap* prev, double real, double imag, double fallback) {
+    double fx = (real - prev->min_real) / (prev->max_real - prev->min_real) * prev->tiles_x;
+    double fy = (imag - prev->min_imag) / (prev->max_imag - prev->min_imag) * prev->tiles_y;
+    if (fx < 0.0 || fy < 0.0 || fx >= prev->tiles_x || fy >= prev->tiles_y) return fallback;
+    return prev->cost[(int)fy * prev->tiles_x + (int)fx];
+}
+
 typedef struct {
-    uint8_t b, g, r;
-} RGB;
-
-// Fungsi untuk menghitung iterasi Mandelbrot
-int mandelbrot_iterations(double real, double imag, int max_iter) {
-    double z_real = 0.0;
-    double z_imag = 0.0;
-    int iter = 0;
-    
-    while (iter < max_iter && (z_real * z_real + z_imag * z_imag) < 4.0) {
-        double temp = z_real * z_real - z_imag * z_imag + real;
-        z_imag = 2.0 * z_real * z_imag + imag;
-        z_real = temp;
-        iter++;
+    int tile;
+    double cost;
+} TileCost;
+
+static int compare_tile_cost_desc(const void* a, const void* b) {
+    double ca = ((const TileCost*)a)->cost;
+    double cb = ((const TileCost*)b)->cost;
+    if (ca < cb) return 1;
+    if (ca > cb) return -1;
+    return ((const TileCost*)a)->tile - ((const TileCost*)b)->tile;
+}
+
+// Render paralel per tile lewat render_scheduled. prev == NULL atau tidak
+// valid: urutan baris (buta). out (boleh NULL) diisi peta biaya frame ini untuk
+// dipakai frame berikutnya.
+int render_mandelbrot_tiled(const RenderConfig* cfg, RGB* image, int width, int height, int max_iterations,
+                            double min_real, double max_real, double min_imag, double max_imag,
+                            const CostMap* prev, CostMap* out, TileRenderStats* stats) {
+    double start = omp_get_wtime();
+    double real_scale = (max_real - min_real) / width;
+    double imag_scale = (max_imag - min_imag) / height;
+    int tiles_x = (width + TILE_SIZE - 1) / TILE_SIZE;
+    int tiles_y = (height + TILE_SIZE - 1) / TILE_SIZE;
+    int tiles = tiles_x * tiles_y;
+    int threads = cfg->threads > 0 ? cfg->threads : omp_get_max_threads();
+
+    TileCost* order = (TileCost*)malloc(tiles * sizeof(TileCost));
+    int* tile_order = (int*)malloc(tiles * sizeof(int));
+    int* chunk_start = (int*)malloc((tiles + 1) * sizeof(int));
+    double* finish = (double*)malloc(threads * sizeof(double));
+    if (!order || !tile_order || !chunk_start || !finish) {
+        free(order);
+        free(tile_order);
+        free(chunk_start);
+        free(finish);
+        return 0;
     }
-    
-    return iter;
+
+    int chunks = 0;
+    if (prev && prev->valid) {
+        double mean = 0.0;
+        for (int i = 0; i < prev->tiles_x * prev->tiles_y; i++) mean += prev->cost[i];
+        mean /= prev->tiles_x * prev->tiles_y;
+
+        // Prediksi: rata-rata 5 sampel (pusat dan empat kuadran) dikali jumlah pixel
+        double total = 0.0;
+        for (int t = 0; t < tiles; t++) {
+            int x0 = (t % tiles_x) * TILE_SIZE;
+            int y0 = (t / tiles_x) * TILE_SIZE;
+            int tw = width - x0 < TILE_SIZE ? width - x0 : TILE_SIZE;
+            int th = height - y0 < TILE_SIZE ? height - y0 : TILE_SIZE;
+            static const double offsets[5][2] = {{0.5, 0.5}, {0.25, 0.25}, {0.75, 0.25},
+                                                 {0.25, 0.75}, {0.75, 0.75}};
+            double per_pixel = 0.0;
+            for (int k = 0; k < 5; k++) {
+                double real = min_real + (x0 + offsets[k][0] * tw) * real_scale;
+                double imag = min_imag + (y0 + offsets[k][1] * th) * imag_scale;
+                per_pixel += sample_cost(prev, real, imag, mean);
+            }
+            order[t].tile = t;
+            order[t].cost = per_pixel / 5.0 * tw * th;
+            total += order[t].cost;
+        }
+        qsort(order, tiles, sizeof(TileCost), compare_tile_cost_desc);
+
+        // Chunk ala guided: target biaya menyusut seiring sisa pekerjaan, sehingga
+        // tile mahal berdiri sendiri dan ekor frame hanya berisi chunk kecil
+        double remaining = total;
+        double acc = 0.0;
+        for (int i = 0; i < tiles; i++) {
+            if (acc == 0.0) chunk_start[chunks++] = i;
+            acc += order[i].cost;
+            if (acc >= remaining / (threads * LPT_CHUNKS_PER_THREAD)) {
+                remaining -= acc;
+                acc = 0.0;
+            }
+        }
+    } else {
+        for (int t = 0; t < tiles; t++) {
+            order[t].tile = t;
+            order[t].cost = 0.0;
+            chunk_start[chunks++] = t;
+        }
+    }
+    chunk_start[chunks] = tiles;
+    for (int i = 0; i < tiles; i++) tile_order[i] = order[i].tile;
+
+    RenderParams params = {width, height, max_iterations, min_real, max_real, min_imag, max_imag};
+    TileSchedule sched = {TILE_SIZE, TILE_SIZE, tile_order, chunk_start, chunks, 0,
+                          out ? out->cost : NULL, finish};
+    int used = render_scheduled(cfg, &params, &sched, NULL, image);
+    if (!used) {
+        free(order);
+        free(tile_order);
+        free(chunk_start);
+        free(finish);
+        return 0;
+    }
+
+    double first_idle = finish[0];
+    double last_done = finish[0];
+    for (int i = 1; i < used; i++) {
+        if (finish[i] < first_idle) first_idle = finish[i];
+        if (finish[i] > last_done) last_done = finish[i];
+    }
+
+    if (out) {
+        out->min_real = min_real;
+        out->max_real = max_real;
+        out->min_imag = min_imag;
+        out->max_imag = max_imag;
+        out->valid = 1;
+    }
+    if (stats) {
+        stats->frame_time = omp_get_wtime() - start;
+        stats->tail_time = last_done - first_idle;
+        stats->chunks = chunks;
+    }
+
+    free(order);
+    free(tile_order);
+    free(chunk_start);
+    free(finish);
+    return 1;
 }
 
-// Fungsi untuk mengkonversi iterasi ke warna
-RGB get_color(int iterations, int max_iter) {
-    RGB color;
-    
-    if (iterations == max_iter) {
-        // Titik dalam himpunan Mandelbrot (hitam)
-        color.r = 0;
-        color.g = 0;
-        color.b = 0;
+// Benchmark animasi zoom: bandingkan urutan tile buta dengan LPT dari frame sebelumnya
+int run_lpt_benchmark(const RenderConfig* cfg, int width, int height, int max_iterations, int frames,
+                      double center_real, double center_imag) {
+    RGB* image_blind = (RGB*)malloc((size_t)width * height * sizeof(RGB));
+    RGB* image_lpt = (RGB*)malloc((size_t)width * height * sizeof(RGB));
+    CostMap maps[2];
+    int ok_maps = cost_map_init(&maps[0], width, height) & cost_map_init(&maps[1], width, height);
+    if (!image_blind || !image_lpt || !ok_maps) {
+        printf("Error: Gagal mengalokasi memori\n");
+        free(image_blind);
+        free(image_lpt);
+        cost_map_free(&maps[0]);
+        cost_map_free(&maps[1]);
+        return 1;
+    }
+
+    printf("=== BENCHMARK PENJADWALAN TILE (LPT) ===\n");
+    printf("Frame: %d, tile %dx%d, %d thread, backend %s\n", frames, TILE_SIZE, TILE_SIZE,
+           omp_get_max_threads(), cfg->backend->name);
+    printf("%6s %12s %12s %12s %12s %8s\n", "Frame", "Buta(s)", "Ekor buta", "LPT(s)", "Ekor LPT", "Chunk");
+
+    double sum_blind = 0.0, sum_lpt = 0.0, tail_blind = 0.0, tail_lpt = 0.0;
+    double worst_blind = 0.0, worst_lpt = 0.0;
+    int identical = 1;
+    double half_real = 1.75, half_imag = 1.0;
+
+    for (int f = 0; f < frames; f++) {
+        double min_real = center_real - half_real, max_real = center_real + half_real;
+        double min_imag = center_imag - half_imag, max_imag = center_imag + half_imag;
+        CostMap* prev = &maps[f & 1];
+        CostMap* next = &maps[(f + 1) & 1];
+
+        TileRenderStats blind, lpt;
+        if (!render_mandelbrot_tiled(cfg, image_blind, width, height, max_iterations,
+                                     min_real, max_real, min_imag, max_imag, NULL, NULL, &blind) ||
+            !render_mandelbrot_tiled(cfg, image_lpt, width, height, max_iterations,
+                                     min_real, max_real, min_imag, max_imag, prev, next, &lpt)) {
+            printf("Error: Gagal mengalokasi memori\n");
+            identical = 0;
+            break;
+        }
+
+        printf("%6d %12.4f %10.2fms %12.4f %10.2fms %8d\n", f, blind.frame_time,
+               blind.tail_time * 1000.0, lpt.frame_time, lpt.tail_time * 1000.0, lpt.chunks);
+
+        // Frame pertama belum punya peta biaya, tidak dihitung dalam rata-rata
+        if (f > 0) {
+            sum_blind += blind.frame_time;
+            sum_lpt += lpt.frame_time;
+            tail_blind += blind.tail_time;
+            tail_lpt += lpt.tail_time;
+            if (blind.tail_time > worst_blind) worst_blind = blind.tail_time;
+            if (lpt.tail_time > worst_lpt) worst_lpt = lpt.tail_time;
+        }
+        if (memcmp(image_blind, image_lpt, (size_t)width * height * sizeof(RGB)) != 0) identical = 0;
+
+        half_real /= 1.15;
+        half_imag /= 1.15;
+    }
+
+    int counted = frames > 1 ? frames - 1 : 1;
+    printf("\n=== HASIL BENCHMARK ===\n");
+    printf("Rata-rata frame:  buta %.4f detik, LPT %.4f detik\n", sum_blind / counted, sum_lpt / counted);
+    printf("Rata-rata ekor:   buta %.2f ms, LPT %.2f ms\n", tail_blind / counted * 1000.0, tail_lpt / counted * 1000.0);
+    printf("Ekor terburuk:    buta %.2f ms, LPT %.2f ms\n", worst_blind * 1000.0, worst_lpt * 1000.0);
+    if (identical) {
+        printf("✓ Verifikasi: Hasil buta dan LPT identik\n");
     } else {
-        // Gradasi warna berdasarkan iterasi
-        double ratio = (double)iterations / max_iter;
-        
-        // Skema warna biru ke merah
-        if (ratio < 0.5) {
-            color.r = (uint8_t)(255 * ratio * 2);
-            color.g = 0;
-            color.b = (uint8_t)(255 * (1 - ratio * 2));
-        } else {
-            color.r = 255;
-            color.g = (uint8_t)(255 * (ratio - 0.5) * 2);
-            color.b = 0;
+        printf("⚠ Peringatan: Hasil buta dan LPT berbeda\n");
+    }
+
+    free(image_blind);
+    free(image_lpt);
+    cost_map_free(&maps[0]);
+    cost_map_free(&maps[1]);
+    return identical ? 0 : 1;
+}
+
+// === Penempatan buffer NUMA dan pinning thread ===
+// Thread dipin berurutan per node, buffer besar dialokasikan rata ke huge page
+// tanpa disentuh, lalu setiap blok baris di-first-touch oleh thread yang nanti
+// merendernya (jadwal static dengan chunk yang sama untuk touch dan render).
+// Di mesin satu socket atau non-Linux semua langkah tetap aman (tanpa efek).
+#define MAX_NUMA_NODES 64
+#define MAX_CPUS 1024
+#define HUGE_PAGE_SIZE (2 * 1024 * 1024)
+#define SMALL_PAGE_SIZE 4096
+
+typedef struct {
+    int nodes;
+    int cpus;
+    int cpu_list[MAX_CPUS];   // CPU yang boleh dipakai, urut per node
+    int cpu_node[MAX_CPUS];
+} Topology;
+
+#ifdef __linux__
+// Parse daftar CPU format sysfs ("0-11,24-35") ke dalam topologi
+static void parse_cpulist(const char* text, int node, const cpu_set_t* allowed, Topology* topo) {
+    const char* p = text;
+    while (*p && *p != '\n') {
+        char* end;
+        long first = strtol(p, &end, 10);
+        long last = first;
+        if (end == p) break;
+        if (*end == '-') last = strtol(end + 1, &end, 10);
+        for (long cpu = first; cpu <= last && topo->cpus < MAX_CPUS; cpu++) {
+            if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, allowed)) {
+                topo->cpu_list[topo->cpus] = (int)cpu;
+                topo->cpu_node[topo->cpus] = node;
+                topo->cpus++;
+            }
         }
+        p = (*end == ',') ? end + 1 : end;
     }
-    
-    return color;
 }
+#endif
 
-// Fungsi untuk menyimpan gambar BMP
-int save_bmp(const char* filename, RGB* image, int width, int height) {
-    FILE* file = fopen(filename, "wb");
-    if (!file) return 0;
-    
-    // Hitung padding untuk setiap baris (BMP memerlukan padding ke kelipatan 4 byte)
-    int padding = (4 - (width * 3) % 4) % 4;
-    int row_size = width * 3 + padding;
-    
-    // Header BMP
-    BMPHeader header;
-    header.type = 0x4D42; // "BM"
-    header.size = sizeof(BMPHeader) + sizeof(BMPInfoHeader) + row_size * height;
-    header.reserved1 = 0;
-    header.reserved2 = 0;
-    header.offset = sizeof(BMPHeader) + sizeof(BMPInfoHeader);
-    
-    // Info header BMP
-    BMPInfoHeader info;
-    info.size = sizeof(BMPInfoHeader);
-    info.width = width;
-    info.height = height;
-    info.planes = 1;
-    info.bits_per_pixel = 24;
-    info.compression = 0;
-    info.image_size = row_size * height;
-    info.x_pixels_per_meter = 2835; // 72 DPI
-    info.y_pixels_per_meter = 2835;
-    info.colors_used = 0;
-    info.colors_important = 0;
-    
-    // Tulis header
-    fwrite(&header, sizeof(BMPHeader), 1, file);
-    fwrite(&info, sizeof(BMPInfoHeader), 1, file);
-    
-    // Tulis data pixel (BMP menyimpan dari bawah ke atas)
-    uint8_t padding_bytes[3] = {0, 0, 0};
-    for (int y = height - 1; y >= 0; y--) {
-        for (int x = 0; x < width; x++) {
-            RGB pixel = image[y * width + x];
-            fwrite(&pixel, sizeof(RGB), 1, file);
+void detect_topology(Topology* topo) {
+    topo->nodes = 0;
+    topo->cpus = 0;
+#ifdef __linux__
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+        for (int node = 0; node < MAX_NUMA_NODES; node++) {
+            char path[64];
+            char text[4096];
+            snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+            FILE* file = fopen(path, "r");
+            if (!file) continue;
+            int before = topo->cpus;
+            if (fgets(text, sizeof(text), file)) parse_cpulist(text, topo->nodes, &allowed, topo);
+            fclose(file);
+            if (topo->cpus > before) topo->nodes++;
         }
-        if (padding > 0) {
-            fwrite(padding_bytes, padding, 1, file);
+        // Tanpa sysfs NUMA: satu node berisi semua CPU yang diizinkan
+        if (topo->cpus == 0) {
+            for (int cpu = 0; cpu < CPU_SETSIZE && topo->cpus < MAX_CPUS; cpu++) {
+                if (!CPU_ISSET(cpu, &allowed)) continue;
+                topo->cpu_list[topo->cpus] = cpu;
+                topo->cpu_node[topo->cpus] = 0;
+                topo->cpus++;
+            }
         }
     }
-    
+#endif
+    if (topo->cpus == 0) {
+        int procs = omp_get_num_procs();
+        for (int cpu = 0; cpu < procs && cpu < MAX_CPUS; cpu++) {
+            topo->cpu_list[cpu] = cpu;
+            topo->cpu_node[cpu] = 0;
+        }
+        topo->cpus = procs < MAX_CPUS ? procs : MAX_CPUS;
+    }
+    if (topo->nodes == 0) topo->nodes = 1;
+}
+
+// Pin thread OpenMP: thread berurutan mendapat CPU berurutan (per node), sehingga
+// blok baris static yang berdekatan tinggal di node yang sama. Mengembalikan
+// jumlah thread yang berhasil dipin.
+int pin_threads(const Topology* topo) {
+    int pinned = 0;
+#ifdef __linux__
+    #pragma omp parallel reduction(+:pinned)
+    {
+        int t = omp_get_thread_num();
+        int n = omp_get_num_threads();
+        int idx = (int)((long long)t * topo->cpus / n);
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(topo->cpu_list[idx], &set);
+        if (sched_setaffinity(0, sizeof(set), &set) == 0) pinned++;
+    }
+#else
+    (void)topo;
+#endif
+    return pinned;
+}
+
+// Jumlah baris per chunk static: satu page utuh per chunk agar first-touch
+// menempatkan page di node thread pemiliknya. Huge page hanya dipakai jika
+// chunk seukuran huge page masih menyisakan >= 4 chunk per thread untuk load
+// balancing; *use_huge diisi keputusan tersebut.
+int placement_chunk_rows(int width, int height, int* use_huge) {
+    size_t row_bytes = (size_t)width * sizeof(RGB);
+    int threads = omp_get_max_threads();
+    int chunk = (int)((SMALL_PAGE_SIZE + row_bytes - 1) / row_bytes);
+    int huge_chunk = (int)((HUGE_PAGE_SIZE + row_bytes - 1) / row_bytes);
+    *use_huge = (long long)huge_chunk * threads * 4 <= height;
+    if (*use_huge) chunk = huge_chunk;
+    if (chunk < 8) chunk = 8;
+    return chunk;
+}
+
+// Alokasi buffer tanpa menyentuh memori. Jika *huge dan buffer >= 2MB, buffer
+// dirata ke huge page dan ditandai MADV_HUGEPAGE; *huge diisi hasilnya.
+void* alloc_placed_buffer(size_t bytes, int* huge) {
+#ifdef __linux__
+    if (*huge && bytes >= HUGE_PAGE_SIZE) {
+        size_t rounded = (bytes + HUGE_PAGE_SIZE - 1) & ~(size_t)(HUGE_PAGE_SIZE - 1);
+        void* ptr = NULL;
+        if (posix_memalign(&ptr, HUGE_PAGE_SIZE, rounded) == 0) {
+            *huge = madvise(ptr, rounded, MADV_HUGEPAGE) == 0;
+            return ptr;
+        }
+    }
+#endif
+    *huge = 0;
+    return malloc(bytes);
+}
+
+// First-touch: setiap thread menulis nol ke blok baris yang nanti direndernya
+void first_touch_rows(RGB* image, int width, int height, int chunk_rows) {
+    #pragma omp parallel for schedule(static, chunk_rows)
+    for (int y = 0; y < height; y++) {
+        memset(image + (size_t)y * width, 0, (size_t)width * sizeof(RGB));
+    }
+}
+
+// Render dengan jadwal static yang sama persis dengan first_touch_rows: tile
+// satu baris, chunk_rows baris per blok static, jumlah thread bawaan OpenMP
+// (jumlah thread hasil autotune diabaikan agar pemilik blok tidak bergeser)
+int render_mandelbrot_placed(const RenderConfig* cfg, const RenderParams* p, RGB* image, int chunk_rows) {
+    RenderConfig placed = *cfg;
+    placed.threads = 0;
+    TileSchedule sched;
+    memset(&sched, 0, sizeof(sched));
+    sched.tile_w = p->width;
+    sched.tile_h = 1;
+    sched.static_chunk = chunk_rows;
+    return render_scheduled(&placed, p, &sched, NULL, image) > 0;
+}
+
+// Pass baca per blok baris (jadwal static yang sama): mengukur bandwidth memori
+// yang dilihat thread pemilik data, tempat efek penempatan NUMA paling terasa
+static double read_pass_bandwidth(const RGB* image, int width, int height, int chunk_rows, int repeats) {
+    size_t row_bytes = (size_t)width * sizeof(RGB);
+    unsigned long long sum = 0;
+    double start = omp_get_wtime();
+    for (int r = 0; r < repeats; r++) {
+        #pragma omp parallel for schedule(static, chunk_rows) reduction(+:sum)
+        for (int y = 0; y < height; y++) {
+            const uint8_t* row = (const uint8_t*)(image + (size_t)y * width);
+            unsigned long long local = 0;
+            for (size_t i = 0; i + 8 <= row_bytes; i += 8) {
+                uint64_t word;
+                memcpy(&word, row + i, 8);
+                local += word;
+            }
+            sum += local;
+        }
+    }
+    double elapsed = omp_get_wtime() - start;
+    if (sum == 42) printf(" ");  // cegah pass dihapus optimizer
+    return (double)row_bytes * height * repeats / elapsed / 1e9;
+}
+
+// Benchmark pada gambar 4K: kedua sisi menjalankan render_mandelbrot_placed
+// dengan backend dan jadwal static yang sama; yang berbeda hanya alokasi
+// (malloc vs huge page), first-touch (main thread vs pemilik blok), dan pinning
+int run_numa_benchmark(const RenderConfig* cfg, int max_iterations, double min_real, double max_real,
+                       double min_imag, double max_imag) {
+    int width = 3840;
+    int height = 2160;
+    size_t bytes = (size_t)width * height * sizeof(RGB);
+    Topology topo;
+    detect_topology(&topo);
+
+    printf("=== BENCHMARK PENEMPATAN NUMA ===\n");
+    printf("Resolusi: %dx%d pixels (%.1f MB)\n", width, height, bytes / 1e6);
+    printf("Node NUMA: %d, CPU tersedia: %d, thread: %d, backend %s\n", topo.nodes, topo.cpus,
+           omp_get_max_threads(), cfg->backend->name);
+    if (topo.nodes == 1) {
+        printf("Catatan: hanya satu node NUMA, perbedaan yang diharapkan hanya dari pinning/huge page\n");
+    }
+    printf("\n");
+
+    // === Layout saat ini ===
+    RGB* image_default = (RGB*)malloc(bytes);
+    if (!image_default) {
+        printf("Error: Gagal mengalokasi memori\n");
+        return 1;
+    }
+    memset(image_default, 0, bytes);  // first-touch oleh main thread
+    int huge = 0;
+    int chunk = placement_chunk_rows(width, height, &huge);
+
+    RenderParams params = {width, height, max_iterations, min_real, max_real, min_imag, max_imag};
+    double start = omp_get_wtime();
+    if (!render_mandelbrot_placed(cfg, &params, image_default, chunk)) {
+        printf("Error: Gagal mengalokasi memori\n");
+        free(image_default);
+        return 1;
+    }
+    double time_default = omp_get_wtime() - start;
+    double bw_default = read_pass_bandwidth(image_default, width, height, chunk, 20);
+
+    // === Layout NUMA ===
+    int pinned = pin_threads(&topo);
+    start = omp_get_wtime();
+    RGB* image_numa = (RGB*)alloc_placed_buffer(bytes, &huge);
+    if (!image_numa) {
+        printf("Error: Gagal mengalokasi memori\n");
+        free(image_default);
+        return 1;
+    }
+    first_touch_rows(image_numa, width, height, chunk);
+    double time_touch = omp_get_wtime() - start;
+
+    start = omp_get_wtime();
+    if (!render_mandelbrot_placed(cfg, &params, image_numa, chunk)) {
+        printf("Error: Gagal mengalokasi memori\n");
+        free(image_default);
+        free(image_numa);
+        return 1;
+    }
+    double time_numa = omp_get_wtime() - start;
+    double bw_numa = read_pass_bandwidth(image_numa, width, height, chunk, 20);
+
+    printf("Thread dipin: %d, huge page: %s, chunk: %d baris\n", pinned, huge ? "ya" : "tidak", chunk);
+    printf("Alokasi + first-touch: %.3f detik\n", time_touch);
+    printf("\n");
+    printf("%-10s %12s %14s\n", "Layout", "Render(s)", "Baca(GB/s)");
+    printf("%-10s %12.3f %14.2f\n", "default", time_default, bw_default);
+    printf("%-10s %12.3f %14.2f\n", "numa", time_numa, bw_numa);
+    printf("Speedup render: %.2fx, bandwidth: %.2fx\n", time_default / time_numa, bw_numa / bw_default);
+
+    int identical = memcmp(image_default, image_numa, bytes) == 0;
+    if (identical) {
+        printf("✓ Verifikasi: Hasil default dan NUMA identik\n");
+    } else {
+        printf("⚠ Peringatan: Hasil default dan NUMA berbeda\n");
+    }
+
+    free(image_default);
+    free(image_numa);
+    return identical ? 0 : 1;
+}
+
+// === Mode batch ===
+// Banyak viewport dari satu file job dijalankan di satu pool thread OpenMP.
+// Setiap job melewati tahap render (peta iterasi) -> warna -> encode BMP di
+// memori -> tulis file. Tahap setelah render berjalan sebagai task terpisah,
+// sehingga render job N+1 tumpang tindih dengan warna/encode/tulis job N.
+// Buffer diambil dari pool slot yang dipakai ulang, bukan malloc per job.
+#define BATCH_SLOTS 3
+#define BATCH_MAX_PATH 256
+
+typedef struct {
+    char output[BATCH_MAX_PATH];
+    int width, height;
+    int max_iterations;   // 0 = otomatis
+    double min_real, max_real, min_imag, max_imag;
+} BatchJob;
+
+typedef struct {
+    uint32_t* iterations;
+    RGB* image;
+    uint8_t* encoded;
+    size_t pixel_capacity;
+    size_t encoded_capacity;
+} BatchSlot;
+
+typedef struct {
+    double render, color, encode, write;
+    int ok;
+} BatchTiming;
+
+// Metrik batch (metrics_c.h, format Prometheus yang sama dengan viewer):
+// histogram durasi per tahap, job selesai/gagal, pixel, batas iterasi per job,
+// dan job yang sedang di pipeline. Dengan --metrics-file di-dump setelah job
+// selesai (paling sering sekali per BATCH_METRICS_INTERVAL detik) dan di akhir.
+#define BATCH_METRICS_INTERVAL 1.0
+#define BATCH_STAGES 4
+
+typedef struct {
+    CMetricsRegistry registry;
+    CMetric* stage[BATCH_STAGES];   // render, warna, encode, tulis
+    CMetric* jobs_ok;
+    CMetric* jobs_failed;
+    CMetric* pixels;
+    CMetric* iterations;
+    CMetric* in_flight;
+    const char* path;               // NULL = tidak di-dump
+    double last_dump;
+    int dump_failed;
+} BatchMetrics;
+
+static void batch_metrics_init(BatchMetrics* m, const char* path) {
+    static const char* stages[BATCH_STAGES] = {"render", "color", "encode", "write"};
+    double seconds[14], iterations[12];
+    cmetrics_exponential_buckets(seconds, 0.001, 2.0, 14);
+    cmetrics_exponential_buckets(iterations, 64.0, 2.0, 12);
+
+    cmetrics_init(&m->registry);
+    for (int s = 0; s < BATCH_STAGES; s++) {
+        char labels[32];
+        snprintf(labels, sizeof(labels), "stage=\"%s\"", stages[s]);
+        m->stage[s] = cmetrics_histogram(&m->registry, "batch_stage_seconds",
+                                         "Seconds each batch job spent in a stage", labels, seconds, 14);
+    }
+    const char* jobs_help = "Batch jobs finished, by result";
+    m->jobs_ok = cmetrics_counter(&m->registry, "batch_jobs_total", jobs_help, "result=\"ok\"");
+    m->jobs_failed = cmetrics_counter(&m->registry, "batch_jobs_total", jobs_help, "result=\"failed\"");
+    m->pixels = cmetrics_counter(&m->registry, "batch_pixels_total", "Pixels rendered by batch jobs", NULL);
+    m->iterations = cmetrics_histogram(&m->registry, "batch_max_iterations",
+                                       "Iteration limit per batch job after auto selection", NULL,
+                                       iterations, 12);
+    m->in_flight = cmetrics_gauge(&m->registry, "batch_jobs_in_flight",
+                                  "Batch jobs between render start and file write", NULL);
+    m->path = path;
+    m->last_dump = omp_get_wtime();
+    m->dump_failed = 0;
+}
+
+// Dump bila interval sudah lewat (force: selalu); aman dipanggil dari task mana pun
+static void batch_metrics_dump(BatchMetrics* m, int force) {
+    if (!m->path) return;
+    #pragma omp critical(batch_metrics_dump)
+    {
+        double now = omp_get_wtime();
+        if (force || now - m->last_dump >= BATCH_METRICS_INTERVAL) {
+            if (!cmetrics_dump(&m->registry, m->path)) m->dump_failed = 1;
+            m->last_dump = now;
+        }
+    }
+}
+
+// Baca file job. Format per baris (# untuk komentar):
+//   output.bmp lebar tinggi iterasi|auto pusat_real pusat_imag zoom
+// zoom relatif terhadap area default (-2.5..1.0 x -1.0..1.0), rasio aspek
+// mengikuti lebar/tinggi gambar.
+int load_batch_jobs(const char* filename, BatchJob** jobs_out) {
+    FILE* file = fopen(filename, "r");
+    if (!file) return -1;
+
+    int count = 0, capacity = 16;
+    BatchJob* jobs = (BatchJob*)malloc(capacity * sizeof(BatchJob));
+    char line[1024];
+    int line_no = 0;
+
+    while (jobs && fgets(line, sizeof(line), file)) {
+        line_no++;
+        char* p = line;
+        while (*p == ' ' || *p == '\t') p++;
+        if (*p == '#' || *p == '\n' || *p == '\r' || *p == '\0') continue;
+
+        BatchJob job;
+        char iter_text[32];
+        double center_real, center_imag, zoom;
+        if (sscanf(p, "%255s %d %d %31s %lf %lf %lf", job.output, &job.width, &job.height,
+                   iter_text, &center_real, &center_imag, &zoom) != 7 ||
+            job.width <= 0 || job.height <= 0 || zoom <= 0.0) {
+            printf("Error: Baris job %d tidak valid\n", line_no);
+            free(jobs);
+            fclose(file);
+            return -1;
+        }
+        job.max_iterations = strcmp(iter_text, "auto") == 0 ? 0 : atoi(iter_text);
+        if (job.max_iterations < 0) job.max_iterations = 0;
+
+        double half_imag = 1.0 / zoom;
+        double half_real = half_imag * job.width / job.height;
+        job.min_real = center_real - half_real;
+        job.max_real = center_real + half_real;
+        job.min_imag = center_imag - half_imag;
+        job.max_imag = center_imag + half_imag;
+
+        if (count == capacity) {
+            capacity *= 2;
+            BatchJob* grown = (BatchJob*)realloc(jobs, capacity * sizeof(BatchJob));
+            if (!grown) {
+                free(jobs);
+                jobs = NULL;
+                break;
+            }
+            jobs = grown;
+        }
+        jobs[count++] = job;
+    }
+
     fclose(file);
+    if (!jobs) return -1;
+    *jobs_out = jobs;
+    return count;
+}
+
+// Pastikan slot cukup besar untuk job; hanya tumbuh, tidak pernah menyusut
+static int batch_slot_reserve(BatchSlot* slot, const BatchJob* job) {
+    size_t pixels = (size_t)job->width * job->height;
+    size_t encoded = bmp_file_size(job->width, job->height);
+    if (pixels > slot->pixel_capacity) {
+        uint32_t* iterations = (uint32_t*)realloc(slot->iterations, pixels * sizeof(uint32_t));
+        if (iterations) slot->iterations = iterations;
+        RGB* image = (RGB*)realloc(slot->image, pixels * sizeof(RGB));
+        if (image) slot->image = image;
+        if (!iterations || !image) return 0;
+        slot->pixel_capacity = pixels;
+    }
+    if (encoded > slot->encoded_capacity) {
+        uint8_t* bytes = (uint8_t*)realloc(slot->encoded, encoded);
+        if (!bytes) return 0;
+        slot->encoded = bytes;
+        slot->encoded_capacity = encoded;
+    }
+    return 1;
+}
+
+// Tahap render: peta iterasi, baris dibagi menjadi task di pool yang sama dan
+// setiap baris dihitung kernel span backend
+static void batch_render(SpanKernel span, BatchJob* job, BatchSlot* slot) {
+    int width = job->width;
+    int height = job->height;
+    if (job->max_iterations == 0) {
+        AutoIterResult auto_result;
+        job->max_iterations = auto_iterations(width, height, job->min_real, job->max_real,
+                                              job->min_imag, job->max_imag, &auto_result);
+        if (job->max_iterations == 0) job->max_iterations = 1000;
+    }
+    RenderParams params = {width, height, job->max_iterations,
+                           job->min_real, job->max_real, job->min_imag, job->max_imag};
+    uint32_t* iterations = slot->iterations;
+
+    #pragma omp taskloop grainsize(4)
+    for (int y = 0; y < height; y++) {
+        span(&params, y, 0, width, iterations + (size_t)y * width);
+    }
+}
+
+// Tahap warna + encode + tulis untuk satu job (berjalan di satu thread)
+static void batch_output(const BatchJob* job, BatchSlot* slot, BatchTiming* timing, BatchMetrics* metrics) {
+    size_t pixels = (size_t)job->width * job->height;
+
+    double start = omp_get_wtime();
+    for (size_t i = 0; i < pixels; i++) {
+        slot->image[i] = get_color((int)slot->iterations[i], job->max_iterations);
+    }
+    double colored = omp_get_wtime();
+    size_t bytes = encode_bmp(slot->encoded, slot->image, job->width, job->height);
+    double encoded = omp_get_wtime();
+
+    FILE* file = fopen(job->output, "wb");
+    timing->ok = file && fwrite(slot->encoded, 1, bytes, file) == bytes;
+    if (file && fclose(file) != 0) timing->ok = 0;
+    double written = omp_get_wtime();
+
+    timing->color = colored - start;
+    timing->encode = encoded - colored;
+    timing->write = written - encoded;
+
+    cmetric_observe(metrics->stage[0], timing->render);
+    cmetric_observe(metrics->stage[1], timing->color);
+    cmetric_observe(metrics->stage[2], timing->encode);
+    cmetric_observe(metrics->stage[3], timing->write);
+    cmetric_observe(metrics->iterations, job->max_iterations);
+    cmetric_add(timing->ok ? metrics->jobs_ok : metrics->jobs_failed, 1);
+    cmetric_add(metrics->pixels, pixels);
+    cmetric_gauge_add(metrics->in_flight, -1.0);
+    batch_metrics_dump(metrics, 0);
+}
+
+int run_batch(const RenderConfig* cfg, const char* filename, int pipelined, const char* metrics_file) {
+    BatchJob* jobs = NULL;
+    int count = load_batch_jobs(filename, &jobs);
+    if (count < 0) {
+        printf("Error: Gagal membaca file job %s\n", filename);
+        return 1;
+    }
+    if (count == 0) {
+        printf("File job kosong\n");
+        free(jobs);
+        return 0;
+    }
+
+    BatchSlot slots[BATCH_SLOTS];
+    memset(slots, 0, sizeof(slots));
+    char slot_token[BATCH_SLOTS];  // hanya dipakai sebagai alamat dependensi task
+    (void)slot_token;
+    BatchTiming* timing = (BatchTiming*)calloc(count, sizeof(BatchTiming));
+    BatchMetrics* metrics = (BatchMetrics*)malloc(sizeof(BatchMetrics));
+    int reserve_failed = 0;
+    if (!timing || !metrics) {
+        printf("Error: Gagal mengalokasi memori\n");
+        free(timing);
+        free(metrics);
+        free(jobs);
+        return 1;
+    }
+    batch_metrics_init(metrics, metrics_file);
+
+    printf("=== MODE BATCH (%s) ===\n", pipelined ? "pipeline" : "berurutan");
+    printf("Job: %d, slot buffer: %d, thread: %d, backend %s\n", count, BATCH_SLOTS, omp_get_max_threads(),
+           cfg->backend->name);
+    SpanKernel span = render_span_backend(cfg->backend)->span;
+
+    double start = omp_get_wtime();
+    if (pipelined) {
+        #pragma omp parallel
+        #pragma omp single
+        {
+            for (int n = 0; n < count; n++) {
+                int s = n % BATCH_SLOTS;
+                // Render job n menunggu slot s selesai dipakai job n - BATCH_SLOTS
+                #pragma omp task depend(inout: slot_token[s]) firstprivate(n, s)
+                {
+                    double t0 = omp_get_wtime();
+                    cmetric_gauge_add(metrics->in_flight, 1.0);
+                    if (batch_slot_reserve(&slots[s], &jobs[n])) {
+                        batch_render(span, &jobs[n], &slots[s]);
+                    } else {
+                        #pragma omp atomic write
+                        reserve_failed = 1;
+                    }
+                    timing[n].render = omp_get_wtime() - t0;
+                }
+                #pragma omp task depend(inout: slot_token[s]) firstprivate(n, s)
+                {
+                    int skip;
+                    #pragma omp atomic read
+                    skip = reserve_failed;
+                    if (!skip) {
+                        batch_output(&jobs[n], &slots[s], &timing[n], metrics);
+                    } else {
+                        cmetric_add(metrics->jobs_failed, 1);
+                        cmetric_gauge_add(metrics->in_flight, -1.0);
+                    }
+                }
+            }
+        }
+    } else {
+        // Pembanding: satu job per waktu, render paralel lalu warna/encode/tulis
+        for (int n = 0; n < count && !reserve_failed; n++) {
+            double t0 = omp_get_wtime();
+            if (!batch_slot_reserve(&slots[0], &jobs[n])) {
+                reserve_failed = 1;
+                cmetric_add(metrics->jobs_failed, 1);
+                break;
+            }
+            cmetric_gauge_add(metrics->in_flight, 1.0);
+            #pragma omp parallel
+            #pragma omp single
+            batch_render(span, &jobs[n], &slots[0]);
+            timing[n].render = omp_get_wtime() - t0;
+            batch_output(&jobs[n], &slots[0], &timing[n], metrics);
+        }
+    }
+    double total = omp_get_wtime() - start;
+    batch_metrics_dump(metrics, 1);
+
+    double render = 0.0, color = 0.0, encode = 0.0, write = 0.0;
+    double megapixels = 0.0;
+    int failed = 0;
+    for (int n = 0; n < count; n++) {
+        render += timing[n].render;
+        color += timing[n].color;
+        encode += timing[n].encode;
+        write += timing[n].write;
+        megapixels += (double)jobs[n].width * jobs[n].height / 1e6;
+        if (!timing[n].ok) {
+            printf("Error: Gagal menyimpan %s\n", jobs[n].output);
+            failed++;
+        }
+    }
+
+    if (reserve_failed) printf("Error: Gagal mengalokasi buffer job\n");
+    printf("Waktu total: %.3f detik\n", total);
+    printf("Throughput: %.2f job/detik, %.2f Mpixel/detik\n", count / total, megapixels / total);
+    printf("Utilisasi tahap (waktu sibuk / waktu total):\n");
+    printf("  render:  %6.1f%%\n", render / total * 100.0);
+    printf("  warna:   %6.1f%%\n", color / total * 100.0);
+    printf("  encode:  %6.1f%%\n", encode / total * 100.0);
+    printf("  tulis:   %6.1f%%\n", write / total * 100.0);
+    printf("Job berhasil: %d/%d\n", count - failed, count);
+    if (metrics_file) {
+        printf(metrics->dump_failed ? "Error: Gagal menulis metrik ke %s\n" : "Metrik disimpan: %s\n",
+               metrics_file);
+    }
+    int metrics_failed = metrics->dump_failed;
+
+    for (int s = 0; s < BATCH_SLOTS; s++) {
+        free(slots[s].iterations);
+        free(slots[s].image);
+        free(slots[s].encoded);
+    }
+    free(timing);
+    free(metrics);
+    free(jobs);
+    return (failed || reserve_failed || metrics_failed) ? 1 : 0;
+}
+
+// === Checkpoint dan resume per tile ===
+// Render panjang (gigapixel, zoom dalam) menulis tile yang selesai ke journal
+// append-only di disk. Thread render hanya menyalin peta iterasi tile ke antrian;
+// thread penulis mem-flush antrian secara periodik (fwrite + fsync), sehingga
+// I/O tidak pernah menahan render. Dengan --save-z, tile yang sedang berjalan
+// juga menyimpan state z per pixel agar tile yang sangat mahal tidak mulai
+// dari nol. Saat resume, header journal divalidasi terhadap parameter job dan
+// hanya tile yang belum selesai yang dirender ulang.
+#define CHECKPOINT_MAGIC "MBCKPT01"
+#define CHECKPOINT_ITER_SLICE 4096               // iterasi per irisan saat --save-z
+#define CHECKPOINT_FLUSH_BYTES (8u << 20)        // flush lebih awal bila antrian sebesar ini
+#define CHECKPOINT_MAX_PENDING ((size_t)64 << 20) // thread render menunggu di atas batas ini
+
+enum { CKPT_TILE_DONE = 1, CKPT_TILE_PARTIAL = 2 };
+
+typedef struct {
+    char magic[8];
+    int32_t width, height;
+    int32_t max_iterations;
+    int32_t tile_size;
+    double min_real, max_real, min_imag, max_imag;
+} CheckpointHeader;
+
+typedef struct {
+    uint32_t type;
+    uint32_t tile;
+    uint32_t bytes;
+    uint32_t checksum;
+} CheckpointRecordHeader;
+
+typedef struct CheckpointRecord {
+    struct CheckpointRecord* next;
+    CheckpointRecordHeader header;
+    uint8_t payload[];
+} CheckpointRecord;
+
+typedef struct {
+    FILE* file;
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;        // membangunkan penulis
+    pthread_cond_t drained;     // membangunkan thread render yang menunggu ruang antrian
+    CheckpointRecord* head;
+    CheckpointRecord* tail;
+    size_t pending_bytes;
+    double interval;
+    int stopping;
+    // Statistik (hanya ditulis thread penulis)
+    long records;
+    size_t bytes_written;
+    int flushes;
+    double write_time;
+    int failed;
+    int tiles_done;             // tile selesai yang sudah aman di disk
+    int tiles_total;
+} CheckpointJournal;
+
+// FNV-1a 32-bit untuk mendeteksi record yang terpotong saat proses dibunuh
+static uint32_t checkpoint_checksum(const uint8_t* data, size_t len) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        h ^= data[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static void checkpoint_fill_header(CheckpointHeader* h, int width, int height, int max_iterations,
+                                   double min_real, double max_real, double min_imag, double max_imag) {
+    memset(h, 0, sizeof(*h));
+    memcpy(h->magic, CHECKPOINT_MAGIC, sizeof(h->magic));
+    h->width = width;
+    h->height = height;
+    h->max_iterations = max_iterations;
+    h->tile_size = TILE_SIZE;
+    h->min_real = min_real;
+    h->max_real = max_real;
+    h->min_imag = min_imag;
+    h->max_imag = max_imag;
+}
+
+static void checkpoint_tile_rect(int tile, int width, int height, int* x0, int* y0, int* tw, int* th) {
+    int tiles_x = (width + TILE_SIZE - 1) / TILE_SIZE;
+    *x0 = (tile % tiles_x) * TILE_SIZE;
+    *y0 = (tile / tiles_x) * TILE_SIZE;
+    *tw = width - *x0 < TILE_SIZE ? width - *x0 : TILE_SIZE;
+    *th = height - *y0 < TILE_SIZE ? height - *y0 : TILE_SIZE;
+}
+
+static void checkpoint_color_tile(RGB* image, const int32_t* iter, int tile, int width, int height,
+                                  int max_iterations) {
+    int x0, y0, tw, th;
+    checkpoint_tile_rect(tile, width, height, &x0, &y0, &tw, &th);
+    for (int y = 0; y < th; y++) {
+        for (int x = 0; x < tw; x++) {
+            image[(size_t)(y0 + y) * width + x0 + x] = get_color(iter[y * tw + x], max_iterations);
+        }
+    }
+}
+
+static void* checkpoint_writer(void* arg) {
+    CheckpointJournal* j = (CheckpointJournal*)arg;
+    pthread_mutex_lock(&j->lock);
+    for (;;) {
+        if (!j->stopping && j->pending_bytes < CHECKPOINT_FLUSH_BYTES) {
+            struct timespec deadline;
+            clock_gettime(CLOCK_REALTIME, &deadline);
+            double whole = floor(j->interval);
+            deadline.tv_sec += (time_t)whole;
+            deadline.tv_nsec += (long)((j->interval - whole) * 1e9);
+            if (deadline.tv_nsec >= 1000000000L) {
+                deadline.tv_sec++;
+                deadline.tv_nsec -= 1000000000L;
+            }
+            while (!j->stopping && j->pending_bytes < CHECKPOINT_FLUSH_BYTES &&
+                   pthread_cond_timedwait(&j->wake, &j->lock, &deadline) == 0) {
+            }
+        }
+
+        CheckpointRecord* list = j->head;
+        j->head = j->tail = NULL;
+        j->pending_bytes = 0;
+        int stopping = j->stopping;
+        pthread_cond_broadcast(&j->drained);
+        pthread_mutex_unlock(&j->lock);
+
+        if (list) {
+            double start = get_time();
+            int done = 0;
+            while (list) {
+                CheckpointRecord* rec = list;
+                list = rec->next;
+                if (!j->failed &&
+                    (fwrite(&rec->header, sizeof(rec->header), 1, j->file) != 1 ||
+                     fwrite(rec->payload, 1, rec->header.bytes, j->file) != rec->header.bytes)) {
+                    j->failed = 1;
+                }
+                if (rec->header.type == CKPT_TILE_DONE) done++;
+                j->records++;
+                j->bytes_written += sizeof(rec->header) + rec->header.bytes;
+                free(rec);
+            }
+            if (fflush(j->file) != 0) j->failed = 1;
+#ifndef _WIN32
+            fsync(fileno(j->file));
+#endif
+            j->flushes++;
+            j->write_time += get_time() - start;
+            if (!j->failed) {
+                j->tiles_done += done;
+                printf("Checkpoint: %d/%d tile tersimpan\n", j->tiles_done, j->tiles_total);
+                fflush(stdout);
+            }
+        }
+
+        pthread_mutex_lock(&j->lock);
+        if (stopping && !j->head) break;
+    }
+    pthread_mutex_unlock(&j->lock);
+    return NULL;
+}
+
+static int checkpoint_start(CheckpointJournal* j, FILE* file, double interval, int tiles_done, int tiles_total) {
+    memset(j, 0, sizeof(*j));
+    j->file = file;
+    j->interval = interval;
+    j->tiles_done = tiles_done;
+    j->tiles_total = tiles_total;
+    pthread_mutex_init(&j->lock, NULL);
+    pthread_cond_init(&j->wake, NULL);
+    pthread_cond_init(&j->drained, NULL);
+    if (pthread_create(&j->thread, NULL, checkpoint_writer, j) != 0) {
+        pthread_mutex_destroy(&j->lock);
+        pthread_cond_destroy(&j->wake);
+        pthread_cond_destroy(&j->drained);
+        return 0;
+    }
     return 1;
 }
 
-// Versi serial untuk rendering Mandelbrot
-void render_mandelbrot_serial(RGB* image, int width, int height, int max_iterations,
-                             double min_real, double max_real, double min_imag, double max_imag) {
+// Salin payload (sampai tiga bagian berurutan) ke antrian penulis. Dipanggil
+// dari thread render; hanya memblokir bila disk tertinggal jauh.
+static int checkpoint_submit(CheckpointJournal* j, uint32_t type, int tile,
+                             const void* a, size_t a_bytes, const void* b, size_t b_bytes,
+                             const void* c, size_t c_bytes) {
+    size_t bytes = a_bytes + b_bytes + c_bytes;
+    CheckpointRecord* rec = (CheckpointRecord*)malloc(sizeof(CheckpointRecord) + bytes);
+    if (!rec) return 0;
+    rec->next = NULL;
+    memcpy(rec->payload, a, a_bytes);
+    if (b_bytes) memcpy(rec->payload + a_bytes, b, b_bytes);
+    if (c_bytes) memcpy(rec->payload + a_bytes + b_bytes, c, c_bytes);
+    rec->header.type = type;
+    rec->header.tile = (uint32_t)tile;
+    rec->header.bytes = (uint32_t)bytes;
+    rec->header.checksum = checkpoint_checksum(rec->payload, bytes);
+
+    pthread_mutex_lock(&j->lock);
+    while (j->pending_bytes > CHECKPOINT_MAX_PENDING && !j->failed) {
+        pthread_cond_signal(&j->wake);
+        pthread_cond_wait(&j->drained, &j->lock);
+    }
+    if (j->tail) {
+        j->tail->next = rec;
+    } else {
+        j->head = rec;
+    }
+    j->tail = rec;
+    j->pending_bytes += sizeof(rec->header) + bytes;
+    if (j->pending_bytes >= CHECKPOINT_FLUSH_BYTES) pthread_cond_signal(&j->wake);
+    pthread_mutex_unlock(&j->lock);
+    return 1;
+}
+
+// Hentikan penulis setelah antrian terakhir di-flush ke disk
+static void checkpoint_stop(CheckpointJournal* j) {
+    pthread_mutex_lock(&j->lock);
+    j->stopping = 1;
+    pthread_cond_signal(&j->wake);
+    pthread_mutex_unlock(&j->lock);
+    pthread_join(j->thread, NULL);
+    pthread_mutex_destroy(&j->lock);
+    pthread_cond_destroy(&j->wake);
+    pthread_cond_destroy(&j->drained);
+}
+
+// Baca journal yang ada: validasi header, warnai tile selesai ke image, dan
+// simpan state z terakhir tile yang belum selesai. Record terpotong di akhir
+// file (proses dibunuh di tengah tulis) dibuang. Mengembalikan offset akhir
+// record valid, atau -1 bila journal tidak cocok dengan job.
+static long checkpoint_load(FILE* file, const CheckpointHeader* expected, RGB* image,
+                            uint8_t* done, uint8_t** partial, int* tiles_done) {
+    CheckpointHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1) {
+        printf("Error: Journal checkpoint kosong atau rusak\n");
+        return -1;
+    }
+    if (memcmp(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic)) != 0) {
+        printf("Error: File bukan journal checkpoint\n");
+        return -1;
+    }
+    if (memcmp(&header, expected, sizeof(header)) != 0) {
+        printf("Error: Parameter job berbeda dengan journal (journal: %dx%d, iterasi %d, "
+               "real %.17g..%.17g, imag %.17g..%.17g)\n",
+               header.width, header.height, header.max_iterations,
+               header.min_real, header.max_real, header.min_imag, header.max_imag);
+        return -1;
+    }
+
+    int width = header.width, height = header.height;
+    int tiles = ((width + TILE_SIZE - 1) / TILE_SIZE) * ((height + TILE_SIZE - 1) / TILE_SIZE);
+    size_t max_payload = (size_t)TILE_SIZE * TILE_SIZE * (sizeof(int32_t) + 2 * sizeof(double));
+    uint8_t* payload = (uint8_t*)malloc(max_payload);
+    if (!payload) return -1;
+
+    long valid_end = (long)sizeof(header);
+    *tiles_done = 0;
+    CheckpointRecordHeader rec;
+    while (fread(&rec, sizeof(rec), 1, file) == 1) {
+        int x0, y0, tw, th;
+        if (rec.tile >= (uint32_t)tiles) break;
+        checkpoint_tile_rect((int)rec.tile, width, height, &x0, &y0, &tw, &th);
+        size_t n = (size_t)tw * th;
+        size_t expected_bytes = rec.type == CKPT_TILE_DONE
+            ? n * sizeof(int32_t) : n * (sizeof(int32_t) + 2 * sizeof(double));
+        if ((rec.type != CKPT_TILE_DONE && rec.type != CKPT_TILE_PARTIAL) || rec.bytes != expected_bytes) break;
+        if (fread(payload, 1, rec.bytes, file) != rec.bytes) break;
+        if (checkpoint_checksum(payload, rec.bytes) != rec.checksum) break;
+        valid_end += (long)(sizeof(rec) + rec.bytes);
+
+        if (rec.type == CKPT_TILE_DONE) {
+            if (!done[rec.tile]) (*tiles_done)++;
+            done[rec.tile] = 1;
+            free(partial[rec.tile]);
+            partial[rec.tile] = NULL;
+            checkpoint_color_tile(image, (const int32_t*)payload, (int)rec.tile, width, height,
+                                  header.max_iterations);
+        } else if (!done[rec.tile]) {
+            uint8_t* state = (uint8_t*)realloc(partial[rec.tile], rec.bytes);
+            if (!state) {
+                free(payload);
+                return -1;
+            }
+            memcpy(state, payload, rec.bytes);
+            partial[rec.tile] = state;
+        }
+    }
+
+    free(payload);
+    return valid_end;
+}
+
+typedef struct {
+    double render_time;
+    double submit_time;     // total waktu thread render di checkpoint_submit
+    int tiles_rendered;
+    int partial_records;
+    int failed;
+} CheckpointRenderStats;
+
+// Render tile yang belum selesai. Tanpa save_z setiap tile dihitung dalam satu
+// pass oleh kernel span backend; dengan save_z (atau tile yang punya state z
+// tersimpan) tile diiterasi per irisan CHECKPOINT_ITER_SLICE lewat
+// mandelbrot_continue dan state z disimpan paling sering sekali per interval.
+// Kernel span tidak bisa melanjutkan orbit dari z tersimpan, jadi jalur irisan
+// tetap skalar; hasilnya identik dengan backend exact karena orbitnya sama.
+void render_mandelbrot_checkpointed(const RenderConfig* cfg, RGB* image, int width, int height,
+                                    int max_iterations,
+                                    double min_real, double max_real, double min_imag, double max_imag,
+                                    const int* todo, int todo_count, uint8_t** partial,
+                                    CheckpointJournal* journal, int save_z,
+                                    CheckpointRenderStats* stats) {
+    RenderParams params = {width, height, max_iterations, min_real, max_real, min_imag, max_imag};
+    SpanKernel span = render_span_backend(cfg->backend)->span;
     double real_scale = (max_real - min_real) / width;
     double imag_scale = (max_imag - min_imag) / height;
-    
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            double real = min_real + x * real_scale;
-            double imag = min_imag + y * imag_scale;
-            
-            int iterations = mandelbrot_iterations(real, imag, max_iterations);
-            image[y * width + x] = get_color(iterations, max_iterations);
+    double submit_time = 0.0;
+    int partial_records = 0;
+    int failed = 0;
+    double start = get_time();
+
+    #pragma omp parallel reduction(+:submit_time, partial_records, failed)
+    {
+        size_t max_n = (size_t)TILE_SIZE * TILE_SIZE;
+        int32_t* iter = (int32_t*)malloc(max_n * sizeof(int32_t));
+        double* zr = (double*)malloc(max_n * sizeof(double));
+        double* zi = (double*)malloc(max_n * sizeof(double));
+        int ok = iter && zr && zi;
+
+        #pragma omp for schedule(dynamic, 1)
+        for (int k = 0; k < todo_count; k++) {
+            if (!ok) {
+                failed = 1;
+                continue;
+            }
+            int tile = todo[k];
+            int x0, y0, tw, th;
+            checkpoint_tile_rect(tile, width, height, &x0, &y0, &tw, &th);
+            size_t n = (size_t)tw * th;
+
+            if (!save_z && !partial[tile]) {
+                // Satu pass penuh: tidak ada state z yang perlu dilanjutkan atau disimpan
+                for (int y = 0; y < th; y++) {
+                    span(&params, y0 + y, x0, x0 + tw, (uint32_t*)iter + (size_t)y * tw);
+                }
+            } else {
+                // Mulai dari state z tersimpan (resume) atau dari nol
+                int limit = 0;
+                if (partial[tile]) {
+                    memcpy(iter, partial[tile], n * sizeof(int32_t));
+                    memcpy(zr, partial[tile] + n * sizeof(int32_t), n * sizeof(double));
+                    memcpy(zi, partial[tile] + n * (sizeof(int32_t) + sizeof(double)), n * sizeof(double));
+                    for (size_t i = 0; i < n; i++) {
+                        if (iter[i] > limit) limit = iter[i];
+                    }
+                } else {
+                    memset(iter, 0, n * sizeof(int32_t));
+                    memset(zr, 0, n * sizeof(double));
+                    memset(zi, 0, n * sizeof(double));
+                }
+
+                double last_snapshot = get_time();
+                for (;;) {
+                    limit = save_z && max_iterations - limit > CHECKPOINT_ITER_SLICE
+                        ? limit + CHECKPOINT_ITER_SLICE : max_iterations;
+                    int active = 0;
+                    for (int y = 0; y < th; y++) {
+                        double imag = min_imag + (y0 + y) * imag_scale;
+                        for (int x = 0; x < tw; x++) {
+                            size_t i = (size_t)y * tw + x;
+                            double real = min_real + (x0 + x) * real_scale;
+                            iter[i] = mandelbrot_continue(real, imag, &zr[i], &zi[i], iter[i], limit);
+                            if (iter[i] == limit && zr[i] * zr[i] + zi[i] * zi[i] < 4.0) active++;
+                        }
+                    }
+                    if (limit >= max_iterations || active == 0) break;
+
+                    double now = get_time();
+                    if (now - last_snapshot >= journal->interval) {
+                        if (!checkpoint_submit(journal, CKPT_TILE_PARTIAL, tile,
+                                               iter, n * sizeof(int32_t), zr, n * sizeof(double),
+                                               zi, n * sizeof(double))) {
+                            failed = 1;
+                        }
+                        partial_records++;
+                        last_snapshot = get_time();
+                        submit_time += last_snapshot - now;
+                    }
+                }
+            }
+
+            checkpoint_color_tile(image, iter, tile, width, height, max_iterations);
+            double submit_start = get_time();
+            if (!checkpoint_submit(journal, CKPT_TILE_DONE, tile, iter, n * sizeof(int32_t),
+                                   NULL, 0, NULL, 0)) {
+                failed = 1;
+            }
+            submit_time += get_time() - submit_start;
+        }
+
+        free(iter);
+        free(zr);
+        free(zi);
+    }
+
+    stats->render_time = get_time() - start;
+    stats->submit_time = submit_time;
+    stats->tiles_rendered = todo_count;
+    stats->partial_records = partial_records;
+    stats->failed = failed;
+}
+
+// Render dengan journal checkpoint. Tanpa resume journal baru dibuat (menolak
+// menimpa journal yang sudah ada); dengan resume journal dibaca, divalidasi,
+// dipotong di record valid terakhir, lalu dilanjutkan.
+int run_checkpointed_render(const RenderConfig* cfg, int width, int height, int max_iterations,
+                            double min_real, double max_real, double min_imag, double max_imag,
+                            const char* path, int resume, int save_z, double interval) {
+    int tiles_x = (width + TILE_SIZE - 1) / TILE_SIZE;
+    int tiles_y = (height + TILE_SIZE - 1) / TILE_SIZE;
+    int tiles = tiles_x * tiles_y;
+
+    CheckpointHeader header;
+    checkpoint_fill_header(&header, width, height, max_iterations, min_real, max_real, min_imag, max_imag);
+
+    RGB* image = (RGB*)calloc((size_t)width * height, sizeof(RGB));
+    uint8_t* done = (uint8_t*)calloc(tiles, 1);
+    uint8_t** partial = (uint8_t**)calloc(tiles, sizeof(uint8_t*));
+    int* todo = (int*)malloc(tiles * sizeof(int));
+    if (!image || !done || !partial || !todo) {
+        printf("Error: Gagal mengalokasi memori\n");
+        free(image);
+        free(done);
+        free(partial);
+        free(todo);
+        return 1;
+    }
+
+    int status = 1;
+    int tiles_done = 0;
+    FILE* file = NULL;
+    if (resume) {
+        file = fopen(path, "r+b");
+        if (!file) {
+            printf("Error: Journal %s tidak bisa dibuka\n", path);
+            goto cleanup;
+        }
+        long valid_end = checkpoint_load(file, &header, image, done, partial, &tiles_done);
+        if (valid_end < 0) goto cleanup;
+        fflush(file);
+#ifdef _WIN32
+        _chsize(_fileno(file), valid_end);
+#else
+        if (ftruncate(fileno(file), valid_end) != 0) {
+            printf("Error: Gagal memotong journal %s\n", path);
+            goto cleanup;
+        }
+#endif
+        fseek(file, valid_end, SEEK_SET);
+        int partial_tiles = 0;
+        for (int t = 0; t < tiles; t++) {
+            if (partial[t]) partial_tiles++;
         }
+        printf("Resume: %d/%d tile selesai, %d tile dengan state z tersimpan\n",
+               tiles_done, tiles, partial_tiles);
+    } else {
+        file = fopen(path, "rb");
+        if (file) {
+            printf("Error: Journal %s sudah ada; pakai --resume atau hapus file tersebut\n", path);
+            goto cleanup;
+        }
+        file = fopen(path, "wb");
+        if (!file || fwrite(&header, sizeof(header), 1, file) != 1 || fflush(file) != 0) {
+            printf("Error: Gagal membuat journal %s\n", path);
+            goto cleanup;
+        }
+    }
+
+    int todo_count = 0;
+    for (int t = 0; t < tiles; t++) {
+        if (!done[t]) todo[todo_count++] = t;
+    }
+    printf("Checkpoint: journal %s, interval %.1f detik, state z: %s, %d tile dirender, backend %s\n",
+           path, interval, save_z ? "ya" : "tidak", todo_count, save_z ? "scalar" : cfg->backend->name);
+
+    CheckpointJournal journal;
+    if (!checkpoint_start(&journal, file, interval, tiles_done, tiles)) {
+        printf("Error: Gagal memulai thread penulis checkpoint\n");
+        goto cleanup;
+    }
+    CheckpointRenderStats stats;
+    render_mandelbrot_checkpointed(cfg, image, width, height, max_iterations,
+                                   min_real, max_real, min_imag, max_imag,
+                                   todo, todo_count, partial, &journal, save_z, &stats);
+    double drain_start = get_time();
+    checkpoint_stop(&journal);
+    double drain_time = get_time() - drain_start;
+
+    printf("Waktu render: %.3f detik (%d tile, %d snapshot state z)\n",
+           stats.render_time, stats.tiles_rendered, stats.partial_records);
+    printf("Journal: %ld record, %.1f MB, %d flush, tulis %.3f detik di thread penulis\n",
+           journal.records, journal.bytes_written / 1e6, journal.flushes, journal.write_time);
+    printf("Overhead di thread render: %.3f detik (%.2f%%), flush akhir %.3f detik\n",
+           stats.submit_time, stats.render_time > 0 ?
+           100.0 * stats.submit_time / (stats.render_time * omp_get_max_threads()) : 0.0,
+           drain_time);
+    if (stats.failed || journal.failed) {
+        printf("Error: Gagal menulis journal checkpoint\n");
+        goto cleanup;
+    }
+
+    if (!save_bmp("mandelbrot_parallel.bmp", image, width, height)) {
+        printf("Error: Gagal menyimpan gambar paralel\n");
+        goto cleanup;
     }
+    printf("Gambar paralel disimpan: mandelbrot_parallel.bmp\n");
+    status = 0;
+
+cleanup:
+    if (file) fclose(file);
+    for (int t = 0; t < tiles; t++) free(partial[t]);
+    free(partial);
+    free(done);
+    free(todo);
+    free(image);
+    return status;
 }
 
-// Versi paralel untuk rendering Mandelbrot menggunakan OpenMP
-void render_mandelbrot_parallel(RGB* image, int width, int height, int max_iterations,
-                               double min_real, double max_real, double min_imag, double max_imag) {
+// === Float dulu, double selektif ===
+// Bandingkan render double penuh dengan render dua pass (float_first.h) pada
+// viewport yang sama: waktu, fraksi pixel yang dihitung ulang, dan selisih
+// peta iterasi terhadap double.
+int run_float_first_benchmark(int width, int height, int max_iterations,
+                              double min_real, double max_real, double min_imag, double max_imag) {
+    long pixels = (long)width * height;
+    uint32_t* reference = (uint32_t*)malloc(pixels * sizeof(uint32_t));
+    uint32_t* fast = (uint32_t*)malloc(pixels * sizeof(uint32_t));
+    RGB* image = (RGB*)malloc(pixels * sizeof(RGB));
+    int status = 1;
+
+    if (!reference || !fast || !image) {
+        printf("Error: Gagal mengalokasi memori\n");
+        goto cleanup;
+    }
+
     double real_scale = (max_real - min_real) / width;
     double imag_scale = (max_imag - min_imag) / height;
-    
-    // Paralelisasi loop berdasarkan baris (y)
-    // Setiap thread akan mengerjakan beberapa baris
+
+    printf("Menjalankan versi PARALEL double...\n");
+    double start = get_time();
     #pragma omp parallel for schedule(dynamic, 1)
     for (int y = 0; y < height; y++) {
         for (int x = 0; x < width; x++) {
-            double real = min_real + x * real_scale;
-            double imag = min_imag + y * imag_scale;
-            
-            int iterations = mandelbrot_iterations(real, imag, max_iterations);
-            image[y * width + x] = get_color(iterations, max_iterations);
+            reference[(long)y * width + x] = (uint32_t)mandelbrot_iterations(min_real + x * real_scale,
+                                                                              min_imag + y * imag_scale,
+                                                                              max_iterations);
         }
     }
+    double time_double = get_time() - start;
+    printf("Waktu double: %.3f detik\n\n", time_double);
+
+    printf("Menjalankan versi FLOAT DULU...\n");
+    FloatFirstStats stats;
+    start = get_time();
+    if (!render_float_first(fast, width, height, max_iterations, min_real, max_real, min_imag, max_imag,
+                            mandelbrot_iterations, &stats)) {
+        printf("Error: Gagal mengalokasi memori\n");
+        goto cleanup;
+    }
+    double time_fast = get_time() - start;
+    if (stats.all_double) {
+        printf("Jarak pixel di bawah resolusi float: seluruh frame dihitung dalam double\n");
+    } else {
+        printf("Pass float (%s): %.3f detik\n", stats.kernel, stats.float_time);
+    }
+    printf("Pass double: %.3f detik, %ld pixel dihitung ulang (%.2f%%)\n",
+           stats.refine_time, stats.refined, 100.0 * stats.refined / stats.pixels);
+    printf("Waktu float dulu: %.3f detik\n\n", time_fast);
+
+    long differ = 0, beyond = 0;
+    uint32_t max_diff = 0;
+    for (long i = 0; i < pixels; i++) {
+        uint32_t diff = fast[i] > reference[i] ? fast[i] - reference[i] : reference[i] - fast[i];
+        if (diff) differ++;
+        if (diff > 2) beyond++;
+        if (diff > max_diff) max_diff = diff;
+    }
+
+    for (long i = 0; i < pixels; i++) {
+        image[i] = get_color((int)fast[i], max_iterations);
+    }
+    if (!save_bmp("mandelbrot_parallel.bmp", image, width, height)) {
+        printf("Error: Gagal menyimpan gambar paralel\n");
+        goto cleanup;
+    }
+    printf("Gambar paralel disimpan: mandelbrot_parallel.bmp\n\n");
+
+    printf("=== HASIL FLOAT DULU ===\n");
+    printf("Waktu double:      %.3f detik\n", time_double);
+    printf("Waktu float dulu:  %.3f detik\n", time_fast);
+    printf("Speedup:           %.2fx\n", time_double / time_fast);
+    printf("Dihitung ulang:    %.2f%% pixel\n", 100.0 * stats.refined / stats.pixels);
+    printf("Beda dari double:  %ld pixel (%.4f%%), %ld lebih dari 2 iterasi, maks %u\n",
+           differ, 100.0 * differ / pixels, beyond, max_diff);
+
+    // Toleransi sama dengan backend float-first di golden.c
+    if (beyond <= pixels / 200) {
+        printf("✓ Verifikasi: Hasil float dulu dalam toleransi terhadap double\n");
+        status = 0;
+    } else {
+        printf("⚠ Peringatan: Hasil float dulu melewati toleransi terhadap double\n");
+    }
+
+cleanup:
+    free(reference);
+    free(fast);
+    free(image);
+    return status;
 }
 
-// Fungsi untuk mengukur waktu
-double get_time() {
-    return omp_get_wtime();
+static void print_usage(const char* program) {
+    printf("Penggunaan: %s [--auto-iter] [--view pusat_real pusat_imag zoom] [--lpt-bench frame]\n"
+           "       [--numa] [--numa-bench] [--batch file_job [--sequential] [--metrics-file file]]\n"
+           "       [--size lebar tinggi] [--iter n] [--float-first]\n"
+           "       [--backend nama [--tile n] [--threads n]] [--retune] [--list-backends]\n"
+           "       [--checkpoint journal [--resume] [--save-z] [--checkpoint-interval detik]]\n", program);
 }
 
-int main() {
+int main(int argc, char** argv) {
     // Parameter yang bisa diubah
     int width = 1920;
     int height = 1080;
@@ -183,15 +1628,225 @@ int main() {
     double min_imag = -1.0;
     double max_imag = 1.0;
     
+    int auto_iter = 0;
+    int lpt_frames = 0;
+    int numa = 0;
+    int numa_bench = 0;
+    const char* batch_file = NULL;
+    int batch_pipelined = 1;
+    const char* metrics_file = NULL;
+    const char* checkpoint_file = NULL;
+    int resume = 0;
+    int save_z = 0;
+    double checkpoint_interval = 5.0;
+    int float_first = 0;
+    const char* backend_name = NULL;
+    int tile_size = 0;
+    int threads = 0;
+    int retune = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--auto-iter") == 0) {
+            auto_iter = 1;
+        } else if (strcmp(argv[i], "--iter") == 0 && i + 1 < argc) {
+            max_iterations = atoi(argv[++i]);
+            if (max_iterations <= 0) {
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--size") == 0 && i + 2 < argc) {
+            width = atoi(argv[++i]);
+            height = atoi(argv[++i]);
+            if (width <= 0 || height <= 0) {
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--checkpoint") == 0 && i + 1 < argc) {
+            checkpoint_file = argv[++i];
+        } else if (strcmp(argv[i], "--resume") == 0) {
+            resume = 1;
+        } else if (strcmp(argv[i], "--save-z") == 0) {
+            save_z = 1;
+        } else if (strcmp(argv[i], "--checkpoint-interval") == 0 && i + 1 < argc) {
+            checkpoint_interval = atof(argv[++i]);
+            if (checkpoint_interval <= 0.0) {
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--float-first") == 0) {
+            float_first = 1;
+        } else if (strcmp(argv[i], "--backend") == 0 && i + 1 < argc) {
+            backend_name = argv[++i];
+        } else if (strcmp(argv[i], "--tile") == 0 && i + 1 < argc) {
+            tile_size = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--retune") == 0) {
+            retune = 1;
+        } else if (strcmp(argv[i], "--list-backends") == 0) {
+            for (int b = 0; b < render_backend_count(); b++) {
+                const RenderBackend* be = render_backend_at(b);
+                printf("%-12s %-9s %s\n", be->name, be->available() ? "tersedia" : "-", be->description);
+            }
+            return 0;
+        } else if (strcmp(argv[i], "--batch") == 0 && i + 1 < argc) {
+            batch_file = argv[++i];
+        } else if (strcmp(argv[i], "--sequential") == 0) {
+            batch_pipelined = 0;
+        } else if (strcmp(argv[i], "--metrics-file") == 0 && i + 1 < argc) {
+            metrics_file = argv[++i];
+        } else if (strcmp(argv[i], "--numa") == 0) {
+            numa = 1;
+        } else if (strcmp(argv[i], "--numa-bench") == 0) {
+            numa_bench = 1;
+        } else if (strcmp(argv[i], "--lpt-bench") == 0 && i + 1 < argc) {
+            lpt_frames = atoi(argv[++i]);
+            if (lpt_frames <= 0) {
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--view") == 0 && i + 3 < argc) {
+            // Zoom relatif terhadap area default, rasio aspek dipertahankan
+            double center_real = atof(argv[++i]);
+            double center_imag = atof(argv[++i]);
+            double zoom = atof(argv[++i]);
+            if (zoom <= 0.0) {
+                print_usage(argv[0]);
+                return 1;
+            }
+            double half_real = (max_real - min_real) / (2.0 * zoom);
+            double half_imag = (max_imag - min_imag) / (2.0 * zoom);
+            min_real = center_real - half_real;
+            max_real = center_real + half_real;
+            min_imag = center_imag - half_imag;
+            max_imag = center_imag + half_imag;
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    
+    if (((resume || save_z) && !checkpoint_file) || (metrics_file && !batch_file)) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    if (tile_size < 0 || threads < 0 || ((tile_size || threads) && !backend_name)) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    const RenderBackend* chosen = NULL;
+    if (backend_name) {
+        chosen = find_render_backend(backend_name);
+        if (!chosen || !chosen->available()) {
+            printf("Error: Backend %s tidak dikenal atau tidak didukung CPU ini (lihat --list-backends)\n",
+                   backend_name);
+            return 1;
+        }
+    }
+    // Jadwal milik mode di bawah (first-touch, chunk LPT, task batch) memakai
+    // jumlah thread bawaan OpenMP, jadi --threads diterapkan di sana juga
+    if (threads > 0) omp_set_num_threads(threads);
+    // Mode dengan jadwal sendiri: kernel span backend pilihan, atau backend
+    // span exact terlebar bila tidak dipilih / backend frame-only
+    RenderConfig mode_cfg = {render_span_backend(chosen), 0, 0};
+    
+    // Mode batch memakai parameter dari file job, bukan dari main()
+    if (batch_file) {
+        return run_batch(&mode_cfg, batch_file, batch_pipelined, metrics_file);
+    }
+    
     printf("=== BENCHMARK MANDELBROT SET RENDERING ===\n");
     printf("Resolusi: %dx%d pixels\n", width, height);
+    
+    if (auto_iter) {
+        AutoIterResult auto_result;
+        if (!auto_iterations(width, height, min_real, max_real, min_imag, max_imag, &auto_result)) {
+            printf("Error: Gagal mengalokasi memori\n");
+            return 1;
+        }
+        max_iterations = auto_result.iterations;
+        printf("Iterasi otomatis: tebakan %d -> %d (%d putaran, %.2f%% probe belum lolos, %.3f detik)\n",
+               auto_result.initial_guess, max_iterations, auto_result.rounds,
+               auto_result.unescaped * 100.0, auto_result.probe_time);
+    }
+    
     printf("Max iterasi: %d\n", max_iterations);
     printf("Jumlah thread tersedia: %d\n", omp_get_max_threads());
     printf("\n");
     
+    // Animasi zoom menuju pusat viewport untuk benchmark penjadwalan
+    if (lpt_frames > 0) {
+        return run_lpt_benchmark(&mode_cfg, width, height, max_iterations, lpt_frames,
+                                 (min_real + max_real) / 2.0, (min_imag + max_imag) / 2.0);
+    }
+    if (numa_bench) {
+        return run_numa_benchmark(&mode_cfg, max_iterations, min_real, max_real, min_imag, max_imag);
+    }
+    // Render panjang dengan journal: hanya versi paralel, tanpa pembanding serial
+    if (checkpoint_file) {
+        return run_checkpointed_render(&mode_cfg, width, height, max_iterations,
+                                       min_real, max_real, min_imag, max_imag,
+                                       checkpoint_file, resume, save_z, checkpoint_interval);
+    }
+    if (float_first) {
+        return run_float_first_benchmark(width, height, max_iterations,
+                                         min_real, max_real, min_imag, max_imag);
+    }
+    
+    // Backend paralel: pilihan eksplisit, atau konfigurasi hasil autotune
+    // (di-benchmark sekali per mesin dan kelas scene, lalu dibaca dari cache)
+    RenderParams params = {width, height, max_iterations, min_real, max_real, min_imag, max_imag};
+    RenderConfig serial_cfg = {find_render_backend("scalar"), 0, 1};
+    RenderConfig parallel_cfg = {chosen, tile_size, threads};
+    if (!chosen) {
+        AutotuneInfo tune;
+        if (!autotune_select(&params, retune, &parallel_cfg, &tune)) {
+            printf("Error: Autotune gagal\n");
+            return 1;
+        }
+        if (tune.from_cache) {
+            printf("Autotune: kelas %s dari cache %s\n", tune.scene_class, tune.cache_path);
+        } else {
+            printf("Autotune: kelas %s, %d konfigurasi diukur dalam %.2f detik, disimpan ke %s\n",
+                   tune.scene_class, tune.candidates, tune.tune_time, tune.cache_path);
+        }
+    }
+    int parallel_threads = omp_get_max_threads();
+    if (!numa) {
+        const RenderBackend* be = parallel_cfg.backend;
+        if (be->parallel && parallel_cfg.threads > 0) parallel_threads = parallel_cfg.threads;
+        if (!be->parallel) parallel_threads = be->frame ? omp_get_max_threads() : 1;
+        char tile_text[32];
+        if (parallel_cfg.tile_size > 0) {
+            snprintf(tile_text, sizeof(tile_text), "tile %dx%d", parallel_cfg.tile_size, parallel_cfg.tile_size);
+        } else {
+            snprintf(tile_text, sizeof(tile_text), "per baris");
+        }
+        printf("Backend paralel: %s, %s, %d thread\n\n", be->name, be->parallel ? tile_text : "-",
+               parallel_threads);
+    }
+    
     // Alokasi memori untuk gambar
     RGB* image_serial = (RGB*)malloc(width * height * sizeof(RGB));
-    RGB* image_parallel = (RGB*)malloc(width * height * sizeof(RGB));
+    RGB* image_parallel;
+    int numa_chunk = 0;
+    if (numa) {
+        // Buffer paralel: huge page, first-touch oleh thread yang dipin
+        Topology topo;
+        detect_topology(&topo);
+        int pinned = pin_threads(&topo);
+        int huge = 0;
+        numa_chunk = placement_chunk_rows(width, height, &huge);
+        image_parallel = (RGB*)alloc_placed_buffer((size_t)width * height * sizeof(RGB), &huge);
+        if (image_parallel) {
+            first_touch_rows(image_parallel, width, height, numa_chunk);
+        }
+        printf("NUMA: %d node, %d thread dipin, huge page: %s, chunk: %d baris, backend %s\n",
+               topo.nodes, pinned, huge ? "ya" : "tidak", numa_chunk,
+               render_span_backend(parallel_cfg.backend)->name);
+        printf("\n");
+    } else {
+        image_parallel = (RGB*)malloc(width * height * sizeof(RGB));
+    }
     
     if (!image_serial || !image_parallel) {
         printf("Error: Gagal mengalokasi memori\n");
@@ -204,8 +1859,7 @@ int main() {
     printf("Menjalankan versi SERIAL...\n");
     double start_serial = get_time();
     
-    render_mandelbrot_serial(image_serial, width, height, max_iterations,
-                           min_real, max_real, min_imag, max_imag);
+    int rendered = render_image(&serial_cfg, &params, image_serial);
     
     double end_serial = get_time();
     double time_serial = end_serial - start_serial;
@@ -225,12 +1879,22 @@ int main() {
     printf("Menjalankan versi PARALEL...\n");
     double start_parallel = get_time();
     
-    render_mandelbrot_parallel(image_parallel, width, height, max_iterations,
-                              min_real, max_real, min_imag, max_imag);
+    if (numa) {
+        rendered = rendered && render_mandelbrot_placed(&parallel_cfg, &params, image_parallel, numa_chunk);
+    } else {
+        rendered = rendered && render_image(&parallel_cfg, &params, image_parallel);
+    }
     
     double end_parallel = get_time();
     double time_parallel = end_parallel - start_parallel;
     
+    if (!rendered) {
+        printf("Error: Gagal mengalokasi memori\n");
+        free(image_serial);
+        free(image_parallel);
+        return 1;
+    }
+    
     printf("Waktu paralel: %.3f detik\n", time_parallel);
     
     // Simpan hasil paralel
@@ -244,14 +1908,16 @@ int main() {
     
     // === ANALISIS PERFORMA ===
     double speedup = time_serial / time_parallel;
-    double efficiency = speedup / omp_get_max_threads() * 100;
+    // Backend SIMD mempercepat per thread juga, jadi speedup/thread bisa jauh
+    // di atas 1x dan bukan efisiensi paralel
+    double speedup_per_thread = speedup / parallel_threads;
     
     printf("=== HASIL BENCHMARK ===\n");
     printf("Waktu serial:    %.3f detik\n", time_serial);
     printf("Waktu paralel:   %.3f detik\n", time_parallel);
     printf("Speedup:         %.2fx\n", speedup);
-    printf("Efisiensi:       %.1f%%\n", efficiency);
-    printf("Thread digunakan: %d\n", omp_get_max_threads());
+    printf("Speedup/thread:  %.2fx\n", speedup_per_thread);
+    printf("Thread digunakan: %d\n", parallel_threads);
     
     if (speedup > 1.0) {
         printf("✓ Paralelisasi berhasil mempercepat proses!\n");
@@ -271,6 +1937,9 @@ int main() {
     
     if (identical) {
         printf("✓ Verifikasi: Hasil serial dan paralel identik\n");
+    } else if (!numa && !parallel_cfg.backend->exact) {
+        printf("⚠ Peringatan: Hasil serial dan paralel berbeda (backend %s tidak exact)\n",
+               parallel_cfg.backend->name);
     } else {
         printf("⚠ Peringatan: Hasil serial dan paralel berbeda\n");
     }
@@ -0,0 +1,469 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <omp.h>
+#include "perturb.h"
+
+// === Bilangan fixed point presisi tinggi ===
+// Limb 32 bit little-endian: limb[n-1] bagian bulat, limb[0..n-2] pecahan,
+// tanda terpisah. Nilai di sini tidak pernah melewati |z|^2 < 16, jadi satu
+// limb bagian bulat sudah cukup. n dipilih dari kedalaman zoom.
+#define MP_MAX_LIMBS 40            // ~1250 bit, cukup untuk DEEP_MAX_ZOOM
+#define MP_GUARD_BITS 64           // bit di bawah resolusi pixel
+
+typedef struct {
+    int neg;
+    uint32_t limb[MP_MAX_LIMBS];
+} MpReal;
+
+static void mp_zero(MpReal* r) {
+    memset(r, 0, sizeof(*r));
+}
+
+static int mp_cmp_mag(const MpReal* a, const MpReal* b, int n) {
+    for (int i = n - 1; i >= 0; i--) {
+        if (a->limb[i] != b->limb[i]) return a->limb[i] > b->limb[i] ? 1 : -1;
+    }
+    return 0;
+}
+
+// r boleh sama dengan a atau b: setiap limb dibaca sebelum ditulis
+static void mp_add_mag(MpReal* r, const MpReal* a, const MpReal* b, int n) {
+    uint64_t carry = 0;
+    for (int i = 0; i < n; i++) {
+        uint64_t t = (uint64_t)a->limb[i] + b->limb[i] + carry;
+        r->limb[i] = (uint32_t)t;
+        carry = t >> 32;
+    }
+}
+
+// |a| >= |b|
+static void mp_sub_mag(MpReal* r, const MpReal* a, const MpReal* b, int n) {
+    int64_t borrow = 0;
+    for (int i = 0; i < n; i++) {
+        int64_t t = (int64_t)a->limb[i] - b->limb[i] - borrow;
+        borrow = t < 0;
+        r->limb[i] = (uint32_t)(t + (borrow << 32));
+    }
+}
+
+static void mp_add(MpReal* r, const MpReal* a, const MpReal* b, int n) {
+    if (a->neg == b->neg) {
+        int neg = a->neg;
+        mp_add_mag(r, a, b, n);
+        r->neg = neg;
+    } else if (mp_cmp_mag(a, b, n) >= 0) {
+        int neg = a->neg;
+        mp_sub_mag(r, a, b, n);
+        r->neg = neg;
+    } else {
+        int neg = b->neg;
+        mp_sub_mag(r, b, a, n);
+        r->neg = neg;
+    }
+}
+
+static void mp_sub(MpReal* r, const MpReal* a, const MpReal* b, int n) {
+    MpReal nb = *b;
+    nb.neg = !nb.neg;
+    mp_add(r, a, &nb, n);
+}
+
+// Perkalian schoolbook penuh, lalu geser n-1 limb (satu skala pecahan);
+// bit di bawah limb[0] dibuang
+static void mp_mul(MpReal* r, const MpReal* a, const MpReal* b, int n) {
+    uint32_t prod[2 * MP_MAX_LIMBS];
+    memset(prod, 0, sizeof(uint32_t) * 2 * n);
+    for (int i = 0; i < n; i++) {
+        uint64_t carry = 0;
+        uint64_t ai = a->limb[i];
+        if (!ai) continue;
+        for (int j = 0; j < n; j++) {
+            uint64_t t = ai * b->limb[j] + prod[i + j] + carry;
+            prod[i + j] = (uint32_t)t;
+            carry = t >> 32;
+        }
+        prod[i + n] = (uint32_t)carry;
+    }
+    r->neg = a->neg ^ b->neg;
+    memcpy(r->limb, prod + n - 1, sizeof(uint32_t) * n);
+}
+
+// r = r / d (d kecil), dari limb teratas ke bawah
+static void mp_div_small(MpReal* r, uint32_t d, int n) {
+    uint64_t rem = 0;
+    for (int i = n - 1; i >= 0; i--) {
+        uint64_t t = (rem << 32) | r->limb[i];
+        r->limb[i] = (uint32_t)(t / d);
+        rem = t % d;
+    }
+}
+
+static double mp_to_double(const MpReal* a, int n) {
+    double x = 0.0;
+    for (int i = 0; i < n; i++) {
+        x += ldexp((double)a->limb[i], 32 * (i - (n - 1)));
+    }
+    return a->neg ? -x : x;
+}
+
+// Setiap digit double diambil utuh: sisa r - digit * 2^k selalu exact
+static void mp_from_double(MpReal* r, double d, int n) {
+    double mag = fabs(d);
+    mp_zero(r);
+    r->neg = d < 0.0;
+    for (int i = n - 1; i >= 0 && mag > 0.0; i--) {
+        int shift = 32 * ((n - 1) - i);
+        double digit = floor(ldexp(mag, shift));
+        r->limb[i] = (uint32_t)digit;
+        mag -= ldexp(digit, -shift);
+    }
+}
+
+// Format: [-]digit[.digit]; pecahan dibangun dari digit terakhir:
+// f = (digit + f) / 10
+static int mp_from_string(MpReal* r, const char* s, int n) {
+    mp_zero(r);
+    if (*s == '-' || *s == '+') r->neg = *s++ == '-';
+
+    uint64_t integer = 0;
+    int digits = 0;
+    for (; *s >= '0' && *s <= '9'; s++, digits++) {
+        integer = integer * 10 + (uint64_t)(*s - '0');
+        if (integer >= (1u << 31)) return 0;
+    }
+    const char* frac = NULL;
+    size_t frac_len = 0;
+    if (*s == '.') {
+        frac = ++s;
+        for (; *s >= '0' && *s <= '9'; s++) frac_len++;
+        digits += (int)frac_len;
+    }
+    if (*s != '\0' || digits == 0) return 0;
+
+    for (size_t k = frac_len; k > 0; k--) {
+        r->limb[n - 1] = (uint32_t)(frac[k - 1] - '0');
+        mp_div_small(r, 10, n);
+    }
+    r->limb[n - 1] = (uint32_t)integer;
+    return 1;
+}
+
+int deep_valid_coordinate(const char* s) {
+    MpReal r;
+    return s && mp_from_string(&r, s, 2);
+}
+
+// === View ===
+typedef struct {
+    int limbs;
+    MpReal center_real, center_imag;
+    double scale_real, scale_imag;      // lebar satu pixel
+    double dc_max;                      // |dc| terbesar di viewport
+} DeepSetup;
+
+static int deep_setup(const DeepView* v, DeepSetup* s) {
+    if (v->width <= 0 || v->height <= 0 || v->max_iterations <= 0) return 0;
+    if (!(v->span_real > 0.0) || !(v->span_imag > 0.0)) return 0;
+    if (3.5 / v->span_real > DEEP_MAX_ZOOM || 2.0 / v->span_imag > DEEP_MAX_ZOOM) return 0;
+
+    s->scale_real = v->span_real / v->width;
+    s->scale_imag = v->span_imag / v->height;
+    double finest = fmin(s->scale_real, s->scale_imag);
+    int bits = (int)ceil(-log2(finest)) + MP_GUARD_BITS;
+    if (bits < MP_GUARD_BITS) bits = MP_GUARD_BITS;
+    s->limbs = 1 + (bits + 31) / 32;
+    if (s->limbs > MP_MAX_LIMBS) return 0;
+
+    s->dc_max = 0.5 * hypot(v->span_real, v->span_imag);
+    return mp_from_string(&s->center_real, v->center_real, s->limbs) &&
+           mp_from_string(&s->center_imag, v->center_imag, s->limbs);
+}
+
+// Offset pixel dari pusat, sama dengan min + x * scale di render.c
+static void deep_pixel_offset(const DeepView* v, const DeepSetup* s, int x, int y,
+                              double* dc_real, double* dc_imag) {
+    *dc_real = (x - 0.5 * v->width) * s->scale_real;
+    *dc_imag = (y - 0.5 * v->height) * s->scale_imag;
+}
+
+// === Orbit referensi ===
+// Z_0..Z_len dalam double; len = iterasi saat referensi lolos, atau max
+typedef struct {
+    double* zr;
+    double* zi;
+    int len;
+} RefOrbit;
+
+static int reference_orbit(const DeepSetup* s, int max_iter, RefOrbit* o) {
+    int n = s->limbs;
+    o->zr = (double*)malloc(((size_t)max_iter + 1) * sizeof(double));
+    o->zi = (double*)malloc(((size_t)max_iter + 1) * sizeof(double));
+    if (!o->zr || !o->zi) {
+        free(o->zr);
+        free(o->zi);
+        return 0;
+    }
+
+    MpReal zr, zi, zr2, zi2, zri;
+    mp_zero(&zr);
+    mp_zero(&zi);
+    o->zr[0] = 0.0;
+    o->zi[0] = 0.0;
+    int k = 0;
+    while (k < max_iter && o->zr[k] * o->zr[k] + o->zi[k] * o->zi[k] < 4.0) {
+        mp_mul(&zr2, &zr, &zr, n);
+        mp_mul(&zi2, &zi, &zi, n);
+        mp_mul(&zri, &zr, &zi, n);
+        mp_sub(&zr, &zr2, &zi2, n);
+        mp_add(&zr, &zr, &s->center_real, n);
+        mp_add(&zi, &zri, &zri, n);
+        mp_add(&zi, &zi, &s->center_imag, n);
+        k++;
+        o->zr[k] = mp_to_double(&zr, n);
+        o->zi[k] = mp_to_double(&zi, n);
+    }
+    o->len = k;
+    return 1;
+}
+
+// === Tabel BLA ===
+// Level 0, entri j: satu langkah dari Z_m (m = j + 1), A = 2 Z_m, B = 1.
+// delta^2 diabaikan selama |delta| < eps |2 Z_m|; R juga dibatasi 2 - |Z_m|
+// agar pixel pasti belum lolos di titik-titik yang dilompati.
+// Level k, entri j: gabungan entri 2j dan 2j+1 level k-1 (2^k langkah):
+//   A = Ay Ax,  B = Ay Bx + By,  R = min(Rx, (Ry - |Bx| |dc|max) / |Ax|)
+#define BLA_EPSILON 0x1p-53
+#define BLA_MAX_LEVELS 31
+
+typedef struct {
+    double ar, ai;
+    double br, bi;
+    double r2;                  // R^2; 0 = tidak pernah sah
+} BlaStep;
+
+typedef struct {
+    BlaStep* level[BLA_MAX_LEVELS];
+    int count[BLA_MAX_LEVELS];
+    int levels;
+    long entries;
+} BlaTable;
+
+static void bla_free(BlaTable* t) {
+    for (int k = 0; k < t->levels; k++) free(t->level[k]);
+    t->levels = 0;
+}
+
+static int bla_build(const RefOrbit* o, double dc_max, BlaTable* t) {
+    memset(t, 0, sizeof(*t));
+    int count = o->len - 1;
+    if (count < 1) return 1;
+
+    t->level[0] = (BlaStep*)malloc((size_t)count * sizeof(BlaStep));
+    if (!t->level[0]) return 0;
+    t->count[0] = count;
+    t->levels = 1;
+    t->entries = count;
+    for (int j = 0; j < count; j++) {
+        double zr = o->zr[j + 1];
+        double zi = o->zi[j + 1];
+        double mag = hypot(zr, zi);
+        double r = fmin(BLA_EPSILON * 2.0 * mag, fmax(0.0, 2.0 - mag));
+        BlaStep* b = &t->level[0][j];
+        b->ar = 2.0 * zr;
+        b->ai = 2.0 * zi;
+        b->br = 1.0;
+        b->bi = 0.0;
+        b->r2 = r * r;
+    }
+
+    while (t->levels < BLA_MAX_LEVELS && t->count[t->levels - 1] >= 2) {
+        int k = t->levels;
+        int n = t->count[k - 1] / 2;
+        const BlaStep* src = t->level[k - 1];
+        BlaStep* dst = (BlaStep*)malloc((size_t)n * sizeof(BlaStep));
+        if (!dst) {
+            bla_free(t);
+            return 0;
+        }
+        #pragma omp parallel for schedule(static)
+        for (int j = 0; j < n; j++) {
+            const BlaStep* x = &src[2 * j];
+            const BlaStep* y = &src[2 * j + 1];
+            BlaStep* z = &dst[j];
+            z->ar = y->ar * x->ar - y->ai * x->ai;
+            z->ai = y->ar * x->ai + y->ai * x->ar;
+            z->br = y->ar * x->br - y->ai * x->bi + y->br;
+            z->bi = y->ar * x->bi + y->ai * x->br + y->bi;
+            double rx = sqrt(x->r2);
+            double ry = sqrt(y->r2);
+            double ax = hypot(x->ar, x->ai);
+            double r = ax > 0.0 ? fmax(0.0, (ry - hypot(x->br, x->bi) * dc_max) / ax) : 0.0;
+            r = fmin(rx, r);
+            z->r2 = r * r;
+        }
+        t->level[k] = dst;
+        t->count[k] = n;
+        t->levels++;
+        t->entries += n;
+    }
+    return 1;
+}
+
+// === Iterasi per pixel ===
+typedef struct {
+    long long steps;
+    long long skipped;
+    long long rebases;
+} PixelCounters;
+
+static uint32_t deep_pixel(const RefOrbit* o, const BlaTable* t, double dcr, double dci,
+                           int max_iter, PixelCounters* pc) {
+    double dr = 0.0;
+    double di = 0.0;
+    int m = 0;
+    int n = 0;
+
+    while (n < max_iter) {
+        double zr = o->zr[m] + dr;
+        double zi = o->zi[m] + di;
+        double z2 = zr * zr + zi * zi;
+        if (z2 >= 4.0) break;
+
+        // Rebase: orbit penuh lebih dekat ke nol daripada delta, atau referensi habis
+        double d2 = dr * dr + di * di;
+        if (z2 < d2 || m == o->len) {
+            dr = zr;
+            di = zi;
+            d2 = z2;
+            m = 0;
+            pc->rebases++;
+        }
+
+        // Lompatan terpanjang yang sah. Level k hanya berawal di m - 1 kelipatan
+        // 2^k, dan R blok gabungan tidak lebih besar dari R paruh pertamanya,
+        // jadi cukup naik level sampai blok pertama yang tidak sah. Satu
+        // langkah (level 0) lebih murah dihitung biasa di bawah.
+        if (t && m > 0) {
+            const BlaStep* hit = NULL;
+            int hit_level = 0;
+            for (int k = 1; k < t->levels && !((m - 1) & ((1 << k) - 1)); k++) {
+                int j = (m - 1) >> k;
+                if (j >= t->count[k] || n + (1 << k) > max_iter) break;
+                if (!(d2 < t->level[k][j].r2)) break;
+                hit = &t->level[k][j];
+                hit_level = k;
+            }
+            if (hit) {
+                double nr = hit->ar * dr - hit->ai * di + hit->br * dcr - hit->bi * dci;
+                double ni = hit->ar * di + hit->ai * dr + hit->br * dci + hit->bi * dcr;
+                dr = nr;
+                di = ni;
+                m += 1 << hit_level;
+                n += 1 << hit_level;
+                pc->steps++;
+                pc->skipped += (1 << hit_level) - 1;
+                continue;
+            }
+        }
+
+        // delta' = (2 Z + delta) delta + dc
+        double tr = 2.0 * o->zr[m] + dr;
+        double ti = 2.0 * o->zi[m] + di;
+        double nr = tr * dr - ti * di + dcr;
+        double ni = tr * di + ti * dr + dci;
+        dr = nr;
+        di = ni;
+        m++;
+        n++;
+        pc->steps++;
+    }
+    return (uint32_t)n;
+}
+
+int render_deep(const DeepView* v, int use_bla, int threads, uint32_t* out, DeepStats* stats) {
+    DeepSetup s;
+    memset(stats, 0, sizeof(*stats));
+    if (!deep_setup(v, &s)) return 0;
+    stats->precision_bits = 32 * (s.limbs - 1);
+    if (threads <= 0) threads = omp_get_max_threads();
+
+    double start = omp_get_wtime();
+    RefOrbit orbit;
+    if (!reference_orbit(&s, v->max_iterations, &orbit)) return 0;
+    stats->reference_length = orbit.len;
+    stats->reference_time = omp_get_wtime() - start;
+
+    BlaTable table;
+    memset(&table, 0, sizeof(table));
+    start = omp_get_wtime();
+    if (use_bla && !bla_build(&orbit, s.dc_max, &table)) {
+        free(orbit.zr);
+        free(orbit.zi);
+        return 0;
+    }
+    stats->bla_levels = table.levels;
+    stats->bla_entries = table.entries;
+    stats->table_time = omp_get_wtime() - start;
+
+    long long iterations = 0, steps = 0, skipped = 0, rebases = 0;
+    start = omp_get_wtime();
+    #pragma omp parallel for schedule(dynamic, 1) num_threads(threads) \
+        reduction(+:iterations, steps, skipped, rebases)
+    for (int y = 0; y < v->height; y++) {
+        PixelCounters pc = {0, 0, 0};
+        for (int x = 0; x < v->width; x++) {
+            double dcr, dci;
+            deep_pixel_offset(v, &s, x, y, &dcr, &dci);
+            uint32_t it = deep_pixel(&orbit, use_bla ? &table : NULL, dcr, dci, v->max_iterations, &pc);
+            out[(size_t)y * v->width + x] = it;
+            iterations += it;
+        }
+        steps += pc.steps;
+        skipped += pc.skipped;
+        rebases += pc.rebases;
+    }
+    stats->render_time = omp_get_wtime() - start;
+    stats->iterations = iterations;
+    stats->steps = steps;
+    stats->bla_skipped = skipped;
+    stats->rebases = rebases;
+
+    bla_free(&table);
+    free(orbit.zr);
+    free(orbit.zi);
+    return 1;
+}
+
+int deep_pixel_exact(const DeepView* v, int x, int y) {
+    DeepSetup s;
+    if (!deep_setup(v, &s)) return -1;
+    int n = s.limbs;
+
+    double dcr, dci;
+    deep_pixel_offset(v, &s, x, y, &dcr, &dci);
+    MpReal cr, ci, offset;
+    mp_from_double(&offset, dcr, n);
+    mp_add(&cr, &s.center_real, &offset, n);
+    mp_from_double(&offset, dci, n);
+    mp_add(&ci, &s.center_imag, &offset, n);
+
+    MpReal zr, zi, zr2, zi2, zri;
+    mp_zero(&zr);
+    mp_zero(&zi);
+    int iter = 0;
+    while (iter < v->max_iterations) {
+        mp_mul(&zr2, &zr, &zr, n);
+        mp_mul(&zi2, &zi, &zi, n);
+        if (mp_to_double(&zr2, n) + mp_to_double(&zi2, n) >= 4.0) break;
+        mp_mul(&zri, &zr, &zi, n);
+        mp_sub(&zr, &zr2, &zi2, n);
+        mp_add(&zr, &zr, &cr, n);
+        mp_add(&zi, &zri, &zri, n);
+        mp_add(&zi, &zi, &ci, n);
+        iter++;
+    }
+    return iter;
+}
@@ -0,0 +1,70 @@
+#ifndef PERTURB_H
+#define PERTURB_H
+
+#include <stdint.h>
+
+// === Deep zoom: perturbasi + BLA ===
+// Di bawah zoom ~1e13 jarak antar pixel lebih kecil dari resolusi double,
+// jadi kernel biasa tidak bisa dipakai. Satu orbit referensi di pusat
+// viewport dihitung dalam presisi tinggi (fixed point multi-limb), lalu
+// setiap pixel hanya mengiterasi selisihnya terhadap referensi dalam double:
+//   delta' = 2 Z delta + delta^2 + dc
+// Bila orbit pixel mendekati nol lebih dekat dari delta-nya (glitch) atau
+// referensi sudah habis, delta di-rebase ke orbit penuh dan referensi
+// diulang dari awal.
+//
+// Di atas itu, tabel BLA (bivariate linear approximation) menggabungkan
+// langkah-langkah berurutan menjadi satu pemetaan linier
+//   delta_{m+l} = A delta_m + B dc,   sah selama |delta_m| < R
+// dalam pohon biner (panjang 1, 2, 4, ...). Selama delta masih kecil, pixel
+// melompati ribuan iterasi sekaligus; jumlah iterasi yang dilaporkan tetap
+// sama seperti iterasi satu per satu.
+
+#define DEEP_MAX_ZOOM 1e290     // delta disimpan dalam double (tanpa eksponen tambahan)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    const char* center_real;    // desimal presisi penuh, mis. "-0.74364388703715870475"
+    const char* center_imag;
+    double span_real;           // lebar dan tinggi viewport di bidang kompleks
+    double span_imag;
+    int width, height;
+    int max_iterations;
+} DeepView;
+
+typedef struct {
+    int precision_bits;         // presisi orbit referensi
+    int reference_length;       // iterasi referensi (sampai lolos atau max)
+    int bla_levels;
+    long bla_entries;
+    long long iterations;       // total iterasi yang dilaporkan semua pixel
+    long long steps;            // langkah yang benar-benar dihitung (perturbasi + lompatan BLA)
+    long long bla_skipped;      // iterasi yang dilompati lewat BLA
+    long long rebases;
+    double reference_time;      // detik
+    double table_time;
+    double render_time;
+} DeepStats;
+
+// 1 bila s desimal yang sah ([-]digit[.digit]) dan |nilai| < 2^31
+int deep_valid_coordinate(const char* s);
+
+// Peta iterasi (uint32 per pixel) dengan koordinat pixel yang sama seperti
+// render.c: c = pusat + (x - width/2) * span_real / width, dst.
+// use_bla = 0: perturbasi biasa, setiap iterasi dihitung (pembanding).
+// threads = 0: omp_get_max_threads(). Mengembalikan 0 bila koordinat tidak
+// sah, zoom di luar DEEP_MAX_ZOOM, atau alokasi gagal.
+int render_deep(const DeepView* v, int use_bla, int threads, uint32_t* out, DeepStats* stats);
+
+// Iterasi satu pixel seluruhnya dalam presisi tinggi, tanpa perturbasi.
+// Lambat; dipakai untuk memverifikasi sampel pixel. -1 bila view tidak sah.
+int deep_pixel_exact(const DeepView* v, int x, int y);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,607 @@
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <omp.h>
+#include "render.h"
+#include "float_first.h"
+#include "perturb.h"
+
+// === BMP ===
+size_t bmp_file_size(int width, int height) {
+    size_t row_size = (size_t)width * 3 + (4 - (width * 3) % 4) % 4;
+    return sizeof(BMPHeader) + sizeof(BMPInfoHeader) + row_size * height;
+}
+
+static void bmp_headers(BMPHeader* header, BMPInfoHeader* info, int width, int height) {
+    // Hitung padding untuk setiap baris (BMP memerlukan padding ke kelipatan 4 byte)
+    int padding = (4 - (width * 3) % 4) % 4;
+    int row_size = width * 3 + padding;
+
+    // Header BMP
+    header->type = 0x4D42; // "BM"
+    header->size = sizeof(BMPHeader) + sizeof(BMPInfoHeader) + row_size * height;
+    header->reserved1 = 0;
+    header->reserved2 = 0;
+    header->offset = sizeof(BMPHeader) + sizeof(BMPInfoHeader);
+
+    // Info header BMP
+    info->size = sizeof(BMPInfoHeader);
+    info->width = width;
+    info->height = height;
+    info->planes = 1;
+    info->bits_per_pixel = 24;
+    info->compression = 0;
+    info->image_size = row_size * height;
+    info->x_pixels_per_meter = 2835; // 72 DPI
+    info->y_pixels_per_meter = 2835;
+    info->colors_used = 0;
+    info->colors_important = 0;
+}
+
+// Fungsi untuk menyimpan gambar BMP
+int save_bmp(const char* filename, const RGB* image, int width, int height) {
+    FILE* file = fopen(filename, "wb");
+    if (!file) return 0;
+
+    int padding = (4 - (width * 3) % 4) % 4;
+    BMPHeader header;
+    BMPInfoHeader info;
+    bmp_headers(&header, &info, width, height);
+
+    // Tulis header
+    fwrite(&header, sizeof(BMPHeader), 1, file);
+    fwrite(&info, sizeof(BMPInfoHeader), 1, file);
+
+    // Tulis data pixel (BMP menyimpan dari bawah ke atas), satu baris per fwrite
+    uint8_t padding_bytes[3] = {0, 0, 0};
+    for (int y = height - 1; y >= 0; y--) {
+        fwrite(image + (size_t)y * width, sizeof(RGB), width, file);
+        if (padding > 0) {
+            fwrite(padding_bytes, padding, 1, file);
+        }
+    }
+
+    int ok = !ferror(file);
+    return fclose(file) == 0 && ok;
+}
+
+// Encode gambar ke BMP di memori (format sama dengan save_bmp), sehingga file
+// bisa ditulis dengan satu fwrite besar
+size_t encode_bmp(uint8_t* out, const RGB* image, int width, int height) {
+    int padding = (4 - (width * 3) % 4) % 4;
+    size_t row_bytes = (size_t)width * sizeof(RGB);
+    size_t total = bmp_file_size(width, height);
+
+    BMPHeader header;
+    BMPInfoHeader info;
+    bmp_headers(&header, &info, width, height);
+    memcpy(out, &header, sizeof(BMPHeader));
+    memcpy(out + sizeof(BMPHeader), &info, sizeof(BMPInfoHeader));
+
+    uint8_t* dst = out + sizeof(BMPHeader) + sizeof(BMPInfoHeader);
+    for (int y = height - 1; y >= 0; y--) {
+        memcpy(dst, image + (size_t)y * width, row_bytes);
+        dst += row_bytes;
+        for (int i = 0; i < padding; i++) *dst++ = 0;
+    }
+    return total;
+}
+
+// === Kernel potongan baris ===
+// Koordinat pixel dihitung persis seperti versi serial asli
+// (min + x * skala), sehingga semua backend exact identik bit per bit.
+static void span_scalar(const RenderParams* p, int y, int x0, int x1, uint32_t* out) {
+    double real_scale = (p->max_real - p->min_real) / p->width;
+    double imag_scale = (p->max_imag - p->min_imag) / p->height;
+    double imag = p->min_imag + y * imag_scale;
+
+    for (int x = x0; x < x1; x++) {
+        double real = p->min_real + x * real_scale;
+        out[x - x0] = (uint32_t)mandelbrot_iterations(real, imag, p->max_iterations);
+    }
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+
+// 4 pixel double per vektor. Operasi sama dengan kernel skalar dan GCC
+// dilarang menggabungkannya menjadi FMA (fp-contract=off), jadi hasilnya
+// identik; lane yang sudah lolos dimatikan lewat mask dan loop berhenti begitu
+// semua lane lolos.
+__attribute__((target("avx2"), optimize("fp-contract=off")))
+static void span_avx2(const RenderParams* p, int y, int x0, int x1, uint32_t* out) {
+    double real_scale = (p->max_real - p->min_real) / p->width;
+    double imag_scale = (p->max_imag - p->min_imag) / p->height;
+    const __m256d four = _mm256_set1_pd(4.0);
+    const __m256d ci = _mm256_set1_pd(p->min_imag + y * imag_scale);
+    int x = x0;
+
+    for (; x + 4 <= x1; x += 4) {
+        double re[4];
+        for (int k = 0; k < 4; k++) re[k] = p->min_real + (x + k) * real_scale;
+        __m256d cr = _mm256_loadu_pd(re);
+        __m256d zr = _mm256_setzero_pd();
+        __m256d zi = _mm256_setzero_pd();
+        __m256d active = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+        __m256i count = _mm256_setzero_si256();
+
+        for (int i = 0; i < p->max_iterations; i++) {
+            __m256d zr2 = _mm256_mul_pd(zr, zr);
+            __m256d zi2 = _mm256_mul_pd(zi, zi);
+            active = _mm256_and_pd(active, _mm256_cmp_pd(_mm256_add_pd(zr2, zi2), four, _CMP_LT_OQ));
+            if (_mm256_testz_pd(active, active)) break;
+            count = _mm256_sub_epi64(count, _mm256_castpd_si256(active));
+
+            __m256d temp = _mm256_add_pd(_mm256_sub_pd(zr2, zi2), cr);
+            zi = _mm256_add_pd(_mm256_mul_pd(_mm256_add_pd(zr, zr), zi), ci);
+            zr = temp;
+        }
+
+        int64_t lanes[4];
+        _mm256_storeu_si256((__m256i*)lanes, count);
+        for (int k = 0; k < 4; k++) out[x + k - x0] = (uint32_t)lanes[k];
+    }
+    span_scalar(p, y, x, x1, out + (x - x0));
+}
+
+// 8 pixel double per vektor dengan register mask AVX-512 (target ini
+// mengizinkan FMA, jadi fp-contract=off wajib agar tetap exact)
+__attribute__((target("avx512f"), optimize("fp-contract=off")))
+static void span_avx512(const RenderParams* p, int y, int x0, int x1, uint32_t* out) {
+    double real_scale = (p->max_real - p->min_real) / p->width;
+    double imag_scale = (p->max_imag - p->min_imag) / p->height;
+    const __m512d four = _mm512_set1_pd(4.0);
+    const __m512d ci = _mm512_set1_pd(p->min_imag + y * imag_scale);
+    const __m512i one = _mm512_set1_epi64(1);
+    int x = x0;
+
+    for (; x + 8 <= x1; x += 8) {
+        double re[8];
+        for (int k = 0; k < 8; k++) re[k] = p->min_real + (x + k) * real_scale;
+        __m512d cr = _mm512_loadu_pd(re);
+        __m512d zr = _mm512_setzero_pd();
+        __m512d zi = _mm512_setzero_pd();
+        __mmask8 active = 0xFF;
+        __m512i count = _mm512_setzero_si512();
+
+        for (int i = 0; i < p->max_iterations; i++) {
+            __m512d zr2 = _mm512_mul_pd(zr, zr);
+            __m512d zi2 = _mm512_mul_pd(zi, zi);
+            active = _mm512_mask_cmp_pd_mask(active, _mm512_add_pd(zr2, zi2), four, _CMP_LT_OQ);
+            if (!active) break;
+            count = _mm512_mask_add_epi64(count, active, count, one);
+
+            __m512d temp = _mm512_add_pd(_mm512_sub_pd(zr2, zi2), cr);
+            zi = _mm512_add_pd(_mm512_mul_pd(_mm512_add_pd(zr, zr), zi), ci);
+            zr = temp;
+        }
+
+        _mm256_storeu_si256((__m256i*)(out + x - x0), _mm512_cvtepi64_epi32(count));
+    }
+    span_scalar(p, y, x, x1, out + (x - x0));
+}
+
+static int avx2_available(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+static int avx512_available(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx512f");
+}
+#else
+#define span_avx2 span_scalar
+#define span_avx512 span_scalar
+
+static int avx2_available(void) {
+    return 0;
+}
+
+static int avx512_available(void) {
+    return 0;
+}
+#endif
+
+static int always_available(void) {
+    return 1;
+}
+
+// Float dulu, pixel meragukan dihitung ulang dalam double (float_first.h)
+static int frame_float_first(const RenderParams* p, int threads, uint32_t* out) {
+    FloatFirstStats stats;
+    (void)threads;
+    return render_float_first(out, p->width, p->height, p->max_iterations,
+                              p->min_real, p->max_real, p->min_imag, p->max_imag,
+                              mandelbrot_iterations, &stats);
+}
+
+// Perturbasi + BLA dengan pusat viewport sebagai orbit referensi. Pusat di
+// sini hanya sepresisi double; zoom yang lebih dalam lewat mandelbrot_deepzoom.
+static int frame_bla(const RenderParams* p, int threads, uint32_t* out) {
+    char center_real[64], center_imag[64];
+    snprintf(center_real, sizeof(center_real), "%.40f", (p->min_real + p->max_real) / 2.0);
+    snprintf(center_imag, sizeof(center_imag), "%.40f", (p->min_imag + p->max_imag) / 2.0);
+    DeepView view = {center_real, center_imag, p->max_real - p->min_real, p->max_imag - p->min_imag,
+                     p->width, p->height, p->max_iterations};
+    DeepStats stats;
+    return render_deep(&view, 1, threads, out, &stats);
+}
+
+// Backend baru cukup ditambahkan ke tabel ini
+static const RenderBackend backends[] = {
+    {"scalar",      "kernel double skalar, satu thread",          1, 0, always_available, span_scalar, NULL},
+    {"openmp",      "kernel double skalar, tile OpenMP",          1, 1, always_available, span_scalar, NULL},
+    {"simd-avx2",   "4 pixel double per vektor AVX2, tile OpenMP", 1, 1, avx2_available,   span_avx2,   NULL},
+    {"simd-avx512", "8 pixel double per vektor AVX-512, tile OpenMP", 1, 1, avx512_available, span_avx512, NULL},
+    {"float-first", "float dulu, double selektif (tidak exact)",  0, 0, always_available, NULL, frame_float_first},
+    {"bla",         "perturbasi + lompatan BLA (tidak exact)",    0, 0, always_available, NULL, frame_bla},
+};
+#define BACKEND_COUNT ((int)(sizeof(backends) / sizeof(backends[0])))
+
+int render_backend_count(void) {
+    return BACKEND_COUNT;
+}
+
+const RenderBackend* render_backend_at(int index) {
+    return index >= 0 && index < BACKEND_COUNT ? &backends[index] : NULL;
+}
+
+const RenderBackend* find_render_backend(const char* name) {
+    for (int i = 0; i < BACKEND_COUNT; i++) {
+        if (strcmp(backends[i].name, name) == 0) return &backends[i];
+    }
+    return NULL;
+}
+
+void colorize(RGB* image, const uint32_t* iterations, size_t count, int max_iter) {
+    #pragma omp parallel for schedule(static)
+    for (long i = 0; i < (long)count; i++) {
+        image[i] = get_color((int)iterations[i], max_iter);
+    }
+}
+
+const RenderBackend* render_span_backend(const RenderBackend* be) {
+    if (be && be->span) return be;
+    const RenderBackend* widest = &backends[0];
+    for (int i = 0; i < BACKEND_COUNT; i++) {
+        if (backends[i].exact && backends[i].parallel && backends[i].span && backends[i].available()) {
+            widest = &backends[i];
+        }
+    }
+    return widest;
+}
+
+typedef struct {
+    const RenderParams* p;
+    const TileSchedule* sched;
+    SpanKernel span;
+    int tiles_x;
+    uint32_t* iter;
+    RGB* image;
+} ScheduleRun;
+
+// Satu chunk: setiap tile dihitung per baris, diwarnai, dan biayanya dicatat
+static void render_schedule_chunk(const ScheduleRun* run, int c, uint32_t* scratch) {
+    const RenderParams* p = run->p;
+    const TileSchedule* s = run->sched;
+    int first = s->chunk_start ? s->chunk_start[c] : c;
+    int last = s->chunk_start ? s->chunk_start[c + 1] : c + 1;
+
+    for (int i = first; i < last; i++) {
+        int t = s->order ? s->order[i] : i;
+        int x0 = (t % run->tiles_x) * s->tile_w;
+        int y0 = (t / run->tiles_x) * s->tile_h;
+        int x1 = x0 + s->tile_w < p->width ? x0 + s->tile_w : p->width;
+        int y1 = y0 + s->tile_h < p->height ? y0 + s->tile_h : p->height;
+        unsigned long long sum = 0;
+
+        for (int y = y0; y < y1; y++) {
+            size_t row = (size_t)y * p->width;
+            uint32_t* dst = run->iter ? run->iter + row + x0 : scratch;
+            run->span(p, y, x0, x1, dst);
+            if (run->image) {
+                for (int x = x0; x < x1; x++) {
+                    run->image[row + x] = get_color((int)dst[x - x0], p->max_iterations);
+                }
+            }
+            if (s->tile_cost) {
+                for (int x = x0; x < x1; x++) sum += dst[x - x0];
+            }
+        }
+
+        if (s->tile_cost) s->tile_cost[t] = (double)sum / ((double)(x1 - x0) * (y1 - y0));
+    }
+}
+
+int render_scheduled(const RenderConfig* cfg, const RenderParams* p, const TileSchedule* sched,
+                     uint32_t* iter, RGB* image) {
+    const RenderBackend* be = render_span_backend(cfg->backend);
+    int threads = be->parallel ? (cfg->threads > 0 ? cfg->threads : omp_get_max_threads()) : 1;
+    int tiles_x = (p->width + sched->tile_w - 1) / sched->tile_w;
+    int tiles_y = (p->height + sched->tile_h - 1) / sched->tile_h;
+    int chunks = sched->chunk_start ? sched->chunks : tiles_x * tiles_y;
+    int static_chunk = sched->static_chunk;
+
+    uint32_t* scratch = NULL;
+    if (!iter) {
+        scratch = (uint32_t*)malloc((size_t)threads * sched->tile_w * sizeof(uint32_t));
+        if (!scratch) return 0;
+    }
+
+    ScheduleRun run = {p, sched, be->span, tiles_x, iter, image};
+    int used = 1;
+    #pragma omp parallel num_threads(threads)
+    {
+        uint32_t* span = scratch ? scratch + (size_t)omp_get_thread_num() * sched->tile_w : NULL;
+
+        #pragma omp master
+        used = omp_get_num_threads();
+
+        if (static_chunk > 0) {
+            #pragma omp for schedule(static, static_chunk) nowait
+            for (int c = 0; c < chunks; c++) {
+                render_schedule_chunk(&run, c, span);
+            }
+        } else {
+            #pragma omp for schedule(dynamic, 1) nowait
+            for (int c = 0; c < chunks; c++) {
+                render_schedule_chunk(&run, c, span);
+            }
+        }
+        if (sched->thread_finish) sched->thread_finish[omp_get_thread_num()] = omp_get_wtime();
+    }
+
+    free(scratch);
+    return used;
+}
+
+// Driver tile: tugas tile_size x tile_size (atau satu baris) dibagikan secara
+// dinamis ke thread; iterasi ditulis ke peta dan/atau langsung diwarnai
+static int render_tiles(const RenderConfig* cfg, const RenderParams* p, uint32_t* iter, RGB* image) {
+    const RenderBackend* be = cfg->backend;
+    TileSchedule sched;
+    memset(&sched, 0, sizeof(sched));
+    sched.tile_w = be->parallel && cfg->tile_size > 0 ? cfg->tile_size : p->width;
+    sched.tile_h = be->parallel && cfg->tile_size > 0 ? cfg->tile_size : 1;
+    return render_scheduled(cfg, p, &sched, iter, image) > 0;
+}
+
+int render_iterations(const RenderConfig* cfg, const RenderParams* p, uint32_t* out) {
+    if (cfg->backend->frame) {
+        return cfg->backend->frame(p, cfg->threads, out);
+    }
+    return render_tiles(cfg, p, out, NULL);
+}
+
+int render_image(const RenderConfig* cfg, const RenderParams* p, RGB* image) {
+    if (!cfg->backend->frame) {
+        return render_tiles(cfg, p, NULL, image);
+    }
+    size_t count = (size_t)p->width * p->height;
+    uint32_t* iter = (uint32_t*)malloc(count * sizeof(uint32_t));
+    if (!iter || !cfg->backend->frame(p, cfg->threads, iter)) {
+        free(iter);
+        return 0;
+    }
+    colorize(image, iter, count, p->max_iterations);
+    free(iter);
+    return 1;
+}
+
+// === Autotuner ===
+#define TUNE_PROBE_WIDTH 320
+#define TUNE_REPEATS 2
+#define TUNE_MAGIC "# mandelbrot autotune v1"
+
+static const int tune_tiles[] = {0, 16, 32, 64, 128};
+#define TUNE_TILE_COUNT ((int)(sizeof(tune_tiles) / sizeof(tune_tiles[0])))
+
+// Kelas scene: orde kedalaman zoom (relatif terhadap lebar default 3.5) dan
+// orde batas iterasi; keduanya menentukan biaya per pixel dan sebarannya
+void autotune_scene_class(const RenderParams* p, char* out, size_t size) {
+    double zoom = 3.5 / (p->max_real - p->min_real);
+    int zoom_class = (int)floor(log10(zoom));
+    int iter_class = (int)floor(log2((double)p->max_iterations));
+    snprintf(out, size, "z%d_i%d", zoom_class, iter_class);
+}
+
+// Identitas mesin: model CPU dan jumlah thread, tanpa spasi
+static void machine_id(char* out, size_t size) {
+    char model[96] = "";
+#ifdef __linux__
+    FILE* f = fopen("/proc/cpuinfo", "r");
+    if (f) {
+        char line[256];
+        while (fgets(line, sizeof(line), f)) {
+            if (strncmp(line, "model name", 10) == 0) {
+                char* colon = strchr(line, ':');
+                if (colon) {
+                    snprintf(model, sizeof(model), "%s", colon + 1);
+                }
+                break;
+            }
+        }
+        fclose(f);
+    }
+#endif
+    if (!model[0]) {
+        const char* env = getenv("PROCESSOR_IDENTIFIER");
+        snprintf(model, sizeof(model), "%s", env ? env : "unknown-cpu");
+    }
+
+    char clean[96];
+    size_t n = 0;
+    int gap = 1;
+    for (const char* c = model; *c && n + 1 < sizeof(clean); c++) {
+        int space = *c == ' ' || *c == '\t' || *c == '\n' || *c == '\r';
+        if (space) {
+            if (!gap) clean[n++] = '-';
+            gap = 1;
+        } else {
+            clean[n++] = *c;
+            gap = 0;
+        }
+    }
+    while (n > 0 && clean[n - 1] == '-') n--;
+    clean[n] = '\0';
+    snprintf(out, size, "%s_%dt", clean, omp_get_max_threads());
+}
+
+static void cache_path(char* out, size_t size) {
+    const char* env = getenv("MANDELBROT_TUNE_CACHE");
+    if (env && *env) {
+        snprintf(out, size, "%s", env);
+        return;
+    }
+    const char* home = getenv("HOME");
+    if (!home) home = getenv("USERPROFILE");
+    if (home) {
+        snprintf(out, size, "%s/.mandelbrot_tune", home);
+    } else {
+        snprintf(out, size, ".mandelbrot_tune");
+    }
+}
+
+static int cache_lookup(const char* path, const char* machine, const char* scene_class,
+                        RenderConfig* cfg, double* probe_ms) {
+    FILE* f = fopen(path, "r");
+    if (!f) return 0;
+    char line[512];
+    int found = 0;
+    while (fgets(line, sizeof(line), f)) {
+        char m[128], c[32], name[32];
+        int tile, threads;
+        double ms;
+        if (line[0] == '#') continue;
+        if (sscanf(line, "%127s %31s %31s %d %d %lf", m, c, name, &tile, &threads, &ms) != 6) continue;
+        if (strcmp(m, machine) != 0 || strcmp(c, scene_class) != 0) continue;
+        const RenderBackend* be = find_render_backend(name);
+        if (!be || !be->available() || tile < 0 || threads < 0) continue;
+        cfg->backend = be;
+        cfg->tile_size = tile;
+        cfg->threads = threads;
+        *probe_ms = ms;
+        found = 1;      // entri terakhir yang cocok menang
+    }
+    fclose(f);
+    return found;
+}
+
+// Tulis ulang file cache: entri lain dipertahankan, entri kelas ini diganti
+static void cache_store(const char* path, const char* machine, const char* scene_class,
+                        const RenderConfig* cfg, double probe_ms) {
+    char* kept = NULL;
+    size_t kept_len = 0;
+    FILE* f = fopen(path, "r");
+    if (f) {
+        char line[512];
+        while (fgets(line, sizeof(line), f)) {
+            char m[128], c[32];
+            if (line[0] == '#') continue;
+            if (sscanf(line, "%127s %31s", m, c) == 2 &&
+                strcmp(m, machine) == 0 && strcmp(c, scene_class) == 0) continue;
+            size_t len = strlen(line);
+            char* grown = (char*)realloc(kept, kept_len + len + 1);
+            if (!grown) break;
+            kept = grown;
+            memcpy(kept + kept_len, line, len + 1);
+            kept_len += len;
+        }
+        fclose(f);
+    }
+
+    f = fopen(path, "w");
+    if (f) {
+        fprintf(f, "%s\n# mesin kelas_scene backend tile thread probe_ms\n", TUNE_MAGIC);
+        if (kept) fputs(kept, f);
+        fprintf(f, "%s %s %s %d %d %.3f\n", machine, scene_class, cfg->backend->name,
+                cfg->tile_size, cfg->threads, probe_ms);
+        fclose(f);
+    }
+    free(kept);
+}
+
+static double time_probe(const RenderConfig* cfg, const RenderParams* probe, uint32_t* out) {
+    double best = -1.0;
+    for (int r = 0; r < TUNE_REPEATS; r++) {
+        double start = omp_get_wtime();
+        if (!render_iterations(cfg, probe, out)) return -1.0;
+        double ms = (omp_get_wtime() - start) * 1000.0;
+        if (best < 0.0 || ms < best) best = ms;
+    }
+    return best;
+}
+
+int autotune_select(const RenderParams* p, int retune, RenderConfig* cfg, AutotuneInfo* info) {
+    memset(info, 0, sizeof(*info));
+    machine_id(info->machine, sizeof(info->machine));
+    autotune_scene_class(p, info->scene_class, sizeof(info->scene_class));
+    cache_path(info->cache_path, sizeof(info->cache_path));
+
+    if (!retune && cache_lookup(info->cache_path, info->machine, info->scene_class, cfg, &info->probe_ms)) {
+        info->from_cache = 1;
+        return 1;
+    }
+
+    // Probe: viewport sama, resolusi lebih kecil, batas iterasi sama
+    RenderParams probe = *p;
+    if (probe.width > TUNE_PROBE_WIDTH) {
+        probe.width = TUNE_PROBE_WIDTH;
+        probe.height = (int)((double)p->height * TUNE_PROBE_WIDTH / p->width);
+        if (probe.height < 1) probe.height = 1;
+    }
+    size_t count = (size_t)probe.width * probe.height;
+    uint32_t* reference = (uint32_t*)malloc(count * sizeof(uint32_t));
+    uint32_t* out = (uint32_t*)malloc(count * sizeof(uint32_t));
+    if (!reference || !out) {
+        free(reference);
+        free(out);
+        return 0;
+    }
+
+    double start = omp_get_wtime();
+    RenderConfig ref_cfg = {find_render_backend("scalar"), 0, 1};
+    double best_ms = time_probe(&ref_cfg, &probe, reference);
+    *cfg = ref_cfg;
+    info->candidates = 1;
+
+    int max_threads = omp_get_max_threads();
+    int thread_options[3] = {max_threads, max_threads / 2, 1};
+
+    for (int b = 0; b < BACKEND_COUNT; b++) {
+        const RenderBackend* be = &backends[b];
+        if (!be->exact || !be->parallel || !be->available()) continue;
+        for (int t = 0; t < 3; t++) {
+            int threads = thread_options[t];
+            int seen = threads < 1;
+            for (int u = 0; u < t; u++) seen |= thread_options[u] == threads;
+            if (seen) continue;
+            for (int k = 0; k < TUNE_TILE_COUNT; k++) {
+                RenderConfig candidate = {be, tune_tiles[k], threads};
+                double ms = time_probe(&candidate, &probe, out);
+                info->candidates++;
+                // Hanya konfigurasi yang hasilnya identik dengan referensi
+                if (ms < 0.0 || memcmp(out, reference, count * sizeof(uint32_t)) != 0) continue;
+                if (ms < best_ms) {
+                    best_ms = ms;
+                    *cfg = candidate;
+                }
+            }
+        }
+    }
+    info->tune_time = omp_get_wtime() - start;
+    info->probe_ms = best_ms;
+
+    free(reference);
+    free(out);
+    if (best_ms < 0.0) return 0;
+
+    cache_store(info->cache_path, info->machine, info->scene_class, cfg, best_ms);
+    return 1;
+}
@@ -0,0 +1,216 @@
+#ifndef RENDER_H
+#define RENDER_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+
+// === Library render Mandelbrot ===
+// Satu sumber untuk format BMP, kernel iterasi, skema warna, dan backend
+// render. serial.c, parallel.c, gpu.c, dan golden.c hanya front end di atasnya,
+// jadi optimasi cukup dibuat sekali dan semua benchmark membandingkan kode
+// yang sama. Kernel dan warna inline agar bisa dipakai juga di device CUDA.
+
+#ifdef __CUDACC__
+#define MB_HD __host__ __device__
+#else
+#define MB_HD
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Struktur untuk header BMP
+#pragma pack(push, 1)
+typedef struct {
+    uint16_t type;
+    uint32_t size;
+    uint16_t reserved1;
+    uint16_t reserved2;
+    uint32_t offset;
+} BMPHeader;
+
+typedef struct {
+    uint32_t size;
+    int32_t width;
+    int32_t height;
+    uint16_t planes;
+    uint16_t bits_per_pixel;
+    uint32_t compression;
+    uint32_t image_size;
+    int32_t x_pixels_per_meter;
+    int32_t y_pixels_per_meter;
+    uint32_t colors_used;
+    uint32_t colors_important;
+} BMPInfoHeader;
+#pragma pack(pop)
+
+// Struktur untuk warna RGB
+typedef struct {
+    uint8_t b, g, r;
+} RGB;
+
+// Fungsi untuk menghitung iterasi Mandelbrot
+static inline MB_HD int mandelbrot_iterations(double real, double imag, int max_iter) {
+    double z_real = 0.0;
+    double z_imag = 0.0;
+    int iter = 0;
+
+    while (iter < max_iter && (z_real * z_real + z_imag * z_imag) < 4.0) {
+        double temp = z_real * z_real - z_imag * z_imag + real;
+        z_imag = 2.0 * z_real * z_imag + imag;
+        z_real = temp;
+        iter++;
+    }
+
+    return iter;
+}
+
+// Lanjutkan iterasi Mandelbrot dari state (z, iter) sampai batas limit.
+// Dipakai probe iterasi otomatis dan checkpoint agar tidak mengulang dari nol.
+static inline MB_HD int mandelbrot_continue(double real, double imag, double* z_real, double* z_imag,
+                                            int iter, int limit) {
+    double zr = *z_real;
+    double zi = *z_imag;
+
+    while (iter < limit && (zr * zr + zi * zi) < 4.0) {
+        double temp = zr * zr - zi * zi + real;
+        zi = 2.0 * zr * zi + imag;
+        zr = temp;
+        iter++;
+    }
+
+    *z_real = zr;
+    *z_imag = zi;
+    return iter;
+}
+
+// Fungsi untuk mengkonversi iterasi ke warna
+static inline MB_HD RGB get_color(int iterations, int max_iter) {
+    RGB color;
+
+    if (iterations == max_iter) {
+        // Titik dalam himpunan Mandelbrot (hitam)
+        color.r = 0;
+        color.g = 0;
+        color.b = 0;
+    } else {
+        // Gradasi warna berdasarkan iterasi
+        double ratio = (double)iterations / max_iter;
+
+        // Skema warna biru ke merah
+        if (ratio < 0.5) {
+            color.r = (uint8_t)(255 * ratio * 2);
+            color.g = 0;
+            color.b = (uint8_t)(255 * (1 - ratio * 2));
+        } else {
+            color.r = 255;
+            color.g = (uint8_t)(255 * (ratio - 0.5) * 2);
+            color.b = 0;
+        }
+    }
+
+    return color;
+}
+
+// === BMP ===
+int save_bmp(const char* filename, const RGB* image, int width, int height);
+size_t bmp_file_size(int width, int height);
+// Encode ke memori (format sama dengan save_bmp); out minimal bmp_file_size()
+size_t encode_bmp(uint8_t* out, const RGB* image, int width, int height);
+
+// === Backend ===
+typedef struct {
+    int width, height;
+    int max_iterations;
+    double min_real, max_real;
+    double min_imag, max_imag;
+} RenderParams;
+
+typedef struct RenderBackend RenderBackend;
+
+typedef struct {
+    const RenderBackend* backend;
+    int tile_size;      // sisi tile dalam pixel; 0 = satu baris per tugas
+    int threads;        // 0 = omp_get_max_threads()
+} RenderConfig;
+
+// Kernel potongan baris: iterasi pixel x0..x1-1 pada baris y ke out[0..]
+typedef void (*SpanKernel)(const RenderParams* p, int y, int x0, int x1, uint32_t* out);
+// Kernel satu frame penuh (algoritma yang butuh seluruh peta, mis. float dulu)
+typedef int (*FrameKernel)(const RenderParams* p, int threads, uint32_t* out);
+
+struct RenderBackend {
+    const char* name;
+    const char* description;
+    int exact;              // identik bit per bit dengan kernel skalar referensi
+    int parallel;           // tile_size dan threads berpengaruh
+    int (*available)(void);
+    SpanKernel span;        // salah satu dari span / frame terisi
+    FrameKernel frame;
+};
+
+int render_backend_count(void);
+const RenderBackend* render_backend_at(int index);
+// NULL bila nama tidak dikenal
+const RenderBackend* find_render_backend(const char* name);
+
+// Peta iterasi / gambar berwarna; mengembalikan 0 bila alokasi gagal
+int render_iterations(const RenderConfig* cfg, const RenderParams* p, uint32_t* out);
+int render_image(const RenderConfig* cfg, const RenderParams* p, RGB* image);
+void colorize(RGB* image, const uint32_t* iterations, size_t count, int max_iter);
+
+// === Jadwal milik front end ===
+// Front end yang membagi kerja sendiri (urutan LPT, penempatan NUMA, task
+// batch, tile checkpoint) tetap memakai kernel span backend. Backend frame-only
+// tidak bisa dipotong per span; sebagai gantinya dipakai backend span exact
+// terlebar yang tersedia. be == NULL langsung memilih backend tersebut.
+const RenderBackend* render_span_backend(const RenderBackend* be);
+
+// Tile tile_w x tile_h (indeks baris mayor) dijalankan menurut order (NULL =
+// urutan indeks), dikelompokkan menjadi chunk [chunk_start[c], chunk_start[c+1])
+// (NULL = satu tile per chunk). static_chunk > 0 membagi chunk ke thread dengan
+// schedule(static, static_chunk), sama dengan pass first-touch berjadwal itu;
+// 0 = chunk diambil dinamis.
+typedef struct {
+    int tile_w, tile_h;
+    const int* order;
+    const int* chunk_start;
+    int chunks;             // jumlah chunk bila chunk_start terisi
+    int static_chunk;
+    double* tile_cost;      // opsional: rata-rata iterasi per pixel per tile
+    double* thread_finish;  // opsional: omp_get_wtime() saat tiap thread selesai
+} TileSchedule;
+
+// Seperti render_iterations/render_image dengan jadwal di atas (iter dan image
+// boleh salah satu NULL). Mengembalikan jumlah thread yang dipakai, 0 bila
+// alokasi gagal.
+int render_scheduled(const RenderConfig* cfg, const RenderParams* p, const TileSchedule* sched,
+                     uint32_t* iter, RGB* image);
+
+// === Autotuner ===
+// Saat pertama kali sebuah kelas scene (kedalaman zoom, orde iterasi) dirender
+// di mesin ini, backend exact yang tersedia, ukuran tile, dan jumlah thread
+// di-benchmark pada probe resolusi rendah. Konfigurasi terbaik disimpan di
+// file cache (MANDELBROT_TUNE_CACHE, default ~/.mandelbrot_tune) dan dipakai
+// langsung pada run berikutnya.
+typedef struct {
+    char machine[128];
+    char scene_class[32];
+    char cache_path[512];
+    int from_cache;
+    int candidates;         // konfigurasi yang diukur (0 bila dari cache)
+    double tune_time;       // detik
+    double probe_ms;        // waktu probe konfigurasi terpilih
+} AutotuneInfo;
+
+void autotune_scene_class(const RenderParams* p, char* out, size_t size);
+// retune = 1 mengabaikan cache; mengembalikan 0 bila benchmark gagal
+int autotune_select(const RenderParams* p, int retune, RenderConfig* cfg, AutotuneInfo* info);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,63 @@
+// triple_buffer.h - Lock-free triple buffer for single-producer/single-consumer frame exchange
+//
+// The producer always owns a back buffer, the consumer always owns a front
+// buffer, and the third ("middle") slot is swapped atomically between them.
+// Publishing never blocks and never waits for the consumer; the consumer
+// always gets the newest complete frame, and frames published in between are
+// simply overwritten. Neither side ever touches the buffer the other one owns.
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <atomic>
+#include <cstdint>
+
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() : middle_(1), back_(0), front_(2) {}
+
+    // Direct access for initialization before the producer/consumer start
+    T& buffer(int index) { return buffers_[index].value; }
+
+    // Producer: buffer to fill next
+    T& back() { return buffers_[back_].value; }
+
+    // Producer: hand the back buffer over; returns immediately
+    void publish() {
+        uint8_t previous = middle_.exchange(static_cast<uint8_t>(back_ | DIRTY), std::memory_order_acq_rel);
+        back_ = previous & INDEX;
+    }
+
+    // Consumer: true when a frame newer than front() has been published
+    bool has_new() const {
+        return (middle_.load(std::memory_order_relaxed) & DIRTY) != 0;
+    }
+
+    // Consumer: newest complete frame (the current front if nothing new)
+    const T& latest() {
+        if (has_new()) {
+            uint8_t previous = middle_.exchange(front_, std::memory_order_acq_rel);
+            front_ = previous & INDEX;
+        }
+        return buffers_[front_].value;
+    }
+
+    // Consumer: the frame returned by the last latest() call
+    const T& front() const { return buffers_[front_].value; }
+
+private:
+    static const uint8_t INDEX = 3;
+    static const uint8_t DIRTY = 4;
+
+    // Each buffer header on its own cache line, away from the shared index
+    struct alignas(64) Slot {
+        T value;
+    };
+
+    Slot buffers_[3];
+    alignas(64) std::atomic<uint8_t> middle_;
+    alignas(64) uint8_t back_;      // producer only
+    alignas(64) uint8_t front_;     // consumer only
+};
+
+#endif
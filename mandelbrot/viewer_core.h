@@ -0,0 +1,668 @@
+// viewer_core.h - Platform-neutral state machine and renderer of the fractal viewer
+//
+// Holds the view (zoom, center, mode, iteration limit), the actions the user can
+// trigger (zoom_to_area, pan, update_julia_constant, iteration +/-, reset, mode
+// toggles) and the multi-threaded renderer. Front ends derive from it: the
+// Windows GUI (fractal_gui.cpp) presents frames in a window, the headless
+// replay benchmark (viewer_replay.cpp) drives it from a recorded input trace.
+//
+// Rendering runs on its own thread. Actions update the view on the caller's
+// (UI) thread and post a render request; requests that arrive while a frame is
+// rendering are coalesced into the next frame. Finished frames are published
+// through a lock-free triple buffer, so the presenter always reads the latest
+// complete frame and never sees one that is still being written.
+//
+// The core keeps a metrics registry (metrics.h) of frames, tiles, iterations,
+// per-stage latency, queue depth, tile-cost cache hits and worker utilization;
+// front ends decide whether and how to export it.
+#ifndef VIEWER_CORE_H
+#define VIEWER_CORE_H
+
+#include <vector>
+#include <complex>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include "triple_buffer.h"
+#include "metrics.h"
+
+// Everything a frame depends on; copied into each render request
+struct ViewState {
+    int max_iterations;
+    double zoom;
+    double center_real, center_imag;
+    bool is_julia;
+    bool auto_iterations;
+    bool lpt_scheduling;
+    std::complex<double> julia_c;
+};
+
+struct Frame {
+    std::vector<uint32_t> pixels;   // 0x00BBGGRR per pixel, same layout as a Windows COLORREF
+    uint64_t id;                    // publication sequence number (0 = nothing rendered yet)
+    uint64_t request;               // newest render request this frame reflects
+    ViewState view;                 // view it was rendered with (iterations resolved)
+    double frame_ms;
+    double tail_ms;
+    std::chrono::steady_clock::time_point published;
+};
+
+class FractalViewerCore {
+protected:
+    int width, height;
+
+    // View as seen by the UI thread; only that thread reads or writes it
+    ViewState view;
+
+    // Render requests (UI thread -> render thread)
+    std::thread render_thread;
+    std::mutex request_mutex;
+    std::condition_variable request_cv;
+    ViewState requested_view;
+    uint64_t request_seq;
+    uint64_t rendered_seq;
+    bool stopping;
+
+    // Finished frames (render thread -> presenter)
+    TripleBuffer<Frame> frames;
+    uint64_t frames_published;
+
+    // Iteration limit chosen by the last auto-iteration frame
+    std::atomic<int> last_iterations;
+
+    // Cost-predicted tile scheduling: per-tile average iterations of the
+    // previous frame, together with the view it was measured in
+    // (render thread only)
+    static const int TILE_SIZE = 32;
+    std::vector<double> tile_cost;
+    bool tile_cost_valid;
+    bool tile_cost_julia;
+    double tile_cost_zoom, tile_cost_real, tile_cost_imag;
+
+    // Metrics; the pointers are registered once in the constructor and are
+    // safe to update from any thread
+    MetricsRegistry metrics;
+    MetricCounter* metric_requests;
+    MetricCounter* metric_coalesced;
+    MetricCounter* metric_frames;
+    MetricCounter* metric_tiles;
+    MetricCounter* metric_rows;
+    MetricCounter* metric_iterations;
+    MetricCounter* metric_cache_hit;
+    MetricCounter* metric_cache_miss;
+    MetricCounter* metric_busy_us;
+    MetricCounter* metric_capacity_us;
+    MetricHistogram* metric_queue_s;
+    MetricHistogram* metric_auto_s;
+    MetricHistogram* metric_render_s;
+    MetricHistogram* metric_tail_s;
+    MetricHistogram* metric_frame_s;
+    MetricHistogram* metric_present_s;
+    MetricGauge* metric_queue_depth;
+    MetricGauge* metric_utilization;
+    MetricGauge* metric_threads;
+    std::chrono::steady_clock::time_point oldest_request;   // under request_mutex
+
+    // Called on the render thread right after a frame is published; front ends
+    // wake their presenter here. Must not block.
+    virtual void frame_rendered(const Frame& frame) { (void)frame; }
+
+public:
+    FractalViewerCore(int w, int h)
+        : width(w), height(h), request_seq(0), rendered_seq(0), stopping(false),
+          frames_published(0), last_iterations(100),
+          tile_cost_valid(false), tile_cost_julia(false),
+          tile_cost_zoom(1.0), tile_cost_real(0.0), tile_cost_imag(0.0) {
+
+        view.max_iterations = 100;
+        view.zoom = 1.0;
+        view.center_real = -0.5;
+        view.center_imag = 0.0;
+        view.is_julia = false;
+        view.auto_iterations = false;
+        view.lpt_scheduling = false;
+        view.julia_c = std::complex<double>(0.3, 0.5);
+        requested_view = view;
+
+        for (int i = 0; i < 3; i++) {
+            Frame& frame = frames.buffer(i);
+            frame.pixels.assign(width * height, 0);
+            frame.id = 0;
+            frame.request = 0;
+            frame.view = view;
+            frame.frame_ms = 0.0;
+            frame.tail_ms = 0.0;
+        }
+
+        register_metrics();
+    }
+
+    void register_metrics() {
+        metric_requests = &metrics.counter("viewer_render_requests_total", "Render requests posted by viewer actions");
+        metric_coalesced = &metrics.counter("viewer_requests_coalesced_total",
+                                            "Requests superseded by a newer one before rendering started");
+        metric_frames = &metrics.counter("viewer_frames_rendered_total", "Frames published to the presenter");
+        const char* units_help = "Work units rendered (LPT tiles or row bands)";
+        metric_tiles = &metrics.counter("viewer_tiles_rendered_total", units_help, "unit=\"tile\"");
+        metric_rows = &metrics.counter("viewer_tiles_rendered_total", units_help, "unit=\"row\"");
+        metric_iterations = &metrics.counter("viewer_iterations_total", "Escape-time iterations computed");
+        const char* cache_help = "LPT frames scheduled from the previous frame's tile costs (hit) or unsorted (miss)";
+        metric_cache_hit = &metrics.counter("viewer_tile_cost_cache_total", cache_help, "result=\"hit\"");
+        metric_cache_miss = &metrics.counter("viewer_tile_cost_cache_total", cache_help, "result=\"miss\"");
+        metric_busy_us = &metrics.counter("viewer_thread_busy_microseconds_total",
+                                          "Worker time spent rendering, summed over threads");
+        metric_capacity_us = &metrics.counter("viewer_thread_capacity_microseconds_total",
+                                              "Worker time available (threads x parallel section wall time)");
+
+        // 0.25 ms .. ~4 s
+        std::vector<double> bounds = metrics_exponential_buckets(0.00025, 2.0, 15);
+        const char* stage_help = "Latency of each stage of a frame";
+        metric_queue_s = &metrics.histogram("viewer_stage_seconds", stage_help, bounds, "stage=\"queue\"");
+        metric_auto_s = &metrics.histogram("viewer_stage_seconds", stage_help, bounds, "stage=\"auto_iterations\"");
+        metric_render_s = &metrics.histogram("viewer_stage_seconds", stage_help, bounds, "stage=\"render\"");
+        metric_tail_s = &metrics.histogram("viewer_stage_seconds", stage_help, bounds, "stage=\"tail\"");
+        metric_frame_s = &metrics.histogram("viewer_stage_seconds", stage_help, bounds, "stage=\"frame\"");
+        metric_present_s = &metrics.histogram("viewer_stage_seconds", stage_help, bounds, "stage=\"present\"");
+
+        metric_queue_depth = &metrics.gauge("viewer_queue_depth", "Render requests not yet picked up by the render thread");
+        metric_utilization = &metrics.gauge("viewer_thread_utilization", "Busy / capacity of the last frame's workers");
+        metric_threads = &metrics.gauge("viewer_render_threads", "Worker threads used for the last frame");
+    }
+
+    // Derived front ends must call stop_renderer() in their own destructor,
+    // before the frame_rendered() override goes away
+    virtual ~FractalViewerCore() {
+        stop_renderer();
+    }
+
+    void start_renderer() {
+        if (render_thread.joinable()) return;
+        stopping = false;
+        render_thread = std::thread([this]() { render_loop(); });
+    }
+
+    void stop_renderer() {
+        {
+            std::lock_guard<std::mutex> lock(request_mutex);
+            stopping = true;
+        }
+        request_cv.notify_one();
+        if (render_thread.joinable()) render_thread.join();
+    }
+
+    // Post the current view to the render thread; returns the request number
+    uint64_t request_render() {
+        uint64_t seq;
+        {
+            std::lock_guard<std::mutex> lock(request_mutex);
+            requested_view = view;
+            if (request_seq == rendered_seq) oldest_request = std::chrono::steady_clock::now();
+            seq = ++request_seq;
+            metric_queue_depth->set(static_cast<double>(seq - rendered_seq));
+        }
+        metric_requests->add();
+        request_cv.notify_one();
+        return seq;
+    }
+
+    // Presenter: newest complete frame, lock-free
+    const Frame& latest_frame() { return frames.latest(); }
+
+    // Presenter: call once per newly shown frame to record publish -> present latency
+    void frame_presented(const Frame& frame) {
+        metric_present_s->observe(std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - frame.published).count());
+    }
+
+    MetricsRegistry& metrics_registry() { return metrics; }
+
+    static uint32_t pack_rgb(int r, int g, int b) {
+        return static_cast<uint32_t>(r & 0xFF) | (static_cast<uint32_t>(g & 0xFF) << 8) |
+               (static_cast<uint32_t>(b & 0xFF) << 16);
+    }
+
+    // Mandelbrot calculation
+    static int mandelbrot_iterations(std::complex<double> c, int max_iterations) {
+        std::complex<double> z(0, 0);
+        int iter = 0;
+
+        while (iter < max_iterations && std::abs(z) < 2.0) {
+            z = z * z + c;
+            iter++;
+        }
+
+        return iter;
+    }
+
+    // Julia calculation
+    static int julia_iterations(std::complex<double> z, std::complex<double> julia_c, int max_iterations) {
+        int iter = 0;
+
+        while (iter < max_iterations && std::abs(z) < 2.0) {
+            z = z * z + julia_c;
+            iter++;
+        }
+
+        return iter;
+    }
+
+    // Ceiling for both auto mode and manual +/-
+    static const int MAX_ITERATIONS = 1 << 20;
+
+    // Pick the iteration limit from zoom depth, then keep doubling it on a
+    // low-res probe while pixels are still escaping; stop once the next
+    // doubling would change less than 0.1% of the probe.
+    int choose_auto_iterations(const ViewState& v) const {
+        const int min_iter = 64;
+        const int max_iter = MAX_ITERATIONS;
+        const int probe_w = std::min(width, 160);
+        const int probe_h = std::max(1, probe_w * height / width);
+        const int count = probe_w * probe_h;
+
+        int guess = min_iter + static_cast<int>(50.0 * std::max(0.0, std::log2(v.zoom)));
+        guess = std::min(guess, max_iter);
+
+        std::vector<std::complex<double>> z(count, std::complex<double>(0, 0));
+        std::vector<int> iter(count, 0);
+        int limit = 0;
+        int next = guess;
+        int unescaped = count;
+        int max_escape = 0;
+
+        while (true) {
+            int still = 0;
+            for (int py = 0; py < probe_h; py++) {
+                for (int px = 0; px < probe_w; px++) {
+                    int i = py * probe_w + px;
+                    if (iter[i] < limit) continue;
+
+                    std::complex<double> point = screen_to_complex(v, px * width / probe_w, py * height / probe_h);
+                    std::complex<double> c = v.is_julia ? v.julia_c : point;
+                    if (v.is_julia && iter[i] == 0) z[i] = point;
+
+                    int n = iter[i];
+                    while (n < next && std::norm(z[i]) < 4.0) {
+                        z[i] = z[i] * z[i] + c;
+                        n++;
+                    }
+                    iter[i] = n;
+                    if (n == next) still++;
+                    else max_escape = std::max(max_escape, n);
+                }
+            }
+
+            int changed = unescaped - still;
+            if (limit > 0 && changed <= count / 1000) break;
+            unescaped = still;
+            limit = next;
+            if (unescaped == 0 || limit >= max_iter) break;
+            next = std::min(max_iter, limit * 2);
+        }
+
+        if (unescaped == 0) {
+            limit = std::min(limit, max_escape + max_escape / 4 + 1);
+        }
+        return std::max(limit, min_iter);
+    }
+
+    // Convert iterations to color
+    static uint32_t get_color(int iterations, int max_iterations) {
+        if (iterations == max_iterations) {
+            return pack_rgb(0, 0, 0); // Black
+        }
+
+        double ratio = static_cast<double>(iterations) / max_iterations;
+
+        int r, g, b;
+
+        if (ratio < 0.16) {
+            r = static_cast<int>(255 * ratio * 6);
+            g = 0;
+            b = static_cast<int>(255 * (1 - ratio * 6));
+        } else if (ratio < 0.33) {
+            double r_ratio = (ratio - 0.16) * 6;
+            r = 255;
+            g = static_cast<int>(255 * r_ratio);
+            b = 0;
+        } else if (ratio < 0.5) {
+            double r_ratio = (ratio - 0.33) * 6;
+            r = 255;
+            g = 255;
+            b = static_cast<int>(255 * r_ratio);
+        } else if (ratio < 0.66) {
+            double r_ratio = (ratio - 0.5) * 6;
+            r = static_cast<int>(255 * (1 - r_ratio));
+            g = 255;
+            b = 255;
+        } else if (ratio < 0.83) {
+            double r_ratio = (ratio - 0.66) * 6;
+            r = 0;
+            g = static_cast<int>(255 * (1 - r_ratio));
+            b = 255;
+        } else {
+            double r_ratio = (ratio - 0.83) * 6;
+            r = static_cast<int>(255 * r_ratio);
+            g = 0;
+            b = 255;
+        }
+
+        return pack_rgb(r, g, b);
+    }
+
+    // Convert screen coordinates to complex plane
+    std::complex<double> screen_to_complex(const ViewState& v, int x, int y) const {
+        double scale = 4.0 / v.zoom;
+        double real = v.center_real + (x - width / 2.0) * scale / width;
+        double imag = v.center_imag + (y - height / 2.0) * scale / height;
+        return std::complex<double>(real, imag);
+    }
+
+    // Iterations for one screen pixel in the given view
+    int iterate_pixel(const ViewState& v, int x, int y) const {
+        std::complex<double> point = screen_to_complex(v, x, y);
+        return v.is_julia ? julia_iterations(point, v.julia_c, v.max_iterations)
+                          : mandelbrot_iterations(point, v.max_iterations);
+    }
+
+    // Render tiles most-expensive-first, with costs predicted from the previous
+    // frame's tile map remapped into the current view. Cheap tiles are grouped
+    // into chunks whose target cost shrinks with the remaining work (guided),
+    // so the last chunks handed out are small.
+    void render_tiles_lpt(const ViewState& v, std::vector<uint32_t>& pixels, int num_threads,
+                          std::vector<double>& finish_ms,
+                          std::chrono::high_resolution_clock::time_point start_time) {
+        int tiles_x = (width + TILE_SIZE - 1) / TILE_SIZE;
+        int tiles_y = (height + TILE_SIZE - 1) / TILE_SIZE;
+        int tiles = tiles_x * tiles_y;
+
+        std::vector<std::pair<double, int>> order(tiles);
+        bool predicted = tile_cost_valid && tile_cost_julia == v.is_julia;
+        (predicted ? metric_cache_hit : metric_cache_miss)->add();
+        double mean = 0.0;
+        if (predicted) {
+            for (double c : tile_cost) mean += c;
+            mean /= tile_cost.size();
+        }
+
+        double total = 0.0;
+        for (int t = 0; t < tiles; t++) {
+            int x0 = (t % tiles_x) * TILE_SIZE;
+            int y0 = (t / tiles_x) * TILE_SIZE;
+            int tw = std::min(TILE_SIZE, width - x0);
+            int th = std::min(TILE_SIZE, height - y0);
+            double cost = 0.0;
+            if (predicted) {
+                // Tile center in the complex plane, then back into the old view
+                std::complex<double> c = screen_to_complex(v, x0 + tw / 2, y0 + th / 2);
+                double old_scale = 4.0 / tile_cost_zoom;
+                int px = static_cast<int>((c.real() - tile_cost_real) * width / old_scale + width / 2.0);
+                int py = static_cast<int>((c.imag() - tile_cost_imag) * height / old_scale + height / 2.0);
+                double per_pixel = mean;
+                if (px >= 0 && px < width && py >= 0 && py < height) {
+                    per_pixel = tile_cost[(py / TILE_SIZE) * tiles_x + px / TILE_SIZE];
+                }
+                cost = per_pixel * tw * th;
+            }
+            order[t] = std::make_pair(cost, t);
+            total += cost;
+        }
+        if (predicted) {
+            std::stable_sort(order.begin(), order.end(),
+                             [](const std::pair<double, int>& a, const std::pair<double, int>& b) {
+                                 return a.first > b.first;
+                             });
+        }
+
+        std::vector<int> chunk_start;
+        double remaining = total;
+        double acc = 0.0;
+        for (int i = 0; i < tiles; i++) {
+            if (acc == 0.0) chunk_start.push_back(i);
+            acc += order[i].first;
+            if (!predicted || acc >= remaining / (num_threads * 4)) {
+                remaining -= acc;
+                acc = 0.0;
+            }
+        }
+        chunk_start.push_back(tiles);
+        int chunks = static_cast<int>(chunk_start.size()) - 1;
+
+        std::vector<double> new_cost(tiles, 0.0);
+        std::atomic<int> next_chunk(0);
+        std::vector<std::thread> threads;
+
+        for (int t = 0; t < num_threads; t++) {
+            threads.emplace_back([&, t]() {
+                int c;
+                while ((c = next_chunk.fetch_add(1)) < chunks) {
+                    for (int i = chunk_start[c]; i < chunk_start[c + 1]; i++) {
+                        int tile = order[i].second;
+                        int x0 = (tile % tiles_x) * TILE_SIZE;
+                        int y0 = (tile / tiles_x) * TILE_SIZE;
+                        int x1 = std::min(width, x0 + TILE_SIZE);
+                        int y1 = std::min(height, y0 + TILE_SIZE);
+                        long long sum = 0;
+
+                        for (int y = y0; y < y1; y++) {
+                            for (int x = x0; x < x1; x++) {
+                                int iterations = iterate_pixel(v, x, y);
+                                pixels[y * width + x] = get_color(iterations, v.max_iterations);
+                                sum += iterations;
+                            }
+                        }
+                        new_cost[tile] = static_cast<double>(sum) / ((x1 - x0) * (y1 - y0));
+                        metric_iterations->add(static_cast<uint64_t>(sum));
+                        metric_tiles->add();
+                    }
+                }
+                finish_ms[t] = std::chrono::duration<double, std::milli>(
+                    std::chrono::high_resolution_clock::now() - start_time).count();
+            });
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        tile_cost.swap(new_cost);
+        tile_cost_valid = true;
+        tile_cost_julia = v.is_julia;
+        tile_cost_zoom = v.zoom;
+        tile_cost_real = v.center_real;
+        tile_cost_imag = v.center_imag;
+    }
+
+    // Render one frame of view v into frame (the triple buffer's back buffer)
+    void render_frame(ViewState v, Frame& frame) {
+        auto start_time = std::chrono::high_resolution_clock::now();
+
+        if (v.auto_iterations) {
+            v.max_iterations = choose_auto_iterations(v);
+            last_iterations = v.max_iterations;
+        }
+        double render_begin_ms = std::chrono::duration<double, std::milli>(
+            std::chrono::high_resolution_clock::now() - start_time).count();
+        if (v.auto_iterations) metric_auto_s->observe(render_begin_ms / 1000.0);
+
+        // Multi-threaded rendering
+        int num_threads = std::max(1u, std::thread::hardware_concurrency());
+        std::vector<double> finish_ms(num_threads, 0.0);
+
+        if (v.lpt_scheduling) {
+            render_tiles_lpt(v, frame.pixels, num_threads, finish_ms, start_time);
+        } else {
+            std::vector<std::thread> threads;
+            int rows_per_thread = height / num_threads;
+            std::vector<uint32_t>& pixels = frame.pixels;
+
+            for (int t = 0; t < num_threads; t++) {
+                int start_row = t * rows_per_thread;
+                int end_row = (t == num_threads - 1) ? height : start_row + rows_per_thread;
+
+                threads.emplace_back([this, &v, &pixels, t, start_row, end_row, start_time, &finish_ms]() {
+                    long long sum = 0;
+                    for (int y = start_row; y < end_row; y++) {
+                        for (int x = 0; x < width; x++) {
+                            int iterations = iterate_pixel(v, x, y);
+                            pixels[y * width + x] = get_color(iterations, v.max_iterations);
+                            sum += iterations;
+                        }
+                    }
+                    metric_iterations->add(static_cast<uint64_t>(sum));
+                    metric_rows->add(static_cast<uint64_t>(end_row - start_row));
+                    finish_ms[t] = std::chrono::duration<double, std::milli>(
+                        std::chrono::high_resolution_clock::now() - start_time).count();
+                });
+            }
+
+            for (auto& thread : threads) {
+                thread.join();
+            }
+            tile_cost_valid = false;
+        }
+
+        // Straggler tail: first thread going idle until the last one finishes
+        auto finish_range = std::minmax_element(finish_ms.begin(), finish_ms.end());
+        frame.tail_ms = *finish_range.second - *finish_range.first;
+
+        auto end_time = std::chrono::high_resolution_clock::now();
+        frame.frame_ms = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+        frame.view = v;
+
+        // Utilization of the parallel section: each worker is busy from its
+        // start until it runs out of work, available until the last one ends
+        double busy_ms = 0.0;
+        for (double f : finish_ms) busy_ms += f - render_begin_ms;
+        double capacity_ms = num_threads * (*finish_range.second - render_begin_ms);
+        metric_busy_us->add(static_cast<uint64_t>(busy_ms * 1000.0));
+        metric_capacity_us->add(static_cast<uint64_t>(capacity_ms * 1000.0));
+        if (capacity_ms > 0.0) metric_utilization->set(busy_ms / capacity_ms);
+        metric_threads->set(num_threads);
+        metric_render_s->observe((*finish_range.second - render_begin_ms) / 1000.0);
+        metric_tail_s->observe(frame.tail_ms / 1000.0);
+        metric_frame_s->observe(frame.frame_ms / 1000.0);
+    }
+
+    // Render thread: wait for a request, render the newest requested view into
+    // the back buffer, publish it. Requests posted during a render collapse
+    // into one follow-up frame.
+    void render_loop() {
+        for (;;) {
+            ViewState v;
+            uint64_t seq;
+            {
+                std::unique_lock<std::mutex> lock(request_mutex);
+                request_cv.wait(lock, [this]() { return stopping || request_seq != rendered_seq; });
+                if (stopping) return;
+                v = requested_view;
+                seq = request_seq;
+                metric_coalesced->add(seq - rendered_seq - 1);
+                metric_queue_s->observe(std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - oldest_request).count());
+                rendered_seq = seq;
+                metric_queue_depth->set(0.0);
+            }
+
+            Frame& frame = frames.back();
+            render_frame(v, frame);
+            frame.id = ++frames_published;
+            frame.request = seq;
+            frame.published = std::chrono::steady_clock::now();
+
+            // Read-only from here on: the presenter may already be reading it
+            const Frame& published = frame;
+            frames.publish();
+            metric_frames->add();
+            frame_rendered(published);
+        }
+    }
+
+    // === Actions (UI thread) ===
+    // Each returns the render request it posted, or 0 when the view did not change.
+
+    // Zoom to selected area
+    uint64_t zoom_to_area(int start_x, int start_y, int end_x, int end_y) {
+        std::complex<double> new_center = screen_to_complex(view, (start_x + end_x) / 2, (start_y + end_y) / 2);
+
+        int selection_width = std::abs(end_x - start_x);
+        int selection_height = std::abs(end_y - start_y);
+
+        if (selection_width > 10 && selection_height > 10) {
+            double zoom_factor = static_cast<double>(width) / selection_width;
+            view.zoom *= zoom_factor;
+            view.center_real = new_center.real();
+            view.center_imag = new_center.imag();
+
+            return request_render();
+        }
+        return 0;
+    }
+
+    // Pan view
+    uint64_t pan(int delta_x, int delta_y) {
+        double scale = 4.0 / view.zoom;
+        view.center_real -= delta_x * scale / width;
+        view.center_imag -= delta_y * scale / height;
+        return request_render();
+    }
+
+    // Update Julia constant
+    uint64_t update_julia_constant(int mouse_x, int mouse_y) {
+        if (view.is_julia) {
+            std::complex<double> new_c = screen_to_complex(view, mouse_x, mouse_y);
+            double real_part = std::max(-2.0, std::min(2.0, new_c.real()));
+            double imag_part = std::max(-2.0, std::min(2.0, new_c.imag()));
+            view.julia_c = std::complex<double>(real_part, imag_part);
+            return request_render();
+        }
+        return 0;
+    }
+
+    uint64_t toggle_julia() {
+        view.is_julia = !view.is_julia;
+        return request_render();
+    }
+
+    uint64_t reset_view() {
+        view.zoom = 1.0;
+        view.center_real = view.is_julia ? 0.0 : -0.5;
+        view.center_imag = 0.0;
+        view.max_iterations = 100;
+        return request_render();
+    }
+
+    uint64_t toggle_lpt_scheduling() {
+        view.lpt_scheduling = !view.lpt_scheduling;
+        return request_render();
+    }
+
+    uint64_t toggle_auto_iterations() {
+        view.auto_iterations = !view.auto_iterations;
+        return request_render();
+    }
+
+    // +/- continue from the limit auto mode picked last, if it was on; the
+    // manual range goes up to the auto-mode ceiling so + never lowers it
+    uint64_t increase_iterations() {
+        if (view.auto_iterations) view.max_iterations = last_iterations.load();
+        view.auto_iterations = false;
+        int next = view.max_iterations + 50;
+        view.max_iterations = next < MAX_ITERATIONS ? next : MAX_ITERATIONS;
+        return request_render();
+    }
+
+    uint64_t decrease_iterations() {
+        if (view.auto_iterations) view.max_iterations = last_iterations.load();
+        view.auto_iterations = false;
+        view.max_iterations = std::max(50, view.max_iterations - 50);
+        return request_render();
+    }
+};
+
+#endif
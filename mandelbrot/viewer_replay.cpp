@@ -0,0 +1,622 @@
+// viewer_replay.cpp - Headless interaction-trace replay benchmark for the fractal viewer
+//
+// Drives the viewer core (viewer_core.h, the same state machine and render
+// thread the Windows GUI uses) from a recorded input trace and reports
+// per-event input-to-present latency percentiles and dropped updates, so
+// responsiveness can be measured and regression-tested without a window.
+//
+// Trace format, one event per line (# starts a comment):
+//   <time_ms> zoom <x0> <y0> <x1> <y1>   left-drag selection released
+//   <time_ms> pan <dx> <dy>              right-drag mouse move (pixel delta)
+//   <time_ms> move <x> <y>               mouse move (updates the Julia constant)
+//   <time_ms> key <M|R|T|A|+|->          key press
+//
+// Replay mirrors the GUI threads: the replay thread plays the UI thread and
+// applies each event at its trace time (actions only post a render request),
+// the core's render thread renders the newest request, and a presenter thread
+// picks up the latest published frame once per display refresh. An input's
+// latency runs until the first presented frame that includes it; a request
+// that was superseded before the renderer got to it is a dropped update.
+//
+// --swap-bench measures the frame exchange itself: publish cost and
+// publish-to-visible latency of the triple buffer against a mutex + copy
+// handoff, with a tearing check on every frame the reader sees.
+//
+// --metrics-file / --metrics-port export the core's metrics registry during
+// the replay (Prometheus text format), e.g. curl 127.0.0.1:9464/metrics.
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include "viewer_core.h"
+
+enum EventType { EV_ZOOM, EV_PAN, EV_MOVE, EV_KEY, EV_TYPES };
+static const char* event_names[EV_TYPES] = {"zoom", "pan", "julia", "key"};
+
+struct TraceEvent {
+    double time_ms;
+    EventType type;
+    int a, b, c, d;
+    char key;
+};
+
+struct EventStats {
+    std::vector<double> latency_ms;   // input time -> frame presented
+    std::vector<double> frame_ms;     // render time of the frame alone
+    int events = 0;                   // inputs in the trace
+    int dropped = 0;                  // requests superseded before rendering
+    int no_frame = 0;                 // inputs that did not change the view
+};
+
+// One frame the presenter put on screen
+struct PresentedFrame {
+    double time_ms;
+    uint64_t id;
+    uint64_t request;
+    double frame_ms;
+    double tail_ms;
+    int iterations;
+};
+
+class HeadlessViewer : public FractalViewerCore {
+public:
+    HeadlessViewer(int w, int h) : FractalViewerCore(w, h) {}
+    ~HeadlessViewer() { stop_renderer(); }
+
+    void set_lpt(bool enabled) {
+        view.lpt_scheduling = enabled;
+    }
+
+    // Presenter thread only
+    const Frame& present() { return latest_frame(); }
+
+    // Requests that got a frame of their own; read after stop_renderer()
+    std::vector<uint64_t> rendered_requests;
+
+protected:
+    void frame_rendered(const Frame& frame) override {
+        rendered_requests.push_back(frame.request);
+    }
+};
+
+// FNV-1a over a frame, to spot behavior changes between builds
+static uint64_t frame_hash(const Frame& frame) {
+    uint64_t h = 1469598103934665603ULL;
+    for (uint32_t p : frame.pixels) {
+        h ^= p;
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+static bool load_trace(const char* path, std::vector<TraceEvent>& events) {
+    std::ifstream in(path);
+    if (!in) return false;
+    std::string line;
+    int line_no = 0;
+    while (std::getline(in, line)) {
+        line_no++;
+        size_t hash = line.find('#');
+        if (hash != std::string::npos) line.erase(hash);
+        std::istringstream ss(line);
+        TraceEvent ev = {};
+        std::string kind;
+        if (!(ss >> ev.time_ms)) continue;
+        ss >> kind;
+        bool ok = true;
+        if (kind == "zoom") {
+            ev.type = EV_ZOOM;
+            ok = static_cast<bool>(ss >> ev.a >> ev.b >> ev.c >> ev.d);
+        } else if (kind == "pan") {
+            ev.type = EV_PAN;
+            ok = static_cast<bool>(ss >> ev.a >> ev.b);
+        } else if (kind == "move") {
+            ev.type = EV_MOVE;
+            ok = static_cast<bool>(ss >> ev.a >> ev.b);
+        } else if (kind == "key") {
+            std::string key;
+            ev.type = EV_KEY;
+            ok = static_cast<bool>(ss >> key) && key.size() == 1 &&
+                 std::strchr("MRTA+-", key[0]) != NULL;
+            if (ok) ev.key = key[0];
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            std::cerr << "Error: " << path << ":" << line_no << ": invalid event" << std::endl;
+            return false;
+        }
+        events.push_back(ev);
+    }
+    std::stable_sort(events.begin(), events.end(),
+                     [](const TraceEvent& x, const TraceEvent& y) { return x.time_ms < y.time_ms; });
+    return true;
+}
+
+// Synthetic exploration session: zoom in, drag around, switch to Julia and
+// sweep the constant, change iterations, toggle scheduling, reset. Mouse
+// events are spaced 8ms apart (125Hz mouse).
+static bool generate_trace(const char* path, int width, int height) {
+    std::ofstream out(path);
+    if (!out) return false;
+    double t = 200.0;
+    int cx = width / 2, cy = height / 2;
+    out << "# Synthetic viewer session (" << width << "x" << height << "), generated by viewer_replay --generate\n";
+    out << "# time_ms event args\n";
+    for (int i = 0; i < 4; i++) {
+        int hw = width / 4, hh = height / 4;
+        int ox = (i % 2 ? 1 : -1) * width / 16;
+        out << t << " zoom " << cx + ox - hw << " " << cy - hh << " " << cx + ox + hw << " " << cy + hh << "\n";
+        t += 600.0;
+    }
+    for (int i = 0; i < 60; i++) {
+        out << t << " pan " << 4 << " " << (i < 30 ? 2 : -2) << "\n";
+        t += 8.0;
+    }
+    t += 300.0;
+    out << t << " key +\n"; t += 250.0;
+    out << t << " key +\n"; t += 250.0;
+    out << t << " key -\n"; t += 400.0;
+    out << t << " key R\n"; t += 400.0;
+    out << t << " key M\n"; t += 400.0;
+    for (int i = 0; i < 120; i++) {
+        double angle = i * 2.0 * 3.14159265358979 / 120.0;
+        int x = cx + static_cast<int>(width * 0.2 * std::cos(angle));
+        int y = cy + static_cast<int>(height * 0.2 * std::sin(angle));
+        out << t << " move " << x << " " << y << "\n";
+        t += 8.0;
+    }
+    t += 300.0;
+    out << t << " key T\n"; t += 400.0;
+    for (int i = 0; i < 40; i++) {
+        out << t << " pan " << -3 << " " << 1 << "\n";
+        t += 8.0;
+    }
+    t += 300.0;
+    out << t << " key A\n"; t += 400.0;
+    out << t << " key M\n"; t += 400.0;
+    out << t << " key R\n";
+    return static_cast<bool>(out);
+}
+
+static double percentile(std::vector<double> values, double p) {
+    if (values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    size_t index = static_cast<size_t>(p / 100.0 * (values.size() - 1) + 0.5);
+    return values[std::min(index, values.size() - 1)];
+}
+
+static uint64_t apply_event(HeadlessViewer& viewer, const TraceEvent& ev) {
+    switch (ev.type) {
+        case EV_ZOOM: return viewer.zoom_to_area(ev.a, ev.b, ev.c, ev.d);
+        case EV_PAN:  return viewer.pan(ev.a, ev.b);
+        case EV_MOVE: return viewer.update_julia_constant(ev.a, ev.b);
+        case EV_KEY:
+            switch (ev.key) {
+                case 'M': return viewer.toggle_julia();
+                case 'R': return viewer.reset_view();
+                case 'T': return viewer.toggle_lpt_scheduling();
+                case 'A': return viewer.toggle_auto_iterations();
+                case '+': return viewer.increase_iterations();
+                case '-': return viewer.decrease_iterations();
+            }
+            break;
+        default:
+            break;
+    }
+    return 0;
+}
+
+// === Frame exchange micro-benchmark ===
+
+typedef std::chrono::steady_clock Clock;
+
+static double ms_since(Clock::time_point t) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - t).count();
+}
+
+struct SwapResult {
+    std::vector<double> publish_us;   // writer: cost of handing a frame over
+    std::vector<double> visible_us;   // publish -> reader has the frame
+    int seen = 0;
+    int torn = 0;
+};
+
+// Writer fills a whole frame with its id and hands it over every interval;
+// the reader polls and checks that every pixel of each new frame carries the
+// same id. Triple buffer: the writer renders straight into the back buffer
+// and publishes with one atomic exchange.
+static void swap_bench_triple(int pixels, int frames, double interval_ms, SwapResult& r) {
+    TripleBuffer<Frame> exchange;
+    TripleBuffer<Frame>* buffer = &exchange;
+    for (int i = 0; i < 3; i++) {
+        buffer->buffer(i).pixels.assign(pixels, 0);
+        buffer->buffer(i).id = 0;
+    }
+    std::atomic<bool> done(false);
+
+    std::thread reader([&]() {
+        uint64_t last = 0;
+        while (!done.load(std::memory_order_acquire) || buffer->has_new()) {
+            const Frame& f = buffer->latest();
+            if (f.id != last) {
+                r.visible_us.push_back(ms_since(f.published) * 1000.0);
+                for (uint32_t p : f.pixels) {
+                    if (p != static_cast<uint32_t>(f.id)) {
+                        r.torn++;
+                        break;
+                    }
+                }
+                r.seen++;
+                last = f.id;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    Clock::time_point next = Clock::now();
+    for (int id = 1; id <= frames; id++) {
+        Frame& f = buffer->back();
+        std::fill(f.pixels.begin(), f.pixels.end(), static_cast<uint32_t>(id));
+        f.id = id;
+        Clock::time_point t0 = Clock::now();
+        f.published = t0;
+        buffer->publish();
+        r.publish_us.push_back(ms_since(t0) * 1000.0);
+        next += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(interval_ms));
+        std::this_thread::sleep_until(next);
+    }
+    done.store(true, std::memory_order_release);
+    reader.join();
+}
+
+// Baseline: one shared frame behind a mutex; the writer renders privately and
+// copies in, the reader copies out under the same lock before looking at it
+static void swap_bench_mutex(int pixels, int frames, double interval_ms, SwapResult& r) {
+    std::mutex lock;
+    Frame shared, local, view;
+    shared.pixels.assign(pixels, 0);
+    shared.id = 0;
+    local.pixels.assign(pixels, 0);
+    view.pixels.assign(pixels, 0);
+    std::atomic<bool> done(false);
+
+    std::thread reader([&]() {
+        uint64_t last = 0;
+        for (;;) {
+            bool finished = done.load(std::memory_order_acquire);
+            bool fresh = false;
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                if (shared.id != last) {
+                    std::memcpy(view.pixels.data(), shared.pixels.data(), pixels * sizeof(uint32_t));
+                    view.id = shared.id;
+                    view.published = shared.published;
+                    fresh = true;
+                }
+            }
+            if (fresh) {
+                r.visible_us.push_back(ms_since(view.published) * 1000.0);
+                for (uint32_t p : view.pixels) {
+                    if (p != static_cast<uint32_t>(view.id)) {
+                        r.torn++;
+                        break;
+                    }
+                }
+                r.seen++;
+                last = view.id;
+            } else if (finished) {
+                break;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    Clock::time_point next = Clock::now();
+    for (int id = 1; id <= frames; id++) {
+        std::fill(local.pixels.begin(), local.pixels.end(), static_cast<uint32_t>(id));
+        Clock::time_point t0 = Clock::now();
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            std::memcpy(shared.pixels.data(), local.pixels.data(), pixels * sizeof(uint32_t));
+            shared.id = id;
+            shared.published = t0;
+        }
+        r.publish_us.push_back(ms_since(t0) * 1000.0);
+        next += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(interval_ms));
+        std::this_thread::sleep_until(next);
+    }
+    done.store(true, std::memory_order_release);
+    reader.join();
+}
+
+static int run_swap_bench(int width, int height, int frames, double interval_ms) {
+    int pixels = width * height;
+    std::cout << "=== Frame Exchange Benchmark ===" << std::endl;
+    std::cout << "Frame: " << width << "x" << height << " (" << pixels * 4 / 1024 << " KB), "
+              << frames << " frames every " << interval_ms << " ms, threads: "
+              << std::max(1u, std::thread::hardware_concurrency()) << std::endl << std::endl;
+
+    SwapResult triple, locked;
+    swap_bench_triple(pixels, frames, interval_ms, triple);
+    swap_bench_mutex(pixels, frames, interval_ms, locked);
+
+    char row[256];
+    std::snprintf(row, sizeof(row), "%-14s %8s %8s %6s %11s %11s %11s %11s",
+                  "Exchange", "Frames", "Seen", "Torn", "Pub50(us)", "Pub99(us)", "Vis50(us)", "Vis99(us)");
+    std::cout << row << std::endl;
+    const SwapResult* results[2] = {&triple, &locked};
+    const char* names[2] = {"triple buffer", "mutex + copy"};
+    for (int i = 0; i < 2; i++) {
+        const SwapResult& r = *results[i];
+        std::snprintf(row, sizeof(row), "%-14s %8d %8d %6d %11.2f %11.2f %11.1f %11.1f",
+                      names[i], frames, r.seen, r.torn,
+                      percentile(r.publish_us, 50), percentile(r.publish_us, 99),
+                      percentile(r.visible_us, 50), percentile(r.visible_us, 99));
+        std::cout << row << std::endl;
+    }
+    std::cout << std::endl << "Seen < Frames: the reader skipped frames superseded before it looked "
+              << "(newest frame wins)" << std::endl;
+
+    if (triple.torn > 0 || locked.torn > 0) {
+        std::cout << "FAIL: torn frames observed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+static void print_usage(const char* program) {
+    std::cout << "Usage: " << program << " [trace_file] [--size w h] [--lpt] [--budget ms] [--present-hz n]\n"
+              << "       [--max-p99 ms] [--max-dropped n] [--csv file]\n"
+              << "       [--metrics-file file [--metrics-interval s]] [--metrics-port n]\n"
+              << "       " << program << " --generate trace_file [--size w h]\n"
+              << "       " << program << " --swap-bench frames [--size w h] [--interval ms]\n";
+}
+
+int main(int argc, char** argv) {
+    const char* trace_path = "viewer_trace_example.txt";
+    const char* generate_path = NULL;
+    const char* csv_path = NULL;
+    const char* metrics_path = NULL;
+    double metrics_interval = 1.0;
+    int metrics_port = 0;
+    int width = 800, height = 600;
+    bool lpt = false;
+    double budget_ms = 1000.0 / 60.0;
+    double present_hz = 60.0;
+    double max_p99 = -1.0;
+    int max_dropped = -1;
+    int swap_frames = 0;
+    double swap_interval_ms = 2.0;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--size" && i + 2 < argc) {
+            width = std::atoi(argv[++i]);
+            height = std::atoi(argv[++i]);
+        } else if (arg == "--lpt") {
+            lpt = true;
+        } else if (arg == "--budget" && i + 1 < argc) {
+            budget_ms = std::atof(argv[++i]);
+        } else if (arg == "--present-hz" && i + 1 < argc) {
+            present_hz = std::atof(argv[++i]);
+        } else if (arg == "--max-p99" && i + 1 < argc) {
+            max_p99 = std::atof(argv[++i]);
+        } else if (arg == "--max-dropped" && i + 1 < argc) {
+            max_dropped = std::atoi(argv[++i]);
+        } else if (arg == "--csv" && i + 1 < argc) {
+            csv_path = argv[++i];
+        } else if (arg == "--metrics-file" && i + 1 < argc) {
+            metrics_path = argv[++i];
+        } else if (arg == "--metrics-interval" && i + 1 < argc) {
+            metrics_interval = std::atof(argv[++i]);
+        } else if (arg == "--metrics-port" && i + 1 < argc) {
+            metrics_port = std::atoi(argv[++i]);
+        } else if (arg == "--generate" && i + 1 < argc) {
+            generate_path = argv[++i];
+        } else if (arg == "--swap-bench" && i + 1 < argc) {
+            swap_frames = std::atoi(argv[++i]);
+        } else if (arg == "--interval" && i + 1 < argc) {
+            swap_interval_ms = std::atof(argv[++i]);
+        } else if (arg[0] != '-') {
+            trace_path = argv[i];
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (width < 16 || height < 16 || present_hz <= 0.0 || swap_frames < 0 || swap_interval_ms < 0.0 ||
+        metrics_interval <= 0.0 || metrics_port < 0 || metrics_port > 65535) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    if (swap_frames > 0) {
+        return run_swap_bench(width, height, swap_frames, swap_interval_ms);
+    }
+
+    if (generate_path) {
+        if (!generate_trace(generate_path, width, height)) {
+            std::cerr << "Error: cannot write " << generate_path << std::endl;
+            return 1;
+        }
+        std::cout << "Trace written: " << generate_path << std::endl;
+        return 0;
+    }
+
+    std::vector<TraceEvent> events;
+    if (!load_trace(trace_path, events)) {
+        std::cerr << "Error: cannot read trace " << trace_path << std::endl;
+        return 1;
+    }
+
+    HeadlessViewer viewer(width, height);
+    viewer.set_lpt(lpt);
+
+    MetricsFileExporter metrics_file(viewer.metrics_registry(), metrics_path ? metrics_path : "", metrics_interval);
+    if (metrics_path && !metrics_file.start()) {
+        std::cerr << "Error: cannot write " << metrics_path << std::endl;
+        return 1;
+    }
+    MetricsHttpExporter metrics_http(viewer.metrics_registry(), metrics_port);
+    if (metrics_port && !metrics_http.start()) {
+        std::cerr << "Error: cannot listen on 127.0.0.1:" << metrics_port << std::endl;
+        return 1;
+    }
+
+    std::cout << "=== Viewer Trace Replay (headless) ===" << std::endl;
+    std::cout << "Trace: " << trace_path << " (" << events.size() << " events), "
+              << width << "x" << height << ", threads: "
+              << std::max(1u, std::thread::hardware_concurrency())
+              << ", present: " << present_hz << " Hz" << std::endl;
+    if (metrics_path) std::cout << "Metrics: " << metrics_path << " every " << metrics_interval << " s" << std::endl;
+    if (metrics_port) std::cout << "Metrics: http://127.0.0.1:" << metrics_port << "/metrics" << std::endl;
+
+    // The GUI shows one frame before the message loop starts; not counted
+    viewer.start_renderer();
+    uint64_t initial = viewer.request_render();
+    while (viewer.present().request < initial) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::cout << "Initial frame: " << viewer.present().frame_ms << " ms" << std::endl << std::endl;
+
+    Clock::time_point start = Clock::now();
+
+    // Presenter: one look at the triple buffer per display refresh
+    std::vector<PresentedFrame> presented;
+    std::atomic<uint64_t> last_request(initial);
+    std::atomic<bool> presenter_stop(false);
+    std::thread presenter([&]() {
+        uint64_t shown = viewer.present().id;
+        Clock::duration period = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(1.0 / present_hz));
+        Clock::time_point tick = Clock::now();
+        for (;;) {
+            const Frame& f = viewer.present();
+            if (f.id != shown) {
+                PresentedFrame p = {ms_since(start), f.id, f.request, f.frame_ms, f.tail_ms,
+                                    f.view.max_iterations};
+                presented.push_back(p);
+                viewer.frame_presented(f);
+                shown = f.id;
+            }
+            if (presenter_stop.load() && f.request >= last_request.load()) break;
+            tick += period;
+            std::this_thread::sleep_until(tick);
+        }
+    });
+
+    // Replay thread = UI thread: apply each event at its trace time
+    std::vector<uint64_t> requests(events.size(), 0);
+    for (size_t i = 0; i < events.size(); i++) {
+        double clock = ms_since(start);
+        if (events[i].time_ms > clock) {
+            std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(events[i].time_ms - clock));
+        }
+        requests[i] = apply_event(viewer, events[i]);
+        if (requests[i]) last_request = requests[i];
+    }
+    presenter_stop = true;
+    presenter.join();
+    double total_ms = ms_since(start);
+
+    // Presenter has exited; this thread takes over the consumer side
+    viewer.stop_renderer();
+    const std::vector<uint64_t>& rendered = viewer.rendered_requests;
+    int rendered_count = static_cast<int>(rendered.size()) - 1;   // minus the initial frame
+
+    EventStats stats[EV_TYPES];
+    int over_budget = 0;
+    for (const PresentedFrame& p : presented) {
+        if (p.frame_ms > budget_ms) over_budget++;
+    }
+
+    std::ofstream csv;
+    if (csv_path) {
+        csv.open(csv_path);
+        csv << "time_ms,event,request,superseded,latency_ms,frame_ms,tail_ms,iterations\n";
+    }
+
+    size_t cursor = 0, rendered_cursor = 0;
+    for (size_t i = 0; i < events.size(); i++) {
+        EventStats& st = stats[events[i].type];
+        st.events++;
+        uint64_t req = requests[i];
+        if (req == 0) {
+            st.no_frame++;
+            continue;
+        }
+        while (cursor < presented.size() && presented[cursor].request < req) cursor++;
+        while (rendered_cursor < rendered.size() && rendered[rendered_cursor] < req) rendered_cursor++;
+        bool superseded = rendered_cursor == rendered.size() || rendered[rendered_cursor] != req;
+        if (superseded) st.dropped++;
+        if (cursor == presented.size()) continue;
+        const PresentedFrame& p = presented[cursor];
+        double latency = p.time_ms - events[i].time_ms;
+        st.latency_ms.push_back(latency);
+        st.frame_ms.push_back(p.frame_ms);
+        if (csv_path) {
+            csv << events[i].time_ms << "," << event_names[events[i].type] << "," << req << ","
+                << (superseded ? 1 : 0) << "," << latency << "," << p.frame_ms << "," << p.tail_ms << ","
+                << p.iterations << "\n";
+        }
+    }
+
+    std::vector<double> all_latency;
+    int all_dropped = 0, all_events = 0, all_requests = 0;
+    char row[256];
+    std::snprintf(row, sizeof(row), "%-7s %7s %8s %7s %8s %9s %9s %9s %9s %9s",
+                  "Event", "Inputs", "Requests", "Dropped", "NoFrame", "p50(ms)", "p90(ms)", "p99(ms)",
+                  "Max(ms)", "Render50");
+    std::cout << row << std::endl;
+    for (int t = 0; t < EV_TYPES; t++) {
+        const EventStats& st = stats[t];
+        if (st.events == 0) continue;
+        int requested = st.events - st.no_frame;
+        std::snprintf(row, sizeof(row), "%-7s %7d %8d %7d %8d %9.1f %9.1f %9.1f %9.1f %9.1f",
+                      event_names[t], st.events, requested, st.dropped,
+                      st.no_frame, percentile(st.latency_ms, 50), percentile(st.latency_ms, 90),
+                      percentile(st.latency_ms, 99), percentile(st.latency_ms, 100),
+                      percentile(st.frame_ms, 50));
+        std::cout << row << std::endl;
+        all_latency.insert(all_latency.end(), st.latency_ms.begin(), st.latency_ms.end());
+        all_dropped += st.dropped;
+        all_events += st.events;
+        all_requests += requested;
+    }
+    double p99 = percentile(all_latency, 99);
+    std::snprintf(row, sizeof(row), "%-7s %7d %8d %7d %8s %9.1f %9.1f %9.1f %9.1f",
+                  "all", all_events, all_requests, all_dropped, "",
+                  percentile(all_latency, 50), percentile(all_latency, 90), p99,
+                  percentile(all_latency, 100));
+    std::cout << row << std::endl << std::endl;
+
+    int presented_count = static_cast<int>(presented.size());
+    std::cout << "Replay time: " << total_ms / 1000.0 << " s (trace spans "
+              << (events.empty() ? 0.0 : events.back().time_ms / 1000.0) << " s)" << std::endl;
+    std::cout << "Frames rendered: " << rendered_count << ", presented: " << presented_count
+              << ", replaced before presenting: " << rendered_count - presented_count << std::endl;
+    std::cout << "Frames over " << budget_ms << " ms budget: " << over_budget << "/" << presented_count << std::endl;
+    std::cout << "Dropped updates: " << all_dropped << "/" << all_requests
+              << " requests (superseded before rendering)" << std::endl;
+
+    const Frame& last = viewer.present();
+    std::cout << "Final view: zoom " << last.view.zoom << "x, " << last.view.max_iterations
+              << " iterations, frame hash " << std::hex << frame_hash(last) << std::dec << std::endl;
+
+    bool ok = true;
+    if (max_p99 >= 0.0 && p99 > max_p99) {
+        std::cout << "FAIL: p99 latency " << p99 << " ms exceeds " << max_p99 << " ms" << std::endl;
+        ok = false;
+    }
+    if (max_dropped >= 0 && all_dropped > max_dropped) {
+        std::cout << "FAIL: " << all_dropped << " dropped updates exceed " << max_dropped << std::endl;
+        ok = false;
+    }
+    return ok ? 0 : 1;
+}
@@ -1,6 +1,6 @@
 @echo off
 echo Compiling NTT-based big integer multiplication program...
-gcc program.c -O2 -std=c11 -o program.exe
+gcc program.c -O2 -std=c11 -fopenmp -o program.exe
 if %errorlevel% equ 0 (
     echo Compilation successful! program.exe created.
 ) else (
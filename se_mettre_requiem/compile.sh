@@ -1,6 +1,6 @@
 #!/bin/bash
 echo "Compiling NTT-based big integer multiplication program..."
-gcc program.c -O2 -std=c11 -o program
+gcc program.c -O2 -std=c11 -fopenmp -o program
 if [ $? -eq 0 ]; then
     echo "Compilation successful! program executable created."
 else
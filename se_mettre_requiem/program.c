@@ -1,16 +1,126 @@
+/*
+ * NTT big integer multiplication: reads two decimal numbers from stdin and
+ * prints their product.
+ *
+ * The default path does all arithmetic through the bitwise add()/sub()
+ * helpers below. The other arithmetic engines are selected on the command line:
+ *   --arith bitwise     default, bitwise double-and-add mul_mod()
+ *   --arith montgomery  32-bit Montgomery multiplication (R = 2^32)
+ *   --arith barrett     Barrett reduction (mu = floor(2^60 / MOD))
+ *   --isa scalar|avx2|avx512  SIMD level of the Montgomery kernels
+ *                          (default: the best the CPU supports)
+ *   --threads n            threads for the fast engines (0 = all processors;
+ *                          needs an OpenMP build, see compile.sh)
+ *   --pack k               k = 4..9 decimal digits per coefficient, convolution
+ *                          over three primes + CRT (implies montgomery
+ *                          unless --arith barrett is given)
+ *   --bench digits [reps]  multiply random operands with every engine,
+ *                          check that they agree and report timings, then
+ *                          digit I/O throughput
+ *   --scaling              thread scaling curve of the fast engine, from 1 to
+ *                          --threads (default: all processors)
+ *   --cutoffs k,t,n        shorter operand length in digits from which the
+ *                          fast engines use Karatsuba, Toom-3 and the NTT
+ *                          (below k: schoolbook; see --tune)
+ *   --tune                 measure those crossovers on this machine
+ *   --ntt radix2|radix4|sixstep|auto
+ *                          transform layout of the fast engines (default
+ *                          auto: radix-4, six-step for large transforms)
+ *   --bandwidth            memory traffic of each layout per transform size
+ *   --stats                peak memory use on stderr after the product
+ *
+ * Operand length is only limited by memory. Products too long for one
+ * transform modulo MOD (2^23 points) go through the packed path with k = 9.
+ */
+#define _POSIX_C_SOURCE 200809L
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <limits.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#endif
 
-#define MAXD 1000005
-#define MAXN (1<<21) /* 2,097,152 >= 2*1,000,000 */
 #define MOD 998244353
 #define G 3
 
-static char num1[MAXD];
-static char num2[MAXD];
-static int a_ntt[MAXN];
-static int b_ntt[MAXN];
-static int rev_bits[MAXN];
-static int digits[2200005]; /* result digits after carry */
+/* ===== Memory =====
+ * Buffers are sized from the operands and carved out of an arena: 64-byte
+ * aligned bump allocation from blocks that survive arena_reset(), so the
+ * next multiplication of the same size allocates nothing new. work_arena is
+ * reset at the start of every multiplication (the result digits stay valid
+ * until the next one); plan_arena holds the NTT plans for the whole run. */
+#define ARENA_ALIGN 64
+#define ARENA_BLOCK ((size_t)1 << 16)
+typedef struct arena_block {
+    struct arena_block *next;
+    char *base;            /* first aligned byte of the block */
+    size_t size, used;
+} arena_block;
+typedef struct {
+    arena_block *head, *cur;
+    size_t used, peak;     /* bytes handed out now / at most since start */
+    size_t reserved;       /* bytes held in blocks */
+} arena;
+static arena work_arena, plan_arena;
+
+static void *arena_alloc(arena *ar, size_t bytes){
+    bytes = (bytes + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+    /* the current block, else the first later one with room (after a reset
+     * those are all empty), else a new block at the end of the list */
+    arena_block *blk = ar->cur;
+    while(blk && blk->size - blk->used < bytes) blk = blk->next;
+    if(!blk){
+        size_t size = bytes > ARENA_BLOCK ? bytes : ARENA_BLOCK;
+        char *raw = malloc(sizeof(arena_block) + ARENA_ALIGN + size);
+        if(!raw){ fprintf(stderr, "out of memory (%.1f MB more requested)\n", size / 1048576.0); exit(1); }
+        blk = (arena_block *)raw;
+        blk->base = (char *)(((uintptr_t)(raw + sizeof(arena_block)) + ARENA_ALIGN - 1) & ~(uintptr_t)(ARENA_ALIGN - 1));
+        blk->size = size; blk->used = 0; blk->next = NULL;
+        arena_block **tail = &ar->head;
+        while(*tail) tail = &(*tail)->next;
+        *tail = blk;
+        ar->reserved += size;
+    }
+    ar->cur = blk;
+    void *ptr = blk->base + blk->used;
+    blk->used += bytes; ar->used += bytes;
+    if(ar->used > ar->peak) ar->peak = ar->used;
+    return ptr;
+}
+
+/* frees everything handed out, keeps the blocks */
+static void arena_reset(arena *ar){
+    for(arena_block *blk = ar->head; blk; blk = blk->next) blk->used = 0;
+    ar->cur = ar->head; ar->used = 0;
+}
+
+/* scratch inside one multiplication: arena_release(ar, m) frees everything
+ * handed out since m = arena_mark(ar) */
+typedef struct { arena_block *blk; size_t blk_used, used; } arena_pos;
+static arena_pos arena_mark(const arena *ar){
+    arena_pos m = { ar->cur, ar->cur ? ar->cur->used : 0, ar->used };
+    return m;
+}
+static void arena_release(arena *ar, arena_pos m){
+    /* allocation only moves forward, so nothing before m.blk changed */
+    for(arena_block *blk = m.blk ? m.blk->next : ar->head; blk; blk = blk->next) blk->used = 0;
+    if(m.blk) m.blk->used = m.blk_used;
+    ar->cur = m.blk ? m.blk : ar->head; ar->used = m.used;
+}
+
+static char *num1, *num2;
+static int *a_ntt, *b_ntt;
+static unsigned char *digits; /* result digits after carry */
 
 /* Bitwise add */
 int add(int x, int y){ if(!y) return x; return add(x ^ y, (x & y) << 1); }
@@ -52,60 +162,1264 @@ int pow_mod(int a,int e){
 
 int get_length(char *s){ int l=0; gl_loop: if(!(s[l])) goto gl_end; l=add(l,1); goto gl_loop; gl_end: return l; }
 
-/* Precompute bit-reversed indices */
-void build_rev(int n,int logn){
-    int i=0; br_loop:
-    if(!less_than(i,n)) goto br_end;
-    int x=i; int r=0; int k=0;
-    br_bit_loop:
-    if(!less_than(k,logn)) goto br_bit_end;
-    r = r << 1; /* shift */
-    if(x & 1) r = add(r,1);
-    x = x >> 1;
-    k = add(k,1);
-    goto br_bit_loop;
-    br_bit_end:
-    rev_bits[i]=r;
-    i=add(i,1);
-    goto br_loop;
-    br_end: ;
-}
+typedef uint32_t u32;
+typedef uint64_t u64;
+typedef unsigned __int128 u128;
+
+/* NTT-friendly prime p = c * 2^k + 1 with its precomputed constants */
+#define MODULI 4
+#define MAX_LOGN 27
+typedef struct {
+    u32 p, g;      /* prime, primitive root */
+    u32 ninv;      /* -p^-1 mod 2^32 (Montgomery, R = 2^32) */
+    u32 r1, r2;    /* R mod p, R^2 mod p */
+    u64 mu;        /* Barrett: floor(2^(2 shift) / p), shift = bit length of p */
+    int shift;
+    u32 bound;     /* butterflies keep values in [0, bound): 2p below 2^30, else p */
+    int max_logn;  /* 2^max_logn divides p - 1 */
+    int index;     /* position in moduli[] */
+} modulus;
+static modulus moduli[MODULI];
+
+/* NTT plan: everything a transform of size n needs that does not depend on
+ * the data. Built once per (size, twiddle form) and kept for the rest of the
+ * process, so forward and inverse transforms of every multiplication share it. */
+enum { FORM_NORMAL, FORM_MONTGOMERY, FORMS };
+typedef struct {
+    int n, logn;
+    u32 *rev;    /* rev[i] = i with its logn bits reversed (shared per size) */
+    u32 *root;   /* root[h + j] = w_2h^j  for h = 1, 2, 4, ..., n/2 and j < h */
+    u32 *iroot;  /* the same for the inverse roots w_2h^-j */
+    u32 scale;   /* multiplier applied after the inverse transform */
+} ntt_plan;
+
+static const ntt_plan *ntt_get_plan(const modulus *m, int n, int form);
 
 void ntt(int *a,int n,int invert){
-    int logn=0; int t=n; while(t>1){ logn=add(logn,1); t = t >> 1; }
-    build_rev(n,logn);
+    const ntt_plan *plan = ntt_get_plan(&moduli[0], n, FORM_NORMAL);
+    const u32 *roots = invert ? plan->iroot : plan->root;
     int i=0; nr_loop:
     if(!less_than(i,n)) goto nr_end;
-    if(less_than(i, rev_bits[i])){ int tmp=a[i]; a[i]=a[rev_bits[i]]; a[rev_bits[i]]=tmp; }
+    if(less_than(i, plan->rev[i])){ int tmp=a[i]; a[i]=a[plan->rev[i]]; a[plan->rev[i]]=tmp; }
     i=add(i,1); goto nr_loop; nr_end: ;
-    int root = G;
-    int root_inv = pow_mod(root, sub(MOD,2));
-    int len=2; int shift=1; len_loop:
+    int len=2; len_loop:
     if(!less_than(len, add(n,1))) goto len_end; /* while len <= n */
-    /* exponent = (MOD-1) / len since len is power of two -> right shift */
-    int exponent_shifted = (MOD-1) >> shift;
-    int wlen = pow_mod(invert ? root_inv : root, exponent_shifted);
+    int half = len >> 1;
     int i2=0; outer_loop:
     if(!less_than(i2,n)) goto outer_end;
-    int w=1; int j=0; inner_loop:
-    if(!less_than(j, (len>>1))) goto inner_end;
+    int j=0; inner_loop:
+    if(!less_than(j, half)) goto inner_end;
     int u=a[add(i2,j)];
-    int v=mul_mod(a[add(add(i2,j),(len>>1))], w);
+    int v=mul_mod(a[add(add(i2,j),half)], roots[add(half,j)]);
     a[add(i2,j)] = addmod(u,v);
-    a[add(add(i2,j),(len>>1))] = submod(u,v);
-    w = mul_mod(w, wlen);
+    a[add(add(i2,j),half)] = submod(u,v);
     j = add(j,1); goto inner_loop; inner_end: ;
     i2 = add(i2,len); goto outer_loop; outer_end: ;
-    len = len << 1; shift=add(shift,1); goto len_loop; len_end: ;
+    len = len << 1; goto len_loop; len_end: ;
     if(invert){
-        int n_inv = pow_mod(n, sub(MOD,2));
         int k=0; inv_loop:
         if(!less_than(k,n)) goto inv_end;
-        a[k]=mul_mod(a[k], n_inv);
+        a[k]=mul_mod(a[k], plan->scale);
         k=add(k,1); goto inv_loop; inv_end: ;
     }
 }
 
+/* ===== Fast modular arithmetic =====
+ * Plain 32/64-bit arithmetic instead of the bitwise helpers, for any NTT
+ * prime below 2^31 (see moduli[]). Coefficients stay in normal form;
+ * twiddles are kept in Montgomery form, so mont_mul(a, w*R) = a*w mod p with
+ * no conversion of the data itself. */
+enum { ARITH_BITWISE, ARITH_MONTGOMERY, ARITH_BARRETT };
+static const char *arith_names[] = { "bitwise", "montgomery", "barrett" };
+static int arith = ARITH_BITWISE;
+
+/* moduli[0] is MOD; the others are the three primes of the packed path */
+static modulus moduli[MODULI] = {
+    { .p = MOD, .g = G }, { .p = 469762049, .g = 3 }, { .p = 1811939329, .g = 13 }, { .p = 2013265921, .g = 31 }
+};
+
+static void moduli_init(void){
+    for(int k = 0; k < MODULI; k++){
+        modulus *m = &moduli[k];
+        /* Newton iteration doubles the correct low bits: 1 -> 2 -> ... -> 32 */
+        u32 inv = m->p;
+        for(int i = 0; i < 5; i++) inv *= 2 - m->p * inv;
+        m->ninv = (u32)0 - inv;
+        m->r1 = (u32)(((u64)1 << 32) % m->p);
+        m->r2 = (u32)((u64)m->r1 * m->r1 % m->p);
+        m->shift = 32 - __builtin_clz(m->p);
+        m->mu = (u64)(((unsigned __int128)1 << (2 * m->shift)) / m->p);
+        m->bound = m->p < (1u << 30) ? 2 * m->p : m->p;
+        m->max_logn = __builtin_ctz(m->p - 1);
+        m->index = k;
+    }
+}
+
+/* t < p * 2^32 -> t * R^-1 mod p */
+static inline u32 mont_reduce(const modulus *m, u64 t){
+    u32 q = (u32)t * m->ninv;
+    u32 r = (u32)((t + (u64)q * m->p) >> 32);
+    return r >= m->p ? r - m->p : r;
+}
+static inline u32 mont_mul(const modulus *m, u32 a, u32 b){ return mont_reduce(m, (u64)a * b); }
+static inline u32 to_mont(const modulus *m, u32 a){ return mont_mul(m, a, m->r2); }
+
+/* t < p^2: q underestimates t / p by at most 2 */
+static inline u32 barrett_reduce(const modulus *m, u64 t){
+    u64 q = ((t >> (m->shift - 1)) * m->mu) >> (m->shift + 1);
+    u32 r = (u32)(t - q * m->p);
+    if(r >= m->p) r -= m->p;
+    return r >= m->p ? r - m->p : r;
+}
+static inline u32 barrett_mul(const modulus *m, u32 a, u32 b){ return barrett_reduce(m, (u64)a * b); }
+
+static inline u32 add_fast(const modulus *m, u32 a, u32 b){ u32 s = a + b; return s >= m->p ? s - m->p : s; }
+static inline u32 sub_fast(const modulus *m, u32 a, u32 b){ return a >= b ? a - b : a + m->p - b; }
+
+static u32 pow_fast(const modulus *m, u32 a, u32 e){
+    u64 r = 1, x = a;
+    for(; e; e >>= 1, x = x * x % m->p) if(e & 1) r = r * x % m->p;
+    return (u32)r;
+}
+
+/* ===== NTT plans =====
+ * The bit reversal permutation depends only on the size, so every prime and
+ * form of one size shares a single table. */
+static ntt_plan *plan_cache[MODULI][FORMS][MAX_LOGN + 1];
+static u32 *rev_cache[MAX_LOGN + 1];
+
+static const u32 *ntt_get_rev(int logn){
+    if(rev_cache[logn]) return rev_cache[logn];
+    int n = 1 << logn;
+    u32 *rev = arena_alloc(&plan_arena, sizeof(u32) * (size_t)n);
+    rev[0] = 0;
+    for(int i = 1; i < n; i++) rev[i] = (rev[i >> 1] >> 1) | ((u32)(i & 1) << (logn - 1));
+    return rev_cache[logn] = rev;
+}
+
+static u32 ntt_scale(const modulus *m, int n, int form){
+    u32 n_inv = pow_fast(m, (u32)n, m->p - 2);
+    /* mont_mul() in the pointwise product leaves a factor R^-1; the
+     * scale n^-1 * R (in Montgomery form) cancels it */
+    return form == FORM_MONTGOMERY ? to_mont(m, (u32)((u64)n_inv * m->r1 % m->p)) : n_inv;
+}
+
+static const ntt_plan *ntt_get_plan(const modulus *m, int n, int form){
+    int logn = 0;
+    while((1 << logn) < n) logn++;
+    if(logn > m->max_logn){ fprintf(stderr, "no NTT of size 2^%d modulo %u\n", logn, m->p); exit(1); }
+    if(plan_cache[m->index][form][logn]) return plan_cache[m->index][form][logn];
+
+    ntt_plan *p = arena_alloc(&plan_arena, sizeof(ntt_plan));
+    u32 *mem = arena_alloc(&plan_arena, sizeof(u32) * 2 * (size_t)n);
+    p->n = n; p->logn = logn;
+    p->rev = (u32 *)ntt_get_rev(logn); p->root = mem; p->iroot = mem + n;
+
+    /* Top stage by successive powers, each lower stage is every other entry
+     * of the one above it: w_h^j = w_2h^2j */
+    if(n > 1){
+        int h = n >> 1;
+        u32 w = pow_fast(m, m->g, (m->p - 1) / n), iw = pow_fast(m, w, m->p - 2);
+        p->root[h] = 1; p->iroot[h] = 1;
+        for(int j = 1; j < h; j++){
+            p->root[h + j] = (u32)((u64)p->root[h + j - 1] * w % m->p);
+            p->iroot[h + j] = (u32)((u64)p->iroot[h + j - 1] * iw % m->p);
+        }
+        for(h >>= 1; h >= 1; h >>= 1)
+            for(int j = 0; j < h; j++){
+                p->root[h + j] = p->root[2 * h + 2 * j];
+                p->iroot[h + j] = p->iroot[2 * h + 2 * j];
+            }
+    }
+
+    if(form == FORM_MONTGOMERY)
+        for(int i = 1; i < n; i++){ p->root[i] = to_mont(m, p->root[i]); p->iroot[i] = to_mont(m, p->iroot[i]); }
+    p->scale = ntt_scale(m, n, form);
+    plan_cache[m->index][form][logn] = p;
+    return p;
+}
+
+static int fast_form(void){ return arith == ARITH_MONTGOMERY ? FORM_MONTGOMERY : FORM_NORMAL; }
+static const ntt_plan *fast_plan(const modulus *m, int n){ return ntt_get_plan(m, n, fast_form()); }
+
+/* Six-step plan: n = rows * cols (rows <= cols) seen as a rows x cols
+ * matrix, and the twiddles applied between its two phases of transforms:
+ * tw[c * rows + r] = w_n^(c r), itw[c * rows + r] = w_n^-(c rev(r)) for the
+ * inverse, whose rows are still in bit-reversed order when multiplied. It
+ * replaces the size-n plan, so the large transforms never build a size-n
+ * bit reversal. */
+typedef struct {
+    int rows, cols;
+    u32 *tw, *itw;
+} six_plan;
+static six_plan *six_cache[MODULI][FORMS][MAX_LOGN + 1];
+
+static const six_plan *six_get_plan(const modulus *m, int n, int form){
+    int logn = __builtin_ctz((u32)n);
+    if(logn > m->max_logn){ fprintf(stderr, "no NTT of size 2^%d modulo %u\n", logn, m->p); exit(1); }
+    if(six_cache[m->index][form][logn]) return six_cache[m->index][form][logn];
+
+    six_plan *sp = arena_alloc(&plan_arena, sizeof(six_plan));
+    sp->rows = 1 << logn / 2; sp->cols = n / sp->rows;
+    sp->tw = arena_alloc(&plan_arena, sizeof(u32) * 2 * (size_t)n); sp->itw = sp->tw + n;
+    /* powers in Montgomery form (r1 is 1): no division per entry */
+    u32 w = pow_fast(m, m->g, (m->p - 1) / n), iw = pow_fast(m, w, m->p - 2);
+    u32 wm = to_mont(m, w), iwm = to_mont(m, iw), wc = m->r1, iwc = m->r1;
+    const u32 *rev = ntt_get_rev(logn / 2);
+    for(int c = 0; c < sp->cols; c++){
+        u32 *t = sp->tw + (size_t)c * sp->rows, *it = sp->itw + (size_t)c * sp->rows;
+        u32 x = m->r1, ix = m->r1;
+        for(int r = 0; r < sp->rows; r++){
+            t[r] = form == FORM_MONTGOMERY ? x : mont_reduce(m, x);
+            it[rev[r]] = form == FORM_MONTGOMERY ? ix : mont_reduce(m, ix);
+            x = mont_mul(m, x, wc); ix = mont_mul(m, ix, iwc);
+        }
+        wc = mont_mul(m, wc, wm); iwc = mont_mul(m, iwc, iwm);
+    }
+    return six_cache[m->index][form][logn] = sp;
+}
+
+/* ===== SIMD Montgomery butterflies =====
+ * 8 (AVX2) or 16 (AVX-512) lanes per instruction, picked at runtime from what
+ * the CPU supports (--isa overrides). Reduction is lazy where the prime
+ * allows it: below 2^30, values stay in [0, 2p) between stages (sums stay
+ * under 2^32) and are only brought into [0, p) after the last stage; larger
+ * primes reduce the product once more and keep [0, p). Butterfly runs
+ * narrower than a vector use the same arithmetic in scalar code. */
+enum { ISA_SCALAR, ISA_AVX2, ISA_AVX512, ISAS };
+static const char *isa_names[] = { "scalar", "avx2", "avx512" };
+static int isa = ISA_SCALAR;
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HAVE_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+static int isa_supported(int level){
+    if(level == ISA_SCALAR) return 1;
+#ifdef HAVE_X86_SIMD
+    __builtin_cpu_init();
+    if(level == ISA_AVX2) return __builtin_cpu_supports("avx2");
+    if(level == ISA_AVX512) return __builtin_cpu_supports("avx512f");
+#endif
+    return 0;
+}
+
+/* a * b * R^-1 mod p in [0, 2p), for a < 2p and b < p */
+static inline u32 mont_mul_lazy(const modulus *m, u32 a, u32 b){
+    u64 t = (u64)a * b;
+    u32 q = (u32)t * m->ninv;
+    return (u32)((t + (u64)q * m->p) >> 32);
+}
+
+/* ===== Butterfly kernels =====
+ * A kernel runs butterflies k0..k1 of one stage (k = block * half + j), so a
+ * stage can be cut into contiguous pieces for several threads. Each bfly_*
+ * handles a run of j inside one block; STAGE_BLOCKS walks the blocks. */
+typedef void (*stage_fn)(const modulus *m, u32 *a, long half, const u32 *w, long k0, long k1);
+
+#define STAGE_BLOCKS(BFLY) \
+    while(k0 < k1){ \
+        long blk = k0 / half, j = k0 - blk * half; \
+        int cnt = (int)(k1 - k0 < half - j ? k1 - k0 : half - j); \
+        u32 *lo = a + blk * 2 * half + j; \
+        BFLY(m, lo, lo + half, w + j, cnt); \
+        k0 += cnt; \
+    }
+
+static inline void bfly_barrett(const modulus *m, u32 *lo, u32 *hi, const u32 *w, int cnt){
+    for(int j = 0; j < cnt; j++){
+        u32 u = lo[j], v = barrett_mul(m, hi[j], w[j]);
+        lo[j] = add_fast(m, u, v); hi[j] = sub_fast(m, u, v);
+    }
+}
+static inline void bfly_mont(const modulus *m, u32 *lo, u32 *hi, const u32 *w, int cnt){
+    for(int j = 0; j < cnt; j++){
+        u32 u = lo[j], v = mont_mul(m, hi[j], w[j]);
+        lo[j] = add_fast(m, u, v); hi[j] = sub_fast(m, u, v);
+    }
+}
+/* inputs and outputs in [0, m->bound) */
+static inline void bfly_lazy(const modulus *m, u32 *lo, u32 *hi, const u32 *w, int cnt){
+    const u32 b = m->bound;
+    for(int j = 0; j < cnt; j++){
+        u32 u = lo[j], v = mont_mul_lazy(m, hi[j], w[j]);
+        if(v >= b) v -= m->p;
+        u32 x = u + v, y = u - v + b;
+        lo[j] = x >= b ? x - b : x;
+        hi[j] = y >= b ? y - b : y;
+    }
+}
+static void stage_barrett(const modulus *m, u32 *a, long half, const u32 *w, long k0, long k1){ STAGE_BLOCKS(bfly_barrett) }
+static void stage_mont(const modulus *m, u32 *a, long half, const u32 *w, long k0, long k1){ STAGE_BLOCKS(bfly_mont) }
+
+/* Radix-4 (radix-2^2): the stages of half h and 2h in one pass, on quads
+ * (a[j], a[j+h], a[j+2h], a[j+3h]) of each block of 4h, k = block * h + j.
+ * w = root + h, so w[j], w[h + j] and w[2h + j] are the twiddles of the
+ * three pairs. Runs are cut to R4_TILE so the four rows of a run are still
+ * in L1 for the second stage: one sweep over the array per two stages. */
+#define R4_TILE 256
+#define STAGE4_BLOCKS(BFLY) \
+    while(k0 < k1){ \
+        long blk = k0 / half, j = k0 - blk * half; \
+        long run = k1 - k0 < half - j ? k1 - k0 : half - j; \
+        int cnt = (int)(run < R4_TILE ? run : R4_TILE); \
+        u32 *q = a + blk * 4 * half + j; \
+        BFLY(m, q, q + half, w + j, cnt); BFLY(m, q + 2 * half, q + 3 * half, w + j, cnt); \
+        BFLY(m, q, q + 2 * half, w + half + j, cnt); BFLY(m, q + half, q + 3 * half, w + 2 * half + j, cnt); \
+        k0 += cnt; \
+    }
+
+static void stage4_barrett(const modulus *m, u32 *a, long half, const u32 *w, long k0, long k1){ STAGE4_BLOCKS(bfly_barrett) }
+static void stage4_mont(const modulus *m, u32 *a, long half, const u32 *w, long k0, long k1){ STAGE4_BLOCKS(bfly_mont) }
+
+/* The first four stages (h = 1, 2, 4, 8) on each block of 16 in [i0, i1),
+ * in registers (SIMD kernels only): runs that short never fill a vector,
+ * and one at a time they cost more than all later stages together. A stage
+ * pairs lane i with lane i ^ h: both lanes of a pair see the hi value times
+ * the twiddle and keep the sum (lo) or the difference (hi). w_2^0 = 1 needs
+ * no multiplication. */
+#define SMALL_BLOCK 16
+typedef void (*small_fn)(const modulus *m, u32 *a, const u32 *roots, long i0, long i1);
+
+#ifdef HAVE_X86_SIMD
+__attribute__((target("avx2")))
+static inline __m256i mont_mul_avx2(__m256i a, __m256i b, __m256i p, __m256i ninv){
+    __m256i even = _mm256_mul_epu32(a, b);
+    __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+    __m256i m_even = _mm256_mul_epu32(even, ninv), m_odd = _mm256_mul_epu32(odd, ninv);
+    even = _mm256_srli_epi64(_mm256_add_epi64(even, _mm256_mul_epu32(m_even, p)), 32);
+    odd = _mm256_add_epi64(odd, _mm256_mul_epu32(m_odd, p));
+    return _mm256_blend_epi32(even, odd, 0xAA);
+}
+
+__attribute__((target("avx2")))
+static inline void bfly_avx2(const modulus *m, u32 *lo, u32 *hi, const u32 *w, int cnt){
+    const __m256i p = _mm256_set1_epi32((int)m->p), b = _mm256_set1_epi32((int)m->bound);
+    const __m256i ninv = _mm256_set1_epi32((int)m->ninv);
+    const int full = m->bound == m->p;
+    int j = 0;
+    for(; j + 8 <= cnt; j += 8){
+        __m256i u = _mm256_loadu_si256((const __m256i *)(lo + j));
+        __m256i x = _mm256_loadu_si256((const __m256i *)(hi + j));
+        __m256i v = mont_mul_avx2(x, _mm256_loadu_si256((const __m256i *)(w + j)), p, ninv);
+        /* min(x, x - b) as unsigned: subtracts b only when x >= b */
+        if(full) v = _mm256_min_epu32(v, _mm256_sub_epi32(v, p));
+        __m256i s = _mm256_add_epi32(u, v), d = _mm256_sub_epi32(_mm256_add_epi32(u, b), v);
+        s = _mm256_min_epu32(s, _mm256_sub_epi32(s, b));
+        d = _mm256_min_epu32(d, _mm256_sub_epi32(d, b));
+        _mm256_storeu_si256((__m256i *)(lo + j), s);
+        _mm256_storeu_si256((__m256i *)(hi + j), d);
+    }
+    if(j < cnt) bfly_lazy(m, lo + j, hi + j, w + j, cnt - j);
+}
+
+__attribute__((target("avx2")))
+static void stage_avx2(const modulus *m, u32 *a, long half, const u32 *w, long k0, long k1){ STAGE_BLOCKS(bfly_avx2) }
+__attribute__((target("avx2")))
+static void stage4_avx2(const modulus *m, u32 *a, long half, const u32 *w, long k0, long k1){ STAGE4_BLOCKS(bfly_avx2) }
+
+__attribute__((target("avx2")))
+static inline __m256i small_stage_avx2(__m256i x, __m256i perm, __m256i hi, __m256i w, int mul,
+                                       __m256i p, __m256i b, __m256i ninv, int full){
+    __m256i y = _mm256_permutevar8x32_epi32(x, perm);
+    __m256i u = _mm256_blendv_epi8(x, y, hi), v = _mm256_blendv_epi8(y, x, hi);
+    if(mul){
+        v = mont_mul_avx2(v, w, p, ninv);
+        if(full) v = _mm256_min_epu32(v, _mm256_sub_epi32(v, p));
+    }
+    __m256i s = _mm256_add_epi32(u, v), d = _mm256_sub_epi32(_mm256_add_epi32(u, b), v);
+    s = _mm256_min_epu32(s, _mm256_sub_epi32(s, b));
+    d = _mm256_min_epu32(d, _mm256_sub_epi32(d, b));
+    return _mm256_blendv_epi8(s, d, hi);
+}
+
+/* h = 1, 2, 4 inside each half of the block, h = 8 between the halves */
+__attribute__((target("avx2")))
+static void small_avx2(const modulus *m, u32 *a, const u32 *roots, long i0, long i1){
+    const __m256i p = _mm256_set1_epi32((int)m->p), b = _mm256_set1_epi32((int)m->bound);
+    const __m256i ninv = _mm256_set1_epi32((int)m->ninv);
+    const int full = m->bound == m->p;
+    __m256i perm[3], hi[3], w[3];
+    for(int st = 0; st < 3; st++){
+        int h = 1 << st;
+        u32 idx[8], msk[8], tw[8];
+        for(int i = 0; i < 8; i++){ idx[i] = (u32)(i ^ h); msk[i] = i & h ? ~0u : 0; tw[i] = roots[h + (i & (h - 1))]; }
+        perm[st] = _mm256_loadu_si256((const __m256i *)idx);
+        hi[st] = _mm256_loadu_si256((const __m256i *)msk);
+        w[st] = _mm256_loadu_si256((const __m256i *)tw);
+    }
+    for(long i = i0; i < i1; i += SMALL_BLOCK){
+        __m256i x0 = _mm256_loadu_si256((const __m256i *)(a + i));
+        __m256i x1 = _mm256_loadu_si256((const __m256i *)(a + i + 8));
+        for(int st = 0; st < 3; st++){
+            x0 = small_stage_avx2(x0, perm[st], hi[st], w[st], st, p, b, ninv, full);
+            x1 = small_stage_avx2(x1, perm[st], hi[st], w[st], st, p, b, ninv, full);
+        }
+        _mm256_storeu_si256((__m256i *)(a + i), x0);
+        _mm256_storeu_si256((__m256i *)(a + i + 8), x1);
+        bfly_avx2(m, a + i, a + i + 8, roots + 8, 8);
+    }
+}
+
+/* a[i] = a[i] * (b ? b[i] : s) * R^-1, fully reduced */
+__attribute__((target("avx2")))
+static void mul_vec_avx2(const modulus *m, u32 *a, const u32 *b, u32 s, long n){
+    const __m256i p = _mm256_set1_epi32((int)m->p), ninv = _mm256_set1_epi32((int)m->ninv);
+    __m256i sv = _mm256_set1_epi32((int)s);
+    long i = 0;
+    for(; i + 8 <= n; i += 8){
+        __m256i x = _mm256_loadu_si256((const __m256i *)(a + i));
+        __m256i y = b ? _mm256_loadu_si256((const __m256i *)(b + i)) : sv;
+        x = mont_mul_avx2(x, y, p, ninv);
+        _mm256_storeu_si256((__m256i *)(a + i), _mm256_min_epu32(x, _mm256_sub_epi32(x, p)));
+    }
+    for(; i < n; i++) a[i] = mont_mul(m, a[i], b ? b[i] : s);
+}
+
+__attribute__((target("avx512f")))
+static inline __m512i mont_mul_avx512(__m512i a, __m512i b, __m512i p, __m512i ninv){
+    __m512i even = _mm512_mul_epu32(a, b);
+    __m512i odd = _mm512_mul_epu32(_mm512_srli_epi64(a, 32), _mm512_srli_epi64(b, 32));
+    __m512i m_even = _mm512_mul_epu32(even, ninv), m_odd = _mm512_mul_epu32(odd, ninv);
+    even = _mm512_srli_epi64(_mm512_add_epi64(even, _mm512_mul_epu32(m_even, p)), 32);
+    odd = _mm512_add_epi64(odd, _mm512_mul_epu32(m_odd, p));
+    return _mm512_mask_blend_epi32(0xAAAA, even, odd);
+}
+
+__attribute__((target("avx512f")))
+static inline void bfly_avx512(const modulus *m, u32 *lo, u32 *hi, const u32 *w, int cnt){
+    const __m512i p = _mm512_set1_epi32((int)m->p), b = _mm512_set1_epi32((int)m->bound);
+    const __m512i ninv = _mm512_set1_epi32((int)m->ninv);
+    const int full = m->bound == m->p;
+    int j = 0;
+    for(; j + 16 <= cnt; j += 16){
+        __m512i u = _mm512_loadu_si512(lo + j);
+        __m512i v = mont_mul_avx512(_mm512_loadu_si512(hi + j), _mm512_loadu_si512(w + j), p, ninv);
+        if(full) v = _mm512_min_epu32(v, _mm512_sub_epi32(v, p));
+        __m512i s = _mm512_add_epi32(u, v), d = _mm512_sub_epi32(_mm512_add_epi32(u, b), v);
+        s = _mm512_min_epu32(s, _mm512_sub_epi32(s, b));
+        d = _mm512_min_epu32(d, _mm512_sub_epi32(d, b));
+        _mm512_storeu_si512(lo + j, s);
+        _mm512_storeu_si512(hi + j, d);
+    }
+    if(j < cnt) bfly_lazy(m, lo + j, hi + j, w + j, cnt - j);
+}
+
+__attribute__((target("avx512f")))
+static void stage_avx512(const modulus *m, u32 *a, long half, const u32 *w, long k0, long k1){ STAGE_BLOCKS(bfly_avx512) }
+__attribute__((target("avx512f")))
+static void stage4_avx512(const modulus *m, u32 *a, long half, const u32 *w, long k0, long k1){ STAGE4_BLOCKS(bfly_avx512) }
+
+__attribute__((target("avx512f")))
+static void small_avx512(const modulus *m, u32 *a, const u32 *roots, long i0, long i1){
+    const __m512i p = _mm512_set1_epi32((int)m->p), b = _mm512_set1_epi32((int)m->bound);
+    const __m512i ninv = _mm512_set1_epi32((int)m->ninv);
+    const int full = m->bound == m->p;
+    __m512i perm[4], w[4];
+    __mmask16 hi[4];
+    for(int st = 0; st < 4; st++){
+        int h = 1 << st;
+        u32 idx[16], tw[16];
+        hi[st] = 0;
+        for(int i = 0; i < 16; i++){
+            idx[i] = (u32)(i ^ h); tw[i] = roots[h + (i & (h - 1))];
+            if(i & h) hi[st] |= (__mmask16)(1u << i);
+        }
+        perm[st] = _mm512_loadu_si512(idx); w[st] = _mm512_loadu_si512(tw);
+    }
+    for(long i = i0; i < i1; i += SMALL_BLOCK){
+        __m512i x = _mm512_loadu_si512(a + i);
+        for(int st = 0; st < 4; st++){
+            __m512i y = _mm512_permutexvar_epi32(perm[st], x);
+            __m512i u = _mm512_mask_blend_epi32(hi[st], x, y), v = _mm512_mask_blend_epi32(hi[st], y, x);
+            if(st){
+                v = mont_mul_avx512(v, w[st], p, ninv);
+                if(full) v = _mm512_min_epu32(v, _mm512_sub_epi32(v, p));
+            }
+            __m512i s = _mm512_add_epi32(u, v), d = _mm512_sub_epi32(_mm512_add_epi32(u, b), v);
+            s = _mm512_min_epu32(s, _mm512_sub_epi32(s, b));
+            d = _mm512_min_epu32(d, _mm512_sub_epi32(d, b));
+            x = _mm512_mask_blend_epi32(hi[st], s, d);
+        }
+        _mm512_storeu_si512(a + i, x);
+    }
+}
+
+__attribute__((target("avx512f")))
+static void mul_vec_avx512(const modulus *m, u32 *a, const u32 *b, u32 s, long n){
+    const __m512i p = _mm512_set1_epi32((int)m->p), ninv = _mm512_set1_epi32((int)m->ninv);
+    __m512i sv = _mm512_set1_epi32((int)s);
+    long i = 0;
+    for(; i + 16 <= n; i += 16){
+        __m512i x = _mm512_loadu_si512(a + i);
+        __m512i y = b ? _mm512_loadu_si512(b + i) : sv;
+        x = mont_mul_avx512(x, y, p, ninv);
+        _mm512_storeu_si512(a + i, _mm512_min_epu32(x, _mm512_sub_epi32(x, p)));
+    }
+    for(; i < n; i++) a[i] = mont_mul(m, a[i], b ? b[i] : s);
+}
+#endif
+
+/* ===== Threads =====
+ * --threads splits each stage, the bit reversal and the pointwise passes into
+ * one contiguous piece per thread (OpenMP), and transforms the two operands
+ * concurrently with half of the threads each. Transforms below PAR_MIN points
+ * stay on one thread. */
+#define PAR_MIN (1 << 14)
+static int threads = 1;
+
+/* boundary c of t pieces of [0, total), multiples of 16 so vectors stay whole */
+static inline long piece(long total, int c, int t){
+    return c == t ? total : (total * c / t) & ~15L;
+}
+
+/* a[i] = a[i] * (b ? b[i] : s) in the engine's form, fully reduced */
+static void mul_range(const modulus *m, u32 *a, const u32 *b, u32 s, long n){
+    if(arith == ARITH_BARRETT){
+        for(long i = 0; i < n; i++) a[i] = barrett_mul(m, a[i], b ? b[i] : s);
+        return;
+    }
+#ifdef HAVE_X86_SIMD
+    if(isa == ISA_AVX512){ mul_vec_avx512(m, a, b, s, n); return; }
+    if(isa == ISA_AVX2){ mul_vec_avx2(m, a, b, s, n); return; }
+#endif
+    for(long i = 0; i < n; i++) a[i] = mont_mul(m, a[i], b ? b[i] : s);
+}
+
+static void pointwise(const modulus *m, u32 *a, const u32 *b, u32 s, int n, int nthreads){
+    int t = n >= PAR_MIN ? nthreads : 1;
+    #pragma omp parallel for num_threads(t) schedule(static)
+    for(int c = 0; c < t; c++){
+        long i0 = piece(n, c, t), i1 = piece(n, c + 1, t);
+        mul_range(m, a + i0, b ? b + i0 : NULL, s, i1 - i0);
+    }
+}
+
+/* ===== Cache-aware transforms =====
+ * The radix-2 loop makes one sweep over the array per stage (plus the bit
+ * reversal), which goes to memory once the array outgrows the caches.
+ * Radix-4 passes halve the sweeps. Transforms of SIX_STEP_MIN points and up
+ * use the six-step layout: n = rows * cols, rows-point transforms of the
+ * columns, twiddles, cols-point transforms of the rows. Each sub-transform
+ * fits in L1/L2 and runs whole on one thread; blocked transposes turn the
+ * columns into rows and back. That is four sweeps in total. Its forward
+ * output is in transposed order (X[r + rows * c] at r * cols + c), which is
+ * what its inverse takes, so convolutions never undo it. --ntt picks a
+ * layout; auto is radix-4 below SIX_STEP_MIN and six-step from it. */
+enum { NTT_RADIX2, NTT_RADIX4, NTT_SIXSTEP, NTT_AUTO, NTT_LAYOUTS };
+static const char *layout_names[] = { "radix2", "radix4", "sixstep", "auto" };
+static int ntt_layout = NTT_AUTO;
+#define SIX_STEP_MIN (1 << 22) /* crossover measured with --bandwidth */
+#define TILE 64
+
+static int six_step(int n){
+    return ntt_layout == NTT_SIXSTEP ? n >= 4 : ntt_layout == NTT_AUTO && n >= SIX_STEP_MIN;
+}
+
+typedef struct {
+    stage_fn stage, stage4;
+    small_fn small; /* the first four stages, or NULL */
+    int lazy; /* values end in [0, 2p): one more reduction after the last stage */
+} ntt_kernels;
+
+static ntt_kernels ntt_pick(const modulus *m){
+    ntt_kernels k = { .stage = stage_mont, .stage4 = stage4_mont };
+    if(arith == ARITH_BARRETT){ k.stage = stage_barrett; k.stage4 = stage4_barrett; return k; }
+#ifdef HAVE_X86_SIMD
+    if(isa == ISA_AVX512){ k.stage = stage_avx512; k.stage4 = stage4_avx512; k.small = small_avx512; k.lazy = m->bound != m->p; }
+    if(isa == ISA_AVX2){ k.stage = stage_avx2; k.stage4 = stage4_avx2; k.small = small_avx2; k.lazy = m->bound != m->p; }
+#else
+    (void)m;
+#endif
+    return k;
+}
+
+/* swaps pair i with rev[i] for i in [i0, i1); each pair is owned by its smaller index */
+static void bitrev_range(u32 *a, const u32 *rev, long i0, long i1){
+    for(long i = i0; i < i1; i++){
+        u32 r = rev[i];
+        if((u32)i < r){ u32 tmp = a[i]; a[i] = a[r]; a[r] = tmp; }
+    }
+}
+
+/* [0, 2p) -> [0, p); min(x, x - p) as unsigned has no branch to mispredict
+ * and vectorizes */
+static void reduce_range(const modulus *m, u32 *a, long i0, long i1){
+    const u32 p = m->p;
+    for(long i = i0; i < i1; i++){ u32 x = a[i], y = x - p; a[i] = y < x ? y : x; }
+}
+
+/* in-place transform with radix-2 or radix-4 passes, each pass cut into t
+ * pieces; t = 1 opens no parallel region (the six-step rows). reversed: a
+ * is already in bit-reversed order. */
+static void ntt_radix(const modulus *m, u32 *a, const ntt_plan *plan, int invert, int reversed, int t){
+    const u32 *roots = invert ? plan->iroot : plan->root;
+    const ntt_kernels k = ntt_pick(m);
+    const int n = plan->n, radix4 = ntt_layout != NTT_RADIX2;
+    const int small = k.small && n >= SMALL_BLOCK;
+    long half = small ? SMALL_BLOCK : 1;
+    if(t == 1){
+        if(!reversed) bitrev_range(a, plan->rev, 0, n);
+        if(small) k.small(m, a, roots, 0, n);
+        if(radix4) for(; half * 4 <= n; half <<= 2) k.stage4(m, a, half, roots + half, 0, n / 4);
+        for(; half < n; half <<= 1) k.stage(m, a, half, roots + half, 0, n / 2);
+        if(k.lazy) reduce_range(m, a, 0, n);
+        return;
+    }
+    if(!reversed){
+        #pragma omp parallel for num_threads(t) schedule(static)
+        for(int c = 0; c < t; c++) bitrev_range(a, plan->rev, piece(n, c, t), piece(n, c + 1, t));
+    }
+    if(small){
+        #pragma omp parallel for num_threads(t) schedule(static)
+        for(int c = 0; c < t; c++) k.small(m, a, roots, piece(n, c, t), piece(n, c + 1, t));
+    }
+    if(radix4)
+        for(; half * 4 <= n; half <<= 2){
+            #pragma omp parallel for num_threads(t) schedule(static)
+            for(int c = 0; c < t; c++) k.stage4(m, a, half, roots + half, piece(n / 4, c, t), piece(n / 4, c + 1, t));
+        }
+    for(; half < n; half <<= 1){
+        #pragma omp parallel for num_threads(t) schedule(static)
+        for(int c = 0; c < t; c++) k.stage(m, a, half, roots + half, piece(n / 2, c, t), piece(n / 2, c + 1, t));
+    }
+    if(k.lazy){
+        #pragma omp parallel for num_threads(t) schedule(static)
+        for(int c = 0; c < t; c++) reduce_range(m, a, piece(n, c, t), piece(n, c + 1, t));
+    }
+}
+
+/* dst (cols x rows) = src (rows x cols) transposed, TILE x TILE at a time;
+ * with rev, source row rev[r] goes to column r, so the rows of dst come out
+ * in the bit-reversed order their transforms start from. The inner loop
+ * writes contiguously: strided writes to 2^k apart lines evict each other
+ * in L1 and cost about three times as much. */
+static void transpose(u32 *dst, const u32 *src, int rows, int cols, const u32 *rev, int t){
+    #pragma omp parallel for num_threads(t) schedule(static)
+    for(int r0 = 0; r0 < rows; r0 += TILE)
+        for(int c0 = 0; c0 < cols; c0 += TILE){
+            int r1 = r0 + TILE < rows ? r0 + TILE : rows, c1 = c0 + TILE < cols ? c0 + TILE : cols;
+            for(int c = c0; c < c1; c++){
+                u32 *d = dst + (size_t)c * rows;
+                if(rev) for(int r = r0; r < r1; r++) d[r] = src[(size_t)rev[r] * cols + c];
+                else for(int r = r0; r < r1; r++) d[r] = src[(size_t)r * cols + c];
+            }
+        }
+}
+
+/* len-point transforms of the rows of a (rows x len), one row per thread at
+ * a time; row r is multiplied by tw[r * len ..] after the forward or before
+ * the inverse transform, while it is still in cache. reversed as in
+ * ntt_radix(); the twiddles are in the order of the row as stored. */
+static void ntt_rows(const modulus *m, u32 *a, int rows, int len, const u32 *tw, int invert, int reversed, int t){
+    const ntt_plan *plan = fast_plan(m, len);
+    #pragma omp parallel for num_threads(t) schedule(static)
+    for(int r = 0; r < rows; r++){
+        u32 *row = a + (size_t)r * len;
+        if(tw && invert) mul_range(m, row, tw + (size_t)r * len, 0, len);
+        ntt_radix(m, row, plan, invert, reversed, 1);
+        if(tw && !invert) mul_range(m, row, tw + (size_t)r * len, 0, len);
+    }
+}
+
+/* x[j1 * cols + j2] -> X[k1 + rows * k2] at k1 * cols + k2, and back;
+ * tmp holds n entries. The transposes in front of a phase of rows also do
+ * the rows' bit reversal, except for the first inverse phase, which has
+ * none in front of it. */
+static void ntt_six(const modulus *m, u32 *a, u32 *tmp, int n, int invert, int t){
+    const six_plan *sp = six_get_plan(m, n, fast_form());
+    const int rows = sp->rows, cols = sp->cols;
+    const u32 *rev_rows = fast_plan(m, rows)->rev, *rev_cols = fast_plan(m, cols)->rev;
+    if(!invert){
+        transpose(tmp, a, rows, cols, rev_rows, t);
+        ntt_rows(m, tmp, cols, rows, sp->tw, 0, 1, t);
+        transpose(a, tmp, cols, rows, rev_cols, t);
+        ntt_rows(m, a, rows, cols, NULL, 0, 1, t);
+    } else {
+        ntt_rows(m, a, rows, cols, NULL, 1, 0, t);
+        transpose(tmp, a, rows, cols, rev_rows, t);
+        ntt_rows(m, tmp, cols, rows, sp->itw, 1, 1, t);
+        transpose(a, tmp, cols, rows, NULL, t);
+    }
+}
+
+/* builds the plans ntt_fast() will use for size n (plans are not built
+ * concurrently) and returns the scale for after the inverse */
+static u32 ntt_prepare(const modulus *m, int n){
+    if(six_step(n)){
+        const six_plan *sp = six_get_plan(m, n, fast_form());
+        fast_plan(m, sp->rows); fast_plan(m, sp->cols);
+    } else fast_plan(m, n);
+    return ntt_scale(m, n, fast_form());
+}
+
+/* tmp: n entries of scratch when six_step(n), else unused */
+static void ntt_fast(const modulus *m, u32 *a, u32 *tmp, int n, int invert, int nthreads){
+    int t = n >= PAR_MIN ? nthreads : 1;
+    if(six_step(n)) ntt_six(m, a, tmp, n, invert, t);
+    else ntt_radix(m, a, fast_plan(m, n), invert, 0, t);
+}
+
+/* a <- a * b mod m->p (cyclic convolution of length n) with the fast engines */
+static void convolve_fast(const modulus *m, u32 *a, u32 *b, int n){
+    u32 scale = ntt_prepare(m, n);
+    int split = threads > 1 && n >= PAR_MIN;
+    arena_pos mark = arena_mark(&work_arena);
+    u32 *ta = NULL, *tb = NULL;
+    if(six_step(n)){
+        ta = arena_alloc(&work_arena, sizeof(u32) * (size_t)n);
+        tb = split ? arena_alloc(&work_arena, sizeof(u32) * (size_t)n) : ta;
+    }
+    if(split){
+        /* the two forward transforms are independent */
+        #pragma omp parallel sections num_threads(2)
+        {
+            #pragma omp section
+            ntt_fast(m, a, ta, n, 0, (threads + 1) / 2);
+            #pragma omp section
+            ntt_fast(m, b, tb, n, 0, threads / 2);
+        }
+    } else {
+        ntt_fast(m, a, ta, n, 0, 1); ntt_fast(m, b, tb, n, 0, 1);
+    }
+    /* Montgomery: mont_mul() leaves a*b*R^-1, which the plan's scale cancels */
+    pointwise(m, a, b, 0, n, threads);
+    ntt_fast(m, a, ta, n, 1, threads);
+    pointwise(m, a, NULL, scale, n, threads);
+    arena_release(&work_arena, mark);
+}
+
+/* ===== Digit I/O =====
+ * Input is mapped (a regular file on stdin) or read in bulk, and scanned for
+ * digits 32 (AVX2) or 8 (SWAR: eight bytes in one 64-bit word) characters at
+ * a time. ASCII is turned into digit values the same way when operands are
+ * loaded. The result is converted to ASCII in chunks, one contiguous run
+ * per thread, into one buffer that goes out in a few large writes. */
+#define IO_CHUNK (1L << 20)
+#define IO_WRITE ((size_t)1 << 26)
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define SWAR_LE 1
+#endif
+
+static inline int is_space(char c){ return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f'; }
+
+/* 1 if the eight bytes of x are all '0'..'9': the high nibble is 3 both
+ * before and after adding 6 to every byte */
+static inline int all_digits8(u64 x){
+    const u64 hi = 0xF0F0F0F0F0F0F0F0ULL, three = 0x3030303030303030ULL;
+    return (x & hi) == three && ((x + 0x0606060606060606ULL) & hi) == three;
+}
+
+/* length of the run of digits at the start of s[0..len) */
+static size_t digit_run_swar(const char *s, size_t len){
+    size_t i = 0;
+    for(; i + 8 <= len; i += 8){ u64 x; memcpy(&x, s + i, 8); if(!all_digits8(x)) break; }
+    while(i < len && s[i] >= '0' && s[i] <= '9') i++;
+    return i;
+}
+
+/* value of cnt <= 9 digits, s[0] most significant */
+static inline u32 parse_digits(const char *s, int cnt){
+    u32 v = 0;
+#ifdef SWAR_LE
+    for(; cnt > 8; cnt--) v = v * 10 + (u32)(*s++ - '0');
+    if(cnt == 8){
+        /* pairs, then quads, then all eight: each step multiplies the more
+         * significant half (the lower bytes) up and adds the other */
+        u64 x; memcpy(&x, s, 8);
+        x -= 0x3030303030303030ULL;
+        x = x * 10 + (x >> 8);
+        x = ((x & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32)) +
+             ((x >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32))) >> 32;
+        return v * 100000000u + (u32)x;
+    }
+#endif
+    for(; cnt > 0; cnt--) v = v * 10 + (u32)(*s++ - '0');
+    return v;
+}
+
+/* a[0..n) = digits of s[0..len) least significant first, zero padded */
+static void load_digits_scalar(u32 *a, const char *s, int len){
+    for(int i = 0; i < len; i++) a[i] = (u32)(s[len - 1 - i] - '0');
+}
+
+/* out[0..len) = ASCII of d[len - 1], ..., d[0] */
+static void format_scalar(char *out, const unsigned char *d, long len){
+    for(long i = 0; i < len; i++) out[i] = (char)('0' + d[len - 1 - i]);
+}
+
+#ifdef HAVE_X86_SIMD
+__attribute__((target("avx2")))
+static size_t digit_run_avx2(const char *s, size_t len){
+    const __m256i lo = _mm256_set1_epi8('0' - 1), hi = _mm256_set1_epi8('9' + 1);
+    size_t i = 0;
+    for(; i + 32 <= len; i += 32){
+        __m256i x = _mm256_loadu_si256((const __m256i *)(s + i));
+        /* signed compares: bytes >= 0x80 fail the first one */
+        __m256i ok = _mm256_and_si256(_mm256_cmpgt_epi8(x, lo), _mm256_cmpgt_epi8(hi, x));
+        unsigned bad = ~(unsigned)_mm256_movemask_epi8(ok);
+        if(bad) return i + (size_t)__builtin_ctz(bad);
+    }
+    return i + digit_run_swar(s + i, len - i);
+}
+
+__attribute__((target("avx2")))
+static void load_digits_avx2(u32 *a, const char *s, int len){
+    const __m128i rev = _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    const __m128i zero = _mm_set1_epi8('0');
+    int i = 0;
+    for(; i + 16 <= len; i += 16){
+        __m128i x = _mm_loadu_si128((const __m128i *)(s + len - i - 16));
+        x = _mm_shuffle_epi8(_mm_sub_epi8(x, zero), rev);
+        _mm256_storeu_si256((__m256i *)(a + i), _mm256_cvtepu8_epi32(x));
+        _mm256_storeu_si256((__m256i *)(a + i + 8), _mm256_cvtepu8_epi32(_mm_srli_si128(x, 8)));
+    }
+    load_digits_scalar(a + i, s, len - i);
+}
+
+__attribute__((target("avx2")))
+static void format_avx2(char *out, const unsigned char *d, long len){
+    const __m256i rev = _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+                                         15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    const __m256i zero = _mm256_set1_epi8('0');
+    long i = 0;
+    for(; i + 32 <= len; i += 32){
+        __m256i x = _mm256_loadu_si256((const __m256i *)(d + len - i - 32));
+        /* reverse within each 128-bit lane, then swap the lanes */
+        x = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(x, rev), 0x4E);
+        _mm256_storeu_si256((__m256i *)(out + i), _mm256_add_epi8(x, zero));
+    }
+    format_scalar(out + i, d, len - i);
+}
+#endif
+
+static size_t digit_run(const char *s, size_t len){
+#ifdef HAVE_X86_SIMD
+    if(isa >= ISA_AVX2) return digit_run_avx2(s, len);
+#endif
+    return digit_run_swar(s, len);
+}
+
+static void load_digits(u32 *a, const char *s, int len, int n){
+#ifdef HAVE_X86_SIMD
+    if(isa >= ISA_AVX2) load_digits_avx2(a, s, len);
+    else
+#endif
+    load_digits_scalar(a, s, len);
+    memset(a + len, 0, sizeof(u32) * (size_t)(n - len));
+}
+
+/* out[0..res_len) = digits[] most significant first */
+static void format_digits(char *out, int res_len){
+    long chunks = (res_len + IO_CHUNK - 1) / IO_CHUNK;
+    int t = res_len >= PAR_MIN ? threads : 1;
+    #pragma omp parallel for num_threads(t) schedule(static)
+    for(long c = 0; c < chunks; c++){
+        long i0 = c * IO_CHUNK, i1 = i0 + IO_CHUNK < res_len ? i0 + IO_CHUNK : res_len;
+        const unsigned char *d = digits + res_len - i1;
+#ifdef HAVE_X86_SIMD
+        if(isa >= ISA_AVX2){ format_avx2(out + i0, d, i1 - i0); continue; }
+#endif
+        format_scalar(out + i0, d, i1 - i0);
+    }
+}
+
+/* the product and a newline on stdout */
+void print_digits(int res_len){
+    char *out = arena_alloc(&work_arena, (size_t)res_len + 1);
+    format_digits(out, res_len);
+    out[res_len] = '\n';
+    for(size_t done = 0, total = (size_t)res_len + 1; done < total; ){
+        size_t part = total - done < IO_WRITE ? total - done : IO_WRITE;
+        if(fwrite(out + done, 1, part, stdout) != part){ fprintf(stderr, "write error\n"); exit(1); }
+        done += part;
+    }
+    fflush(stdout);
+}
+
+/* All of stdin: mapped when it is a regular file, else read in bulk.
+ * *s1, *s2 point at its two operands (not NUL-terminated). Returns 0 when
+ * there are fewer than two. */
+static size_t input_bytes;
+static int read_operands(char **s1, int *len1, char **s2, int *len2){
+    char *buf = NULL;
+    size_t len = 0;
+#ifndef _WIN32
+    struct stat st;
+    if(!fstat(0, &st) && S_ISREG(st.st_mode) && st.st_size > 0){
+        void *map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, 0, 0);
+        if(map != MAP_FAILED){
+            posix_madvise(map, (size_t)st.st_size, POSIX_MADV_SEQUENTIAL);
+            buf = map; len = input_bytes = (size_t)st.st_size;
+        }
+    }
+#endif
+    if(!buf){
+        size_t cap = (size_t)1 << 16, got;
+        buf = malloc(cap);
+        while(buf && (got = fread(buf + len, 1, cap - len, stdin)) > 0){
+            len += got;
+            if(len == cap){ cap *= 2; char *grown = realloc(buf, cap); if(!grown) free(buf); buf = grown; }
+        }
+        if(!buf){ fprintf(stderr, "out of memory reading the input\n"); exit(1); }
+        input_bytes = cap;
+    }
+    char *tok[2];
+    int tlen[2];
+    size_t pos = 0;
+    for(int t = 0; t < 2; t++){
+        while(pos < len && is_space(buf[pos])) pos++;
+        if(pos == len) return 0;
+        size_t run = digit_run(buf + pos, len - pos);
+        if(!run || (pos + run < len && !is_space(buf[pos + run]))){
+            fprintf(stderr, "operands must be non-negative decimal integers\n"); exit(1);
+        }
+        if(run > (size_t)1 << 30){ fprintf(stderr, "operand too long: %zu digits\n", run); exit(1); }
+        tok[t] = buf + pos; tlen[t] = (int)run;
+        pos += run;
+    }
+    *s1 = tok[0]; *len1 = tlen[0]; *s2 = tok[1]; *len2 = tlen[1];
+    return 1;
+}
+
+/* ===== Normalization =====
+ * Product coefficients become base-10 digits in two passes. Blocks of
+ * NORM_BLOCK coefficients are normalized independently (one contiguous run
+ * of blocks per thread), each from a zero carry, leaving the carry out of
+ * its top. A short sequential pass then adds each block's incoming carry at
+ * its bottom, where it dies out within a few digits unless it meets a run
+ * of nines. Division by 10 and by 10^k is a multiply by a precomputed
+ * reciprocal. */
+#define NORM_BLOCK (1 << 14)
+
+/* n / d for n < 2^62 and 1 < d < 2^30: m = ceil(2^(62 + l) / d), where
+ * 2^(l-1) < d <= 2^l, is exact over that range (Granlund and Montgomery)
+ * and fits in 64 bits */
+typedef struct { u64 m; int s; u32 d; } divisor;
+static divisor div_init(u32 d){
+    int l = 32 - __builtin_clz(d - 1);
+    divisor v = { (u64)((((u128)1 << (62 + l)) + d - 1) / d), 62 + l, d };
+    return v;
+}
+static inline u64 div_q(const divisor *v, u64 n){ return (u64)(((u128)n * v->m) >> v->s); }
+
+/* digits[0..len) hold the blocks normalized on their own, blocks of width
+ * digits; out[b] is the carry out of block b. Adds every carry into the
+ * block above, appends the last one and trims; returns the digit count. */
+static int carry_fixup(const u64 *out, int blocks, long width, long len){
+    u64 c = 0;
+    for(int b = 0; b < blocks; b++){
+        long j = b * width, end = j + width < len ? j + width : len;
+        for(; c && j < end; j++){ c += digits[j]; digits[j] = (unsigned char)(c % 10); c /= 10; }
+        c += out[b];
+    }
+    for(; c; c /= 10) digits[len++] = (unsigned char)(c % 10);
+    while(len > 1 && !digits[len - 1]) len--;
+    return (int)len;
+}
+
+/* coefficients a[0..cn), each below 2^31, into digits[]; returns the digit count */
+static int normalize_digits(const u32 *a, int cn){
+    const divisor ten = div_init(10);
+    unsigned char *dig = digits;
+    int blocks = (cn + NORM_BLOCK - 1) / NORM_BLOCK;
+    u64 *out = arena_alloc(&work_arena, sizeof(u64) * blocks);
+    int t = cn >= PAR_MIN ? threads : 1;
+    #pragma omp parallel for num_threads(t) schedule(static)
+    for(int b = 0; b < blocks; b++){
+        int i1 = (b + 1) * NORM_BLOCK < cn ? (b + 1) * NORM_BLOCK : cn;
+        u64 carry = 0;
+        for(int i = b * NORM_BLOCK; i < i1; i++){
+            u64 v = a[i] + carry, q = div_q(&ten, v);
+            dig[i] = (unsigned char)(v - q * 10);
+            carry = q;
+        }
+        out[b] = carry;
+    }
+    return carry_fixup(out, blocks, NORM_BLOCK, cn);
+}
+
+/* ===== Packed coefficients, three primes, CRT =====
+ * --pack k (4..9) puts k decimal digits in each coefficient, so the
+ * transform is k times shorter. A product coefficient can then reach
+ * (10^k - 1)^2 * min(len) / k, far beyond one 31-bit prime: the convolution
+ * runs modulo two or three primes (as many as the bound needs, product up
+ * to 1.7e27) and Garner's CRT rebuilds each exact coefficient in 128 bits
+ * inside the normalization pass, which works in base 10^k. */
+#define PACK_PRIMES 3
+static int pack = 1;
+static const u32 pow10_u32[10] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000 };
+
+/* s[0..len) most significant first -> c[0..) base 10^k, least significant first */
+static int load_packed(u32 *c, const char *s, int len, int k){
+    int count = 0;
+    for(int end = len; end > 0; end -= k){
+        int begin = end > k ? end - k : 0;
+        c[count++] = parse_digits(s + begin, end - begin);
+    }
+    return count;
+}
+
+/* Garner: x = r0 + p0 * (t1 + p1 * t2), each t_j reduced mod p_j. The
+ * primes ascend, so a residue of a smaller prime is already reduced modulo
+ * a larger one. x never needs 128 bits: with p0 * p1 = q01 * 10^k + r01,
+ * x = f + q01 * t2 * 10^k where f = r0 + p0 * t1 + r01 * t2 < 2^62, so one
+ * reciprocal multiply splits x into x / 10^k and x % 10^k. */
+typedef struct {
+    const u32 *res; long stride; int primes;
+    modulus m1, m2;  /* copies: digit stores may alias anything global */
+    u32 p0, inv01, inv02, inv12, r01; u64 q01;
+    divisor base;
+} crt;
+
+static inline u64 crt_divmod(const crt *c, long i, u32 *rem){
+    const modulus *m1 = &c->m1, *m2 = &c->m2;
+    u32 r0 = c->res[i], t1 = 0, t2 = 0;
+    if(c->primes > 1){
+        t1 = barrett_mul(m1, sub_fast(m1, c->res[c->stride + i], r0), c->inv01);
+        if(c->primes > 2){
+            t2 = barrett_mul(m2, sub_fast(m2, c->res[2 * c->stride + i], r0), c->inv02);
+            t2 = barrett_mul(m2, sub_fast(m2, t2, t1), c->inv12);
+        }
+    }
+    u64 f = r0 + (u64)c->p0 * t1 + (u64)c->r01 * t2, q = div_q(&c->base, f);
+    *rem = (u32)(f - q * c->base.d);
+    return q + c->q01 * t2;
+}
+
+/* residues res[r * cn + i] of cn coefficients -> digits[] through base 10^k,
+ * blockwise like normalize_digits(); returns the digit count */
+static int normalize_packed(const u32 *res, int cn, int primes, int k){
+    const modulus *m0 = &moduli[1], *m1 = &moduli[2], *m2 = &moduli[3];
+    const u32 base = pow10_u32[k];
+    const u64 p01 = (u64)m0->p * m1->p;
+    crt c = { res, cn, primes, *m1, *m2, m0->p,
+              pow_fast(m1, m0->p, m1->p - 2), pow_fast(m2, m0->p, m2->p - 2), pow_fast(m2, m1->p, m2->p - 2),
+              (u32)(p01 % base), p01 / base, div_init(base) };
+    unsigned char *dig = digits;
+    int blocks = (cn + NORM_BLOCK - 1) / NORM_BLOCK;
+    u64 *out = arena_alloc(&work_arena, sizeof(u64) * blocks);
+    int t = cn >= PAR_MIN ? threads : 1;
+    #pragma omp parallel for num_threads(t) schedule(static)
+    for(int b = 0; b < blocks; b++){
+        int i1 = (b + 1) * NORM_BLOCK < cn ? (b + 1) * NORM_BLOCK : cn;
+        /* x / 10^k <= (10^k - 1) * min(c1, c2) < 2^56: the carry fits 64
+         * bits, and only one reciprocal multiply sits on its chain */
+        u64 carry = 0;
+        for(int i = b * NORM_BLOCK; i < i1; i++){
+            u32 lo;
+            u64 hi = crt_divmod(&c, i, &lo);
+            u64 v = lo + carry, q = div_q(&c.base, v);
+            u32 group = (u32)(v - q * base);
+            carry = hi + q;
+            unsigned char *d = dig + (long)i * k;
+            for(int j = 0; j < k; j++, group /= 10) d[j] = (unsigned char)(group % 10);
+        }
+        out[b] = carry;
+    }
+    return carry_fixup(out, blocks, (long)NORM_BLOCK * k, (long)cn * k);
+}
+
+static int big_multiply_packed(char *s1, char *s2, int len1, int len2, int k){
+    const u32 base = pow10_u32[k];
+    int c1 = (len1 + k - 1) / k, c2 = (len2 + k - 1) / k, cn = c1 + c2 - 1;
+    int n = 1;
+    while(n < cn) n <<= 1;
+
+    /* primes needed for the largest possible coefficient */
+    long double bound = (long double)(base - 1) * (base - 1) * (c1 < c2 ? c1 : c2);
+    long double prod = 1;
+    int primes = 0;
+    while(primes < PACK_PRIMES && prod <= bound) prod *= moduli[1 + primes++].p;
+
+    /* residues only for the cn coefficients the product has */
+    u32 *src = arena_alloc(&work_arena, sizeof(u32) * ((size_t)c1 + c2));
+    u32 *a = arena_alloc(&work_arena, sizeof(u32) * (size_t)n), *b = arena_alloc(&work_arena, sizeof(u32) * (size_t)n);
+    u32 *res = arena_alloc(&work_arena, sizeof(u32) * (size_t)cn * primes);
+    digits = arena_alloc(&work_arena, (size_t)(c1 + c2) * k);
+    load_packed(src, s1, len1, k);
+    load_packed(src + c1, s2, len2, k);
+
+    for(int r = 0; r < primes; r++){
+        const modulus *m = &moduli[1 + r];
+        for(int i = 0; i < n; i++){
+            a[i] = i < c1 ? src[i] % m->p : 0;
+            b[i] = i < c2 ? src[c1 + i] % m->p : 0;
+        }
+        convolve_fast(m, a, b, n);
+        memcpy(res + (size_t)r * cn, a, sizeof(u32) * cn);
+    }
+
+    return normalize_packed(res, cn, primes, k);
+}
+
+/* coefficients a[0..cn) in base 10^k, each below 2^61, into digits[];
+ * returns the digit count */
+static int normalize_wide(const u64 *a, int cn, int k){
+    const u32 base = pow10_u32[k];
+    const divisor div = div_init(base);
+    unsigned char *dig = digits;
+    int blocks = (cn + NORM_BLOCK - 1) / NORM_BLOCK;
+    u64 *out = arena_alloc(&work_arena, sizeof(u64) * blocks);
+    int t = cn >= PAR_MIN ? threads : 1;
+    #pragma omp parallel for num_threads(t) schedule(static)
+    for(int b = 0; b < blocks; b++){
+        int i1 = (b + 1) * NORM_BLOCK < cn ? (b + 1) * NORM_BLOCK : cn;
+        u64 carry = 0;
+        for(int i = b * NORM_BLOCK; i < i1; i++){
+            u64 v = a[i] + carry, q = div_q(&div, v);
+            u32 group = (u32)(v - q * base);
+            carry = q;
+            unsigned char *d = dig + (long)i * k;
+            for(int j = 0; j < k; j++, group /= 10) d[j] = (unsigned char)(group % 10);
+        }
+        out[b] = carry;
+    }
+    return carry_fixup(out, blocks, (long)NORM_BLOCK * k, (long)cn * k);
+}
+
+/* ===== Classic multiplication =====
+ * Below the NTT cutoff (length of the shorter operand in digits), products
+ * go through schoolbook, Karatsuba or Toom-3 on limbs of CLASSIC_K digits.
+ * Like the transforms they compute the exact convolution of the limb
+ * vectors, here in signed 64-bit coefficients, and share the normalization
+ * pass. Every recursive step picks its algorithm from the shorter length;
+ * operands that differ by 2x or more are cut into balanced chunks of the
+ * shorter length. The default cutoffs come from --tune.
+ *
+ * Magnitudes: Toom-3 evaluation grows coefficients up to 7x per level and
+ * Karatsuba 2x, so the classic path is capped at CLASSIC_MAX digits and the
+ * cutoffs have floors; with those, no intermediate value passes 2^62. */
+#define CLASSIC_K 4
+#define CLASSIC_MAX 16384
+typedef int64_t i64;
+enum { MUL_SCHOOLBOOK, MUL_KARATSUBA, MUL_TOOM3, MUL_NTT, MULS };
+static const char *mul_names[] = { "schoolbook", "karatsuba", "toom3", "ntt" };
+/* shorter operand length in digits from which each algorithm takes over */
+static int mul_cutoff[MULS] = { 0, 128, 500, 16384 };
+static const int mul_floor[MULS] = { 0, 64, 256, 0 };
+
+static int mul_pick(long digits){
+    int alg = MUL_SCHOOLBOOK;
+    for(int a = MUL_KARATSUBA; a <= MUL_NTT; a++){
+        int cut = mul_cutoff[a] > mul_floor[a] ? mul_cutoff[a] : mul_floor[a];
+        if(a == MUL_NTT && cut > CLASSIC_MAX) cut = CLASSIC_MAX;
+        if(digits >= cut) alg = a;
+    }
+    return alg;
+}
+
+static void mul_classic(const i64 *a, int na, const i64 *b, int nb, i64 *c);
+
+/* c[0..na+nb-1) = a * b for any lengths */
+static void mul_schoolbook(const i64 *a, int na, const i64 *b, int nb, i64 *c){
+    memset(c, 0, sizeof(i64) * (size_t)(na + nb - 1));
+    for(int i = 0; i < na; i++){
+        i64 x = a[i], *ci = c + i;
+        for(int j = 0; j < nb; j++) ci[j] += x * b[j];
+    }
+}
+
+/* na >= nb > m = ceil(na / 2): a * b = z0 + (z1 - z0 - z2) x^m + z2 x^2m */
+static void mul_karatsuba(const i64 *a, int na, const i64 *b, int nb, i64 *c){
+    int m = (na + 1) / 2, ha = na - m, hb = nb - m, len = 2 * m - 1;
+    arena_pos mark = arena_mark(&work_arena);
+    i64 *sa = arena_alloc(&work_arena, sizeof(i64) * m), *sb = arena_alloc(&work_arena, sizeof(i64) * m);
+    i64 *z1 = arena_alloc(&work_arena, sizeof(i64) * len);
+    for(int i = 0; i < m; i++){
+        sa[i] = a[i] + (i < ha ? a[m + i] : 0);
+        sb[i] = b[i] + (i < hb ? b[m + i] : 0);
+    }
+    mul_classic(a, m, b, m, c);
+    c[len] = 0;
+    mul_classic(a + m, ha, b + m, hb, c + 2 * m);
+    mul_classic(sa, m, sb, m, z1);
+    for(int i = 0; i < len; i++) z1[i] -= c[i];
+    for(int i = 0; i < ha + hb - 1; i++) z1[i] -= c[2 * m + i];
+    for(int i = 0; i < len && m + i < na + nb - 1; i++) c[m + i] += z1[i];
+    arena_release(&work_arena, mark);
+}
+
+/* na >= nb > 2m, m = ceil(na / 3): evaluation at 0, 1, -1, -2 and infinity,
+ * interpolation in Bodrato's sequence (exact divisions by 2 and 3) */
+static void mul_toom3(const i64 *a, int na, const i64 *b, int nb, i64 *c){
+    int m = (na + 2) / 3, ha = na - 2 * m, hb = nb - 2 * m, len = 2 * m - 1, cn = na + nb - 1;
+    arena_pos mark = arena_mark(&work_arena);
+    i64 *ev = arena_alloc(&work_arena, sizeof(i64) * 6 * m);
+    i64 *r = arena_alloc(&work_arena, sizeof(i64) * 3 * len);
+    i64 *a1 = ev, *am1 = ev + m, *am2 = ev + 2 * m, *b1 = ev + 3 * m, *bm1 = ev + 4 * m, *bm2 = ev + 5 * m;
+    i64 *r1 = r, *rm1 = r + len, *rm2 = r + 2 * len;
+    for(int i = 0; i < m; i++){
+        i64 x0 = a[i], x1 = a[m + i], x2 = i < ha ? a[2 * m + i] : 0;
+        i64 y0 = b[i], y1 = b[m + i], y2 = i < hb ? b[2 * m + i] : 0;
+        a1[i] = x0 + x2 + x1; am1[i] = x0 + x2 - x1; am2[i] = (am1[i] + x2) * 2 - x0;
+        b1[i] = y0 + y2 + y1; bm1[i] = y0 + y2 - y1; bm2[i] = (bm1[i] + y2) * 2 - y0;
+    }
+    mul_classic(a, m, b, m, c);                         /* r(0) */
+    mul_classic(a + 2 * m, ha, b + 2 * m, hb, c + 4 * m); /* r(inf) */
+    mul_classic(a1, m, b1, m, r1);
+    mul_classic(am1, m, bm1, m, rm1);
+    mul_classic(am2, m, bm2, m, rm2);
+    for(int i = 0; i < len; i++){
+        i64 v0 = c[i], vinf = i < ha + hb - 1 ? c[4 * m + i] : 0;
+        i64 t3 = (rm2[i] - r1[i]) / 3, t1 = (r1[i] - rm1[i]) / 2, t2 = rm1[i] - v0;
+        t3 = (t2 - t3) / 2 + 2 * vinf;
+        t2 = t2 + t1 - vinf;
+        r1[i] = t1 - t3; rm1[i] = t2; rm2[i] = t3;
+    }
+    memset(c + len, 0, sizeof(i64) * (size_t)(4 * m - len));
+    for(int k = 1; k <= 3; k++){
+        const i64 *t = r + (size_t)(k - 1) * len;
+        for(int i = 0; i < len && k * m + i < cn; i++) c[k * m + i] += t[i];
+    }
+    arena_release(&work_arena, mark);
+}
+
+/* na >= 2 nb: pieces of a as long as b, each a balanced product */
+static void mul_chunked(const i64 *a, int na, const i64 *b, int nb, i64 *c){
+    arena_pos mark = arena_mark(&work_arena);
+    i64 *t = arena_alloc(&work_arena, sizeof(i64) * (size_t)(2 * nb - 1));
+    memset(c, 0, sizeof(i64) * (size_t)(na + nb - 1));
+    for(int o = 0; o < na; o += nb){
+        int l = na - o < nb ? na - o : nb;
+        mul_classic(a + o, l, b, nb, t);
+        for(int i = 0; i < l + nb - 1; i++) c[o + i] += t[i];
+    }
+    arena_release(&work_arena, mark);
+}
+
+/* one step of alg (shapes as each function requires), recursing through mul_classic() */
+static void mul_step(int alg, const i64 *a, int na, const i64 *b, int nb, i64 *c){
+    if(alg == MUL_TOOM3) mul_toom3(a, na, b, nb, c);
+    else if(alg == MUL_KARATSUBA) mul_karatsuba(a, na, b, nb, c);
+    else mul_schoolbook(a, na, b, nb, c);
+}
+
+static void mul_classic(const i64 *a, int na, const i64 *b, int nb, i64 *c){
+    if(na < nb){ const i64 *t = a; a = b; b = t; int n = na; na = nb; nb = n; }
+    int alg = mul_pick((long)nb * CLASSIC_K);
+    if(alg == MUL_NTT) alg = MUL_TOOM3;
+    if(alg != MUL_SCHOOLBOOK && nb <= (na + 1) / 2){ mul_chunked(a, na, b, nb, c); return; }
+    if(alg == MUL_TOOM3 && nb <= 2 * ((na + 2) / 3)) alg = MUL_KARATSUBA;
+    mul_step(alg, a, na, b, nb, c);
+}
+
+/* decimal strings -> limbs -> mul_classic() -> digits[]; returns the digit count */
+static int big_multiply_classic(char *s1, char *s2, int len1, int len2){
+    const int k = CLASSIC_K;
+    int n1 = (len1 + k - 1) / k, n2 = (len2 + k - 1) / k, cn = n1 + n2 - 1;
+    u32 *src = arena_alloc(&work_arena, sizeof(u32) * ((size_t)n1 + n2));
+    i64 *a = arena_alloc(&work_arena, sizeof(i64) * ((size_t)n1 + n2)), *b = a + n1;
+    i64 *c = arena_alloc(&work_arena, sizeof(i64) * (size_t)cn);
+    digits = arena_alloc(&work_arena, (size_t)(n1 + n2) * k);
+    load_packed(src, s1, len1, k);
+    load_packed(src + n1, s2, len2, k);
+    for(int i = 0; i < n1 + n2; i++) a[i] = src[i];
+    mul_classic(a, n1, b, n2, c);
+    return normalize_wide((const u64 *)c, cn, k);
+}
+
 /* divide x by 10: outputs quotient in *q and remainder in *r using shift-subtract */
 void divmod10(int x,int *q,int *r){
     int tmp=10; int mult=1; /* find highest double */
@@ -123,13 +1437,40 @@ void divmod10(int x,int *q,int *r){
     *q = qq; *r = x;
 }
 
-void big_multiply(char *s1,char *s2,int len1,int len2){
+/* the packed path: k from --pack, or 9 for products too long for one
+ * transform modulo MOD */
+static int big_multiply_large(char *s1, char *s2, int len1, int len2){
+    int k = pack > 1 ? pack : 9, saved = arith;
+    long cn = (len1 + k - 1L) / k + (len2 + k - 1L) / k - 1;
+    int max_logn = MAX_LOGN;
+    for(int r = 1; r <= PACK_PRIMES; r++) if(moduli[r].max_logn < max_logn) max_logn = moduli[r].max_logn;
+    if(cn > 1L << max_logn){ fprintf(stderr, "operands too long: %ld coefficients of %d digits, at most %ld\n", cn, k, 1L << max_logn); exit(1); }
+    if(arith == ARITH_BITWISE) arith = ARITH_MONTGOMERY;
+    int res_len = big_multiply_packed(s1, s2, len1, len2, k);
+    arith = saved;
+    return res_len;
+}
+
+/* product of s1 and s2 into digits[] (least significant first); returns its length */
+int big_multiply(char *s1,char *s2,int len1,int len2){
+    arena_reset(&work_arena);
+    if(arith != ARITH_BITWISE && mul_pick(len1 < len2 ? len1 : len2) != MUL_NTT) return big_multiply_classic(s1,s2,len1,len2);
+    if(pack > 1 || len1 + (long)len2 - 1 > 1L << moduli[0].max_logn) return big_multiply_large(s1,s2,len1,len2);
     int n1=len1; int n2=len2;
     int n=1; int need=add(n1,n2); need=sub(need,1);
     grow_loop:
     if(!less_than(n, need)) goto grow_end; /* while n < need */
     n = n << 1; goto grow_loop;
     grow_end: ;
+    /* the carry pass reads n1 + n2 entries: one past n when n1 + n2 - 1 = n */
+    a_ntt = arena_alloc(&work_arena, sizeof(int) * ((size_t)n + 1)); a_ntt[n] = 0;
+    b_ntt = arena_alloc(&work_arena, sizeof(int) * (size_t)n);
+    digits = arena_alloc(&work_arena, (size_t)n1 + n2);
+    if(arith != ARITH_BITWISE){
+        load_digits((u32 *)a_ntt, s1, n1, n); load_digits((u32 *)b_ntt, s2, n2, n);
+        convolve_fast(&moduli[0], (u32 *)a_ntt, (u32 *)b_ntt, n);
+        return normalize_digits((u32 *)a_ntt, need);
+    }
     /* Clear arrays */
     int i=0; cl_loop:
     if(!less_than(i,n)) goto cl_end;
@@ -167,24 +1508,445 @@ void big_multiply(char *s1,char *s2,int len1,int len2){
     if(!less_than(1,res_len)) goto trim_end;
     if(digits[sub(res_len,1)]) goto trim_end;
     res_len=sub(res_len,1); goto trim_loop; trim_end: ;
+    return res_len;
+}
+
+/* --stats: high-water marks of everything allocated for the product */
+static void report_memory(void){
+    const double mb = 1048576.0;
+    fprintf(stderr, "memory: work %.1f MB peak (%.1f MB reserved), NTT plans %.1f MB, input %.1f MB",
+            work_arena.peak / mb, work_arena.reserved / mb, plan_arena.reserved / mb, input_bytes / mb);
+#ifndef _WIN32
+    struct rusage ru;
+    if(!getrusage(RUSAGE_SELF, &ru)) fprintf(stderr, ", max RSS %.1f MB", ru.ru_maxrss / 1024.0);
+#endif
+    fprintf(stderr, "\n");
+}
+
+/* ===== Benchmark ===== */
+static double now_sec(void){
+#ifdef _WIN32
+    LARGE_INTEGER f, c; QueryPerformanceFrequency(&f); QueryPerformanceCounter(&c);
+    return (double)c.QuadPart / (double)f.QuadPart;
+#else
+    struct timespec ts; clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+#endif
+}
+
+static u64 rng_state = 88172645463325252ULL;
+static u64 rng_next(void){
+    rng_state ^= rng_state << 13; rng_state ^= rng_state >> 7; rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+static void random_number(char *s, int len){
+    for(int i = 0; i < len; i++) s[i] = (char)('0' + rng_next() % 10);
+    s[0] = (char)('1' + rng_next() % 9);
+    s[len] = 0;
+}
+
+/* raw modular multiplications per second, one dependent chain per engine */
+static void bench_mulmod(void){
+    const int count = 2000000;
+    const modulus *m = &moduli[0];
+    u32 x = 12345, y = 678910, y_m = to_mont(m, y);
+    printf("%-12s %12s\n", "engine", "Mmul/s");
+    for(int e = ARITH_BITWISE; e <= ARITH_BARRETT; e++){
+        int iters = e == ARITH_BITWISE ? count / 100 : count;
+        u32 acc = x;
+        double t = now_sec();
+        for(int i = 0; i < iters; i++){
+            if(e == ARITH_BITWISE) acc = (u32)mul_mod((int)acc, (int)y);
+            else if(e == ARITH_MONTGOMERY) acc = mont_mul(m, acc, y_m);
+            else acc = barrett_mul(m, acc, y);
+        }
+        t = now_sec() - t;
+        if(acc != pow_fast(m, y, (u32)iters) * (u64)x % MOD) printf("mismatch in %s\n", arith_names[e]);
+        printf("%-12s %12.1f\n", arith_names[e], iters / t / 1e6);
+    }
+}
+
+/* forward transforms of random data with every supported ISA: results must
+ * match the scalar Montgomery kernel bit for bit */
+static int bench_simd(void){
+    int saved_arith = arith, saved_isa = isa, status = 0;
+    arith = ARITH_MONTGOMERY;
+    printf("\n%-8s %-8s %14s %10s\n", "size", "isa", "Mbutterfly/s", "check");
+    for(int logn = 12; logn <= 20; logn += 4){
+        int n = 1 << logn;
+        u32 *src = malloc(sizeof(u32) * n), *ref = malloc(sizeof(u32) * n), *a = malloc(sizeof(u32) * n);
+        u32 *tmp = malloc(sizeof(u32) * n);
+        if(!src || !ref || !a || !tmp){ free(src); free(ref); free(a); free(tmp); return 1; }
+        for(int i = 0; i < n; i++) src[i] = (u32)(rng_next() % MOD);
+        ntt_prepare(&moduli[0], n);
+        for(int level = ISA_SCALAR; level < ISAS; level++){
+            if(!isa_supported(level)) continue;
+            isa = level;
+            int reps = (1 << 22) >> logn;
+            double best = 1e30;
+            for(int r = 0; r < reps; r++){
+                memcpy(a, src, sizeof(u32) * n);
+                double t = now_sec();
+                ntt_fast(&moduli[0], a, tmp, n, 0, 1);
+                t = now_sec() - t;
+                if(t < best) best = t;
+            }
+            if(level == ISA_SCALAR) memcpy(ref, a, sizeof(u32) * n);
+            int ok = !memcmp(ref, a, sizeof(u32) * n);
+            if(!ok) status = 1;
+            printf("2^%-6d %-8s %14.1f %10s\n", logn, isa_names[level],
+                   (double)n / 2 * logn / best / 1e6, ok ? "ok" : "MISMATCH");
+        }
+        free(src); free(ref); free(a); free(tmp);
+    }
+    arith = saved_arith; isa = saved_isa;
+    return status;
+}
+
+/* digit scanning, parsing and formatting throughput of the result digits
+ * (already in digits[]) with each ISA the I/O layer has */
+static int bench_io(const char *s, int len, int res_len){
+    int saved_isa = isa, status = 0;
+    char *out = malloc((size_t)res_len), *ref = malloc((size_t)res_len);
+    u32 *c = malloc(sizeof(u32) * ((size_t)len / 9 + 1));
+    if(!out || !ref || !c){ free(out); free(ref); free(c); return 1; }
+    load_packed(c, s, len, 9); format_digits(out, res_len); /* touch the buffers */
+    printf("\n%-8s %12s %12s %12s %8s\n", "isa", "scan MB/s", "parse MB/s", "format MB/s", "check");
+    for(int level = ISA_SCALAR; level <= ISA_AVX2; level++){
+        if(!isa_supported(level)) continue;
+        isa = level;
+        double t0 = now_sec();
+        size_t run = digit_run(s, (size_t)len);
+        double t1 = now_sec();
+        load_packed(c, s, len, 9);
+        double t2 = now_sec();
+        format_digits(out, res_len);
+        double t3 = now_sec();
+        if(level == ISA_SCALAR) memcpy(ref, out, (size_t)res_len);
+        int ok = run == (size_t)len && !memcmp(ref, out, (size_t)res_len);
+        if(!ok) status = 1;
+        printf("%-8s %12.0f %12.0f %12.0f %8s\n", isa_names[level], len / (t1 - t0) / 1e6,
+               len / (t2 - t1) / 1e6, res_len / (t3 - t2) / 1e6, ok ? "ok" : "MISMATCH");
+    }
+    isa = saved_isa;
+    free(out); free(ref); free(c);
+    return status;
+}
+
+static int bench(int len, int reps){
+    if(len < 1 || reps < 1){ printf("digits and reps must be positive\n"); return 1; }
+    num1 = malloc((size_t)len + 1); num2 = malloc((size_t)len + 1);
+    unsigned char *reference = malloc((size_t)2 * len);
+    if(!num1 || !num2 || !reference){ printf("out of memory for %d digits\n", len); return 1; }
+    random_number(num1, len); random_number(num2, len);
+    bench_mulmod();
+    int status = bench_simd();
+    printf("\n%d x %d digits, best of %d\n", len, len, reps);
+    printf("%-12s %12s %12s %10s %10s\n", "engine", "first ms", "best ms", "speedup", "peak MB");
+    int ref_len = 0; double ref_time = 0;
+    /* engines, then the packed three-prime path (Montgomery) at k = 4 and 9 */
+    for(int e = ARITH_BITWISE; e <= ARITH_BARRETT + 2; e++){
+        /* bitwise needs ~3 minutes at 1M digits; skip it for large sizes */
+        if(e == ARITH_BITWISE && len > 100000){ printf("%-12s %12s %12s\n", arith_names[e], "skipped", "skipped"); continue; }
+        char name[16];
+        if(e <= ARITH_BARRETT){ arith = e; pack = 1; snprintf(name, sizeof(name), "%s", arith_names[e]); }
+        else { arith = ARITH_MONTGOMERY; pack = e == ARITH_BARRETT + 1 ? 4 : 9; snprintf(name, sizeof(name), "packed k=%d", pack); }
+        /* the first run also builds the NTT plan, later runs reuse it */
+        double best = 1e30, first = 0; int res_len = 0;
+        work_arena.peak = 0;
+        for(int r = 0; r < reps; r++){
+            double t = now_sec();
+            res_len = big_multiply(num1, num2, len, len);
+            t = now_sec() - t;
+            if(!r) first = t;
+            if(t < best) best = t;
+        }
+        if(!ref_len){
+            ref_len = res_len; ref_time = best;
+            memcpy(reference, digits, sizeof(*digits) * res_len);
+        } else if(res_len != ref_len || memcmp(reference, digits, sizeof(*digits) * res_len)){
+            printf("%-12s result differs from the first engine\n", name);
+            status = 1;
+        }
+        printf("%-12s %12.1f %12.1f %9.1fx %10.1f\n", name, first * 1e3, best * 1e3, ref_time / best,
+               work_arena.peak / 1048576.0);
+    }
+    printf("(speedup relative to the first engine run; results checked against it;\n"
+           " peak MB: working buffers of one multiplication, NTT plans %.1f MB on top)\n", plan_arena.reserved / 1048576.0);
+    if(ref_len) status |= bench_io(num1, len, ref_len);
+    free(num1); free(num2); free(reference);
+    return status;
+}
+
+/* best of repeated runs, at least 3 and ~20 ms in total */
+static double time_step(int alg, const i64 *a, const i64 *b, int n, i64 *c){
+    double best = 1e30, total = 0;
+    for(int r = 0; r < 3 || total < 0.02; r++){
+        double t = now_sec();
+        mul_step(alg, a, n, b, n, c);
+        t = now_sec() - t;
+        total += t;
+        if(t < best) best = t;
+    }
+    return best;
+}
+static double time_multiply(int len){
+    double best = 1e30, total = 0;
+    for(int r = 0; r < 3 || total < 0.02; r++){
+        double t = now_sec();
+        big_multiply(num1, num2, len, len);
+        t = now_sec() - t;
+        total += t;
+        if(t < best) best = t;
+    }
+    return best;
+}
+
+/* Crossover search for the dispatcher: one step of each classic algorithm
+ * on top of the cutoffs found so far against one step of the algorithm
+ * below it, then the NTT as configured (engine, --pack) against the
+ * classic path. A cutoff is the first balanced size that wins twice in a
+ * row. */
+static int tune(void){
+    const int max_limbs = CLASSIC_MAX / CLASSIC_K;
+    int saved_arith = arith;
+    if(arith == ARITH_BITWISE) arith = ARITH_MONTGOMERY;
+    i64 *a = malloc(sizeof(i64) * max_limbs), *b = malloc(sizeof(i64) * max_limbs);
+    i64 *c = malloc(sizeof(i64) * 2 * max_limbs);
+    num1 = malloc(CLASSIC_MAX + 1); num2 = malloc(CLASSIC_MAX + 1);
+    if(!a || !b || !c || !num1 || !num2){ printf("out of memory\n"); return 1; }
+    for(int i = 0; i < max_limbs; i++){ a[i] = (i64)(rng_next() % 10000); b[i] = (i64)(rng_next() % 10000); }
+    printf("Cutoff search (%s, %s, %d-digit limbs, NTT %s)\n", arith_names[arith], isa_names[isa], CLASSIC_K,
+           pack > 1 ? "packed" : "one prime");
+    for(int alg = MUL_KARATSUBA; alg <= MUL_NTT; alg++){
+        printf("\n%-8s %14s %14s\n", "digits", mul_names[alg - 1], mul_names[alg]);
+        int cut = CLASSIC_MAX, first = 0, wins = 0;
+        for(int d = mul_floor[alg] > 64 ? mul_floor[alg] : 64; d < CLASSIC_MAX && wins < 2; d = (d * 5 / 4 + 3) & ~3){
+            double lower, upper;
+            if(alg == MUL_NTT){
+                random_number(num1, d); random_number(num2, d);
+                mul_cutoff[MUL_NTT] = INT_MAX; lower = time_multiply(d);
+                mul_cutoff[MUL_NTT] = 0; upper = time_multiply(d);
+            } else {
+                mul_cutoff[alg] = INT_MAX;
+                lower = time_step(alg - 1, a, b, d / CLASSIC_K, c);
+                upper = time_step(alg, a, b, d / CLASSIC_K, c);
+            }
+            printf("%-8d %12.1f us %12.1f us\n", d, lower * 1e6, upper * 1e6);
+            if(upper < lower){ if(!wins++) first = d; } else wins = 0;
+        }
+        if(wins == 2) cut = first;
+        mul_cutoff[alg] = cut;
+        printf("%s from %d digits\n", mul_names[alg], cut);
+    }
+    printf("\n--cutoffs %d,%d,%d\n", mul_cutoff[MUL_KARATSUBA], mul_cutoff[MUL_TOOM3], mul_cutoff[MUL_NTT]);
+    free(a); free(b); free(c); free(num1); free(num2);
+    arith = saved_arith;
+    return 0;
+}
 
-    i=sub(res_len,1);
-    out_loop:
-    if(less_than(i,0)) goto out_end;
-    printf("%d", digits[i]);
-    i=sub(i,1); goto out_loop; out_end: ;
+static int max_threads(void){
+#ifdef _OPENMP
+    return omp_get_num_procs();
+#else
+    return 1;
+#endif
 }
 
-int main(){
-    if(scanf("%s %s", num1, num2)!=2){ return 0; }
-    int len1=get_length(num1); int len2=get_length(num2);
+/* Thread scaling of the fast engine: full multiplies of 1M, 10M and 100M
+ * digits (the larger two through the packed path), then bare convolutions of
+ * digit-valued data up to the largest transform MOD allows */
+static void bench_scaling(void){
+    static const int sizes[] = { 1000000, 10000000, 100000000 };
+    const int multiplies = (int)(sizeof(sizes) / sizeof(sizes[0]));
+    int top = threads > 1 ? threads : max_threads(), saved = threads;
+    if(arith == ARITH_BITWISE) arith = ARITH_MONTGOMERY;
+    printf("Thread scaling (%s, %s, %d processors)\n", arith_names[arith], isa_names[isa], max_threads());
+    printf("%-22s %8s %10s %8s %10s\n", "work", "threads", "ms", "speedup", "peak MB");
+    num1 = malloc((size_t)sizes[multiplies - 1] + 1); num2 = malloc((size_t)sizes[multiplies - 1] + 1);
+    if(!num1 || !num2){ printf("out of memory for the operands\n"); return; }
+    for(int job = 0; job < multiplies + moduli[0].max_logn - 21; job++){
+        int len = job < multiplies ? sizes[job] : 0, logn = 22 + job - multiplies, n = len ? 0 : 1 << logn;
+        u32 *a = NULL, *b = NULL;
+        if(len){ random_number(num1, len); random_number(num2, len); }
+        else {
+            a = malloc(sizeof(u32) * n); b = malloc(sizeof(u32) * n);
+            if(!a || !b){ free(a); free(b); printf("out of memory at 2^%d\n", logn); break; }
+        }
+        double base = 0;
+        for(int t = 1; ; t = t * 2 > top && t < top ? top : t * 2){
+            threads = t;
+            double best = 1e30;
+            work_arena.peak = 0;
+            /* the 10M and 100M multiplies take seconds each: one run */
+            for(int r = 0; r < (len > sizes[0] ? 1 : 3); r++){
+                double start;
+                if(len){
+                    start = now_sec();
+                    big_multiply(num1, num2, len, len);
+                } else {
+                    for(int i = 0; i < n; i++){ a[i] = i < n / 2 ? (u32)(rng_next() % 10) : 0; b[i] = a[i]; }
+                    start = now_sec();
+                    convolve_fast(&moduli[0], a, b, n);
+                }
+                double e = now_sec() - start;
+                if(e < best) best = e;
+            }
+            if(t == 1) base = best;
+            char work[32];
+            if(len) snprintf(work, sizeof(work), "multiply %dM digits", len / 1000000);
+            else snprintf(work, sizeof(work), "convolve 2^%d", logn);
+            printf("%-22s %8d %10.1f %7.2fx", work, t, best * 1e3, base / best);
+            if(len) printf(" %10.1f", work_arena.peak / 1048576.0);
+            printf("\n");
+            if(t >= top) break;
+        }
+        free(a); free(b);
+    }
+    free(num1); free(num2);
+    threads = saved;
+}
+
+/* sweeps over the whole array one forward transform of 2^logn points makes
+ * in a layout: bit reversal, stage passes and the lazy reduction, or for
+ * the six-step layout two transposes and two phases of in-cache rows */
+static int layout_sweeps(int layout, int logn, int lazy){
+    if(layout == NTT_SIXSTEP) return 4;
+    return 1 + (layout == NTT_RADIX2 ? logn : logn / 2 + (logn & 1)) + lazy;
+}
+
+/* --bandwidth: forward transforms of each size in each layout, modulo the
+ * first packed prime (it has transforms up to 2^26). GB/s is the
+ * traffic the layout's sweeps would cause if each went to memory (8 bytes
+ * per point per sweep: read and write) over the time taken; next to the copy
+ * rate of memcpy() at the same size it shows where a layout stops running
+ * from cache. A convolution in each layout has to match the radix-2 one. */
+static int bench_bandwidth(void){
+    const modulus *m = &moduli[1];
+    int saved = ntt_layout, status = 0;
+    if(arith == ARITH_BITWISE) arith = ARITH_MONTGOMERY;
+    const int lazy = ntt_pick(m).lazy;
+    printf("Transform bandwidth (%s, %s, %d threads)\n", arith_names[arith], isa_names[isa], threads);
+    printf("%-8s %10s %-8s %10s %7s %10s %10s %8s\n", "size", "MB", "layout", "ms", "sweeps", "GB/s", "copy GB/s", "check");
+    for(int logn = 10; logn <= 24; logn += 2){
+        int n = 1 << logn;
+        u32 *src = malloc(sizeof(u32) * n), *a = malloc(sizeof(u32) * n), *b = malloc(sizeof(u32) * n);
+        u32 *ref = malloc(sizeof(u32) * n), *tmp = malloc(sizeof(u32) * n);
+        if(!src || !a || !b || !ref || !tmp){
+            free(src); free(a); free(b); free(ref); free(tmp);
+            printf("out of memory at 2^%d\n", logn);
+            break;
+        }
+        for(int i = 0; i < n; i++) src[i] = i < n / 2 ? (u32)(rng_next() % 10) : 0;
+        int reps = (1 << 23) >> logn;
+        if(reps < 3) reps = 3;
+        double copy = 1e30;
+        for(int r = 0; r < reps; r++){
+            double t = now_sec();
+            memcpy(a, src, sizeof(u32) * n);
+            t = now_sec() - t;
+            if(t < copy) copy = t;
+        }
+        for(int layout = NTT_RADIX2; layout <= NTT_SIXSTEP; layout++){
+            ntt_layout = layout;
+            ntt_prepare(m, n);
+            double best = 1e30;
+            for(int r = 0; r < reps; r++){
+                memcpy(a, src, sizeof(u32) * n);
+                double t = now_sec();
+                ntt_fast(m, a, tmp, n, 0, threads);
+                t = now_sec() - t;
+                if(t < best) best = t;
+            }
+            memcpy(a, src, sizeof(u32) * n); memcpy(b, src, sizeof(u32) * n);
+            convolve_fast(m, a, b, n);
+            if(layout == NTT_RADIX2) memcpy(ref, a, sizeof(u32) * n);
+            int ok = !memcmp(ref, a, sizeof(u32) * n), sweeps = layout_sweeps(layout, logn, lazy);
+            if(!ok) status = 1;
+            printf("2^%-6d %10.2f %-8s %10.3f %7d %10.1f %10.1f %8s\n", logn, n * 4.0 / 1048576.0, layout_names[layout],
+                   best * 1e3, sweeps, 8.0 * n * sweeps / best / 1e9, 8.0 * n / copy / 1e9, ok ? "ok" : "MISMATCH");
+        }
+        free(src); free(a); free(b); free(ref); free(tmp);
+    }
+    ntt_layout = saved;
+    return status;
+}
+
+static void usage(const char *prog){
+    printf("Usage: %s [--arith bitwise|montgomery|barrett] [--isa scalar|avx2|avx512] [--threads n]\n"
+           "       [--pack 4..9] [--cutoffs karatsuba,toom3,ntt] [--ntt radix2|radix4|sixstep|auto]\n"
+           "       [--stats] < input\n"
+           "       %s --bench digits [reps] [--isa ...] [--threads n]\n"
+           "       %s --scaling [--arith montgomery|barrett] [--isa ...]\n"
+           "       %s --tune [--arith montgomery|barrett] [--isa ...]\n"
+           "       %s --bandwidth [--arith montgomery|barrett] [--isa ...] [--threads n]\n", prog, prog, prog, prog, prog);
+}
+
+int main(int argc, char **argv){
+    moduli_init();
+    int bench_len = 0, bench_reps = 3, scaling = 0, stats = 0, tuning = 0, bandwidth = 0;
+    for(isa = ISAS - 1; !isa_supported(isa); isa--) ;
+    for(int i = 1; i < argc; i++){
+        if(!strcmp(argv[i], "--arith") && i + 1 < argc){
+            int found = 0;
+            for(int e = ARITH_BITWISE; e <= ARITH_BARRETT; e++)
+                if(!strcmp(argv[i + 1], arith_names[e])){ arith = e; found = 1; }
+            if(!found){ usage(argv[0]); return 1; }
+            i++;
+        } else if(!strcmp(argv[i], "--isa") && i + 1 < argc){
+            int found = -1;
+            for(int l = ISA_SCALAR; l < ISAS; l++) if(!strcmp(argv[i + 1], isa_names[l])) found = l;
+            if(found < 0){ usage(argv[0]); return 1; }
+            if(!isa_supported(found)){ fprintf(stderr, "%s not supported by this CPU\n", argv[i + 1]); return 1; }
+            isa = found; i++;
+        } else if(!strcmp(argv[i], "--threads") && i + 1 < argc){
+            threads = atoi(argv[++i]);
+            if(threads <= 0) threads = max_threads();
+        } else if(!strcmp(argv[i], "--pack") && i + 1 < argc){
+            pack = atoi(argv[++i]);
+            if(pack < 4 || pack > 9){ usage(argv[0]); return 1; }
+        } else if(!strcmp(argv[i], "--scaling")){
+            scaling = 1;
+        } else if(!strcmp(argv[i], "--ntt") && i + 1 < argc){
+            int found = -1;
+            for(int l = NTT_RADIX2; l < NTT_LAYOUTS; l++) if(!strcmp(argv[i + 1], layout_names[l])) found = l;
+            if(found < 0){ usage(argv[0]); return 1; }
+            ntt_layout = found; i++;
+        } else if(!strcmp(argv[i], "--bandwidth")){
+            bandwidth = 1;
+        } else if(!strcmp(argv[i], "--stats")){
+            stats = 1;
+        } else if(!strcmp(argv[i], "--tune")){
+            tuning = 1;
+        } else if(!strcmp(argv[i], "--cutoffs") && i + 1 < argc){
+            int *cut = mul_cutoff;
+            if(sscanf(argv[++i], "%d,%d,%d", &cut[MUL_KARATSUBA], &cut[MUL_TOOM3], &cut[MUL_NTT]) != 3){ usage(argv[0]); return 1; }
+        } else if(!strcmp(argv[i], "--bench") && i + 1 < argc){
+            bench_len = atoi(argv[++i]);
+            if(i + 1 < argc && argv[i + 1][0] != '-') bench_reps = atoi(argv[++i]);
+        } else { usage(argv[0]); return 1; }
+    }
+    if(pack > 1 && arith == ARITH_BITWISE) arith = ARITH_MONTGOMERY;
+#ifdef _OPENMP
+    omp_set_max_active_levels(2); /* concurrent operand transforms, each with its own team */
+#endif
+    if(scaling){
+        bench_scaling();
+        return 0;
+    }
+    if(tuning) return tune();
+    if(bandwidth) return bench_bandwidth();
+    if(bench_len) return bench(bench_len, bench_reps);
+    int len1, len2;
+    if(!read_operands(&num1, &len1, &num2, &len2)){ return 0; }
     
     /* Check for zero*/
     int is_zero1 = !(sub(len1, 1)) & !(sub(num1[0], '0'));
     int is_zero2 = !(sub(len2, 1)) & !(sub(num2[0], '0'));
     
     if(is_zero1 | is_zero2){ printf("0\n"); return 0; }
-    big_multiply(num1,num2,len1,len2);
-    printf("\n");
+    print_digits(big_multiply(num1,num2,len1,len2));
+    if(stats) report_memory();
     return 0;
 }
\ No newline at end of file